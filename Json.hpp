@@ -1,20 +1,74 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <charconv>
 #include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <iterator>
+#include <limits>
 #include <map>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
 #include <optional>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 
-#ifdef CPPJSON_USE_SSE
-    #include <emmintrin.h>
+// SIMD scanning kernels are compiled for x86-64 targets and selected at runtime based on the CPU.  Defining
+// `CPPJSON_NO_SIMD` restricts the parser to the portable scalar code.  `CPPJSON_USE_SSE` is still accepted
+// but no longer has any effect.
+#if !defined(CPPJSON_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64))
+    #define CPPJSON_SIMD_X64
+#endif
+
+#ifdef CPPJSON_SIMD_X64
+    #include <immintrin.h>
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #endif
+
+    #if defined(__GNUG__)
+        #define CPPJSON_TARGET_AVX2 __attribute__((target("avx2")))
+        #define CPPJSON_TARGET_AVX512 __attribute__((target("avx512f,avx512bw")))
+    #else
+        #define CPPJSON_TARGET_AVX2
+        #define CPPJSON_TARGET_AVX512
+    #endif
+#endif
+
+// Files passed to `ParseFile()` are memory mapped on POSIX and Windows targets.  Other targets read the file
+// into memory instead.
+#if defined(__unix__) || defined(__APPLE__)
+    #define CPPJSON_MMAP_POSIX
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#elif defined(_WIN32)
+    #define CPPJSON_MMAP_WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+        #define CPPJSON_UNDEF_NOMINMAX
+    #endif
+    #include <windows.h>
+    #ifdef CPPJSON_UNDEF_NOMINMAX
+        #undef NOMINMAX
+        #undef CPPJSON_UNDEF_NOMINMAX
+    #endif
 #endif
 
 namespace json {
 
-    enum class JsonValueType {
+    enum class JsonValueType : uint8_t {
         String,
         Int,
         UInt,
@@ -27,95 +81,740 @@ namespace json {
 
     //--------------------------------------------------------------------------------------------------------
 
+    class JsonString;
+    class StringPool;
     class JsonValue;
     class JsonArray;
     class JsonObject;
     class SimpleReader;
+    class StreamingReader;
+    class NdjsonReader;
+    class SequenceReader;
     class ObjectReader;
     class ObjectWriter;
+    class JsonDocument;
+    class JsonElement;
+    class JsonLazyValue;
 
     //--------------------------------------------------------------------------------------------------------
     //--------------------------------------------------------------------------------------------------------
     //--------------------------------------------------------------------------------------------------------
 
-    class JsonArray :
-        public std::vector<JsonValue>
-    {
-        using base_type = std::vector<JsonValue>;
+    namespace detail {
 
-    public:
-        JsonArray() noexcept = default;
+        // The shared storage of a `JsonString` too long to be stored inline.  The characters follow the header.
+        struct StringBlock {
+            std::atomic<size_t> Refs;
+            size_t Size;
+            size_t Capacity;
+            std::pmr::memory_resource* Resource;
 
-        explicit JsonArray(std::initializer_list<JsonValue> values)
-          : base_type(values)
-        {}
+            char* Chars() noexcept { return reinterpret_cast<char*>(this + 1); }
 
-        template <typename Iter>
-        JsonArray(Iter first, Iter last)
-          : base_type(first, last)
-        {}
-    };
+            static StringBlock* Create(std::string_view value, std::pmr::memory_resource* resource) {
+                void* memory = resource->allocate(sizeof(StringBlock) + value.size(), alignof(StringBlock));
+                auto block = new (memory) StringBlock{ { 1 }, value.size(), value.size(), resource };
+                std::memcpy(block->Chars(), value.data(), value.size());
+                return block;
+            }
+
+            void AddRef() noexcept {
+                Refs.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            // Returns a new reference to this block for a copy of its string.  Only blocks from
+            // `std::pmr::new_delete_resource()` are shared; others are copied to the default resource.
+            StringBlock* Share() {
+                if (Resource != std::pmr::new_delete_resource()) {
+                    return Create({ Chars(), Size }, std::pmr::get_default_resource());
+                }
+                AddRef();
+                return this;
+            }
+
+            void Release() noexcept {
+                if (Refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    auto resource = Resource;
+                    auto bytes = sizeof(StringBlock) + Capacity;
+                    this->~StringBlock();
+                    resource->deallocate(this, bytes, alignof(StringBlock));
+                }
+            }
+        };
+
+    }
 
     //--------------------------------------------------------------------------------------------------------
 
-    class JsonObject :
-        public std::map<std::string, JsonValue, std::less<>>
-    {
-        using base_type = std::map<std::string, JsonValue, std::less<>>;
+    // An immutable UTF-8 string, used for object keys and string values.  Strings of up to `InlineCapacity`
+    // bytes are stored inline.  Longer strings are held in a reference counted block that copies share, so
+    // copying a `JsonString` never allocates and the same string can be handed out many times by a
+    // `StringPool`.  The reference counts are atomic, so copies may be used on different threads.
+    //
+    // Blocks are allocated from the default `std::pmr::memory_resource` unless another is given.  Only blocks
+    // from `std::pmr::new_delete_resource()` are shared by copies.  Others are copied to the default resource,
+    // in the same way as the copy of a `std::pmr` container, since their resource may be released while the
+    // copy is still in use.
+    class JsonString {
+        template <typename T>
+        using EnableIfStringLike = std::enable_if_t<
+            std::is_convertible_v<const T&, std::string_view> && !std::is_same_v<T, JsonString>
+        >;
 
     public:
-        JsonObject() = default;
+        // The same as `JsonValue`, so that converting between the two never allocates.
+        static constexpr size_t InlineCapacity = 14;
 
-        explicit JsonObject(std::initializer_list<std::pair<const std::string, JsonValue>> values)
-          : base_type(values)
+        JsonString() noexcept {
+            m_bytes[InlineCapacity] = 0;
+        }
+
+        JsonString(std::string_view value, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+            if (value.size() <= InlineCapacity) {
+                std::memcpy(m_bytes, value.data(), value.size());
+                m_bytes[InlineCapacity] = static_cast<unsigned char>(value.size());
+            } else {
+                SetBlock(detail::StringBlock::Create(value, resource));
+            }
+        }
+
+        JsonString(const char* value)
+          : JsonString(std::string_view(value))
         {}
 
-        template <typename Iter>
-        JsonObject(Iter first, Iter last)
-          : base_type(first, last)
+        JsonString(const std::string& value)
+          : JsonString(std::string_view(value))
         {}
 
         //----------------------------------------------------------------------------------------------------
 
-        inline bool Exists(const std::string_view& name) const;
-        inline bool Exists(const std::string_view& name, JsonValueType type) const;
+        JsonString(const JsonString& other) {
+            std::memcpy(m_bytes, other.m_bytes, sizeof(m_bytes));
+            if (!IsInline()) { SetBlock(other.Block()->Share()); }
+        }
+
+        JsonString(JsonString&& other) noexcept {
+            std::memcpy(m_bytes, other.m_bytes, sizeof(m_bytes));
+            other.m_bytes[InlineCapacity] = 0;
+        }
+
+        ~JsonString() noexcept {
+            if (!IsInline()) { Block()->Release(); }
+        }
+
+        JsonString& operator = (const JsonString& other) {
+            if (this != &other) {
+                JsonString copy(other);
+                Swap(copy);
+            }
+            return *this;
+        }
+
+        JsonString& operator = (JsonString&& other) noexcept {
+            if (this != &other) {
+                JsonString moved(std::move(other));
+                Swap(moved);
+            }
+            return *this;
+        }
+
+        void Swap(JsonString& other) noexcept {
+            unsigned char bytes[sizeof(m_bytes)];
+            std::memcpy(bytes, m_bytes, sizeof(m_bytes));
+            std::memcpy(m_bytes, other.m_bytes, sizeof(m_bytes));
+            std::memcpy(other.m_bytes, bytes, sizeof(m_bytes));
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        const char* Data() const noexcept {
+            if (IsInline()) { return reinterpret_cast<const char*>(m_bytes); }
+            return Block()->Chars();
+        }
+
+        size_t Size() const noexcept {
+            if (IsInline()) { return m_bytes[InlineCapacity]; }
+            return Block()->Size;
+        }
+
+        std::string_view View() const noexcept { return { Data(), Size() }; }
+
+        operator std::string_view() const noexcept { return View(); }
+
+        // Whether this string shares its storage with `other`.  Always false for strings stored inline.
+        bool SharesWith(const JsonString& other) const noexcept {
+            return !IsInline() && !other.IsInline() && Block() == other.Block();
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        friend bool operator == (const JsonString& lhs, const JsonString& rhs) noexcept {
+            return lhs.SharesWith(rhs) || lhs.View() == rhs.View();
+        }
+        friend bool operator != (const JsonString& lhs, const JsonString& rhs) noexcept {
+            return !(lhs == rhs);
+        }
+        friend bool operator < (const JsonString& lhs, const JsonString& rhs) noexcept {
+            return lhs.View() < rhs.View();
+        }
+
+        // Comparisons with anything convertible to `std::string_view`, which are also used for the
+        // heterogeneous lookup of object keys.
+        template <typename T, typename = EnableIfStringLike<T>>
+        friend bool operator == (const JsonString& lhs, const T& rhs) noexcept { return lhs.View() == std::string_view(rhs); }
+        template <typename T, typename = EnableIfStringLike<T>>
+        friend bool operator == (const T& lhs, const JsonString& rhs) noexcept { return std::string_view(lhs) == rhs.View(); }
+        template <typename T, typename = EnableIfStringLike<T>>
+        friend bool operator != (const JsonString& lhs, const T& rhs) noexcept { return lhs.View() != std::string_view(rhs); }
+        template <typename T, typename = EnableIfStringLike<T>>
+        friend bool operator != (const T& lhs, const JsonString& rhs) noexcept { return std::string_view(lhs) != rhs.View(); }
+        template <typename T, typename = EnableIfStringLike<T>>
+        friend bool operator < (const JsonString& lhs, const T& rhs) noexcept { return lhs.View() < std::string_view(rhs); }
+        template <typename T, typename = EnableIfStringLike<T>>
+        friend bool operator < (const T& lhs, const JsonString& rhs) noexcept { return std::string_view(lhs) < rhs.View(); }
+
+    private:
+        static constexpr unsigned char BlockTag = 0xFF;
+
+        // Inline strings hold their characters followed by their size in the last byte.  Otherwise the first
+        // bytes hold a pointer to the block and the last byte holds `BlockTag`.
+        alignas(detail::StringBlock*) unsigned char m_bytes[InlineCapacity + 1];
+
+        bool IsInline() const noexcept { return m_bytes[InlineCapacity] != BlockTag; }
+
+        detail::StringBlock* Block() const noexcept {
+            detail::StringBlock* block;
+            std::memcpy(&block, m_bytes, sizeof(block));
+            return block;
+        }
+
+        void SetBlock(detail::StringBlock* block) noexcept {
+            std::memcpy(m_bytes, &block, sizeof(block));
+            m_bytes[InlineCapacity] = BlockTag;
+        }
+
+        // Takes this string's reference to its block, leaving it empty.  Returns null if it's stored inline.
+        detail::StringBlock* TakeBlock() noexcept {
+            if (IsInline()) { return nullptr; }
+            auto block = Block();
+            m_bytes[InlineCapacity] = 0;
+            return block;
+        }
+
+        // Creates a string that takes over a reference to `block`.
+        static JsonString FromBlock(detail::StringBlock* block) noexcept {
+            JsonString string;
+            string.SetBlock(block);
+            return string;
+        }
+
+        // Overwrites the contents of a block from `resource` that isn't shared with any other string, if `value`
+        // fits.  Used by `ObjectReader` to reuse the strings of a previously parsed value.
+        bool TryReuse(std::string_view value, std::pmr::memory_resource* resource) noexcept {
+            if (IsInline() || value.size() <= InlineCapacity) { return false; }
+            auto block = Block();
+            if (block->Refs.load(std::memory_order_acquire) != 1 || block->Capacity < value.size()) {
+                return false;
+            }
+            if (block->Resource != resource) { return false; }
+            std::memcpy(block->Chars(), value.data(), value.size());
+            block->Size = value.size();
+            return true;
+        }
+
+        friend class JsonValue;
+        friend class ObjectReader;
     };
-    
+
+    //--------------------------------------------------------------------------------------------------------
+
+    // Interns strings so that equal strings share a single `JsonString`.  When `ParseOptions::Strings` is set,
+    // `ObjectReader` interns every object key through the pool, along with string values of up to
+    // `MaxValueSize()` bytes, so that the keys of a large array of records are only stored once.  Strings short
+    // enough to be stored inline never allocate and aren't added to the pool.
+    //
+    // A pool may be kept and reused across parses, and the strings it hands out remain valid after it is
+    // destroyed.  So that a long-lived pool can't grow without bound, it is cleared whenever it already holds
+    // `MaxSize()` strings and another must be added; the strings in use are then pooled again as they recur.
+    // A pool must not be used by more than one thread at a time; `ThreadLocal()` provides one for each thread.
+    class StringPool {
+    public:
+        static constexpr size_t DefaultMaxValueSize = 64;
+        static constexpr size_t DefaultMaxSize = 16384;
+
+        explicit StringPool(size_t max_value_size = DefaultMaxValueSize, size_t max_size = DefaultMaxSize) noexcept
+          : m_max_value_size(max_value_size),
+            m_max_size(std::max<size_t>(max_size, 1))
+        { }
+
+        StringPool(const StringPool&) = delete;
+        StringPool& operator = (const StringPool&) = delete;
+
+        // Returns the pooled copy of `value`, adding it to the pool if needed.
+        JsonString Intern(std::string_view value) {
+            if (value.size() <= JsonString::InlineCapacity) { return JsonString(value); }
+
+            auto it = m_strings.find(value);
+            if (it == m_strings.end()) {
+                if (m_strings.size() >= m_max_size) { m_strings.clear(); }
+                JsonString string(value);
+                it = m_strings.emplace(string.View(), std::move(string)).first;
+            }
+            return it->second;
+        }
+
+        // As `Intern()`, but strings longer than `MaxValueSize()` are copied rather than pooled.
+        JsonString InternValue(std::string_view value) {
+            if (value.size() > m_max_value_size) { return JsonString(value); }
+            return Intern(value);
+        }
+
+        size_t MaxValueSize() const noexcept { return m_max_value_size; }
+
+        // The number of strings in the pool, and the number it may hold before it is cleared.
+        size_t Size() const noexcept { return m_strings.size(); }
+        size_t MaxSize() const noexcept { return m_max_size; }
+
+        // Removes every string from the pool.  Strings that were handed out are unaffected.
+        void Clear() noexcept { m_strings.clear(); }
+
+        // A pool for the calling thread, which lasts until the thread exits.  It holds up to `DefaultMaxSize`
+        // strings; call `Clear()` to release them sooner.
+        static StringPool& ThreadLocal() {
+            thread_local StringPool pool;
+            return pool;
+        }
+
+    private:
+        size_t m_max_value_size;
+        size_t m_max_size;
+        // Keys are views of the characters in the block of their value.
+        std::unordered_map<std::string_view, JsonString> m_strings;
+    };
+
+    //--------------------------------------------------------------------------------------------------------
+    //--------------------------------------------------------------------------------------------------------
+    //--------------------------------------------------------------------------------------------------------
+
+    namespace detail {
+
+        // A vector that stores up to `N` elements inline, and only allocates once it grows beyond them.  Memory
+        // is allocated from a `std::pmr::memory_resource`, which is the default resource unless another is
+        // given.  As with the `std::pmr` containers, moving keeps the resource while copying uses the default.
+        template <typename T, size_t N>
+        class SmallVector {
+        public:
+            using value_type = T;
+            using size_type = size_t;
+            using difference_type = std::ptrdiff_t;
+            using reference = T&;
+            using const_reference = const T&;
+            using pointer = T*;
+            using const_pointer = const T*;
+            using iterator = T*;
+            using const_iterator = const T*;
+            using reverse_iterator = std::reverse_iterator<iterator>;
+            using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+            using allocator_type = std::pmr::polymorphic_allocator<T>;
+
+            static constexpr size_t InlineCapacity = N;
+
+            SmallVector() noexcept
+              : SmallVector(std::pmr::get_default_resource())
+            {}
+
+            explicit SmallVector(std::pmr::memory_resource* resource) noexcept
+              : m_data(InlineData()),
+                m_resource(resource)
+            {}
+
+            SmallVector(std::initializer_list<T> values)
+              : SmallVector()
+            {
+                Append(values.begin(), values.end());
+            }
+
+            template <typename Iter>
+            SmallVector(Iter first, Iter last)
+              : SmallVector()
+            {
+                Append(first, last);
+            }
+
+            SmallVector(const SmallVector& other)
+              : SmallVector()
+            {
+                Append(other.begin(), other.end());
+            }
+
+            SmallVector(SmallVector&& other) noexcept
+              : SmallVector(other.m_resource)
+            {
+                Steal(other);
+            }
+
+            ~SmallVector() {
+                clear();
+                FreeData();
+            }
+
+            SmallVector& operator = (const SmallVector& other) {
+                if (this != &other) {
+                    clear();
+                    Append(other.begin(), other.end());
+                }
+                return *this;
+            }
+
+            SmallVector& operator = (SmallVector&& other) {
+                if (this == &other) {
+                    return *this;
+                }
+
+                clear();
+                if (m_resource == other.m_resource) {
+                    FreeData();
+                    Steal(other);
+                } else {
+                    Append(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+                    other.clear();
+                }
+                return *this;
+            }
+
+            //------------------------------------------------------------------------------------------------
+
+            iterator begin() noexcept { return m_data; }
+            iterator end() noexcept { return m_data + m_size; }
+            const_iterator begin() const noexcept { return m_data; }
+            const_iterator end() const noexcept { return m_data + m_size; }
+            const_iterator cbegin() const noexcept { return m_data; }
+            const_iterator cend() const noexcept { return m_data + m_size; }
+            reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+            reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+            const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+            const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+            size_t size() const noexcept { return m_size; }
+            size_t capacity() const noexcept { return m_capacity; }
+            bool empty() const noexcept { return m_size == 0; }
+
+            T* data() noexcept { return m_data; }
+            const T* data() const noexcept { return m_data; }
+
+            T& operator [] (size_t index) noexcept { return m_data[index]; }
+            const T& operator [] (size_t index) const noexcept { return m_data[index]; }
+
+            T& at(size_t index) {
+                if (index >= m_size) { throw std::out_of_range("Index out of range"); }
+                return m_data[index];
+            }
+            const T& at(size_t index) const {
+                if (index >= m_size) { throw std::out_of_range("Index out of range"); }
+                return m_data[index];
+            }
+
+            T& front() noexcept { return m_data[0]; }
+            const T& front() const noexcept { return m_data[0]; }
+            T& back() noexcept { return m_data[m_size - 1]; }
+            const T& back() const noexcept { return m_data[m_size - 1]; }
+
+            allocator_type get_allocator() const noexcept { return allocator_type(m_resource); }
+
+            //------------------------------------------------------------------------------------------------
+
+            void reserve(size_t capacity) {
+                if (capacity > m_capacity) {
+                    Reallocate(capacity);
+                }
+            }
+
+            void shrink_to_fit() {
+                if (!IsInline() && m_size < m_capacity) {
+                    Reallocate(m_size);
+                }
+            }
+
+            void clear() noexcept {
+                std::destroy(begin(), end());
+                m_size = 0;
+            }
+
+            template <typename... Args>
+            T& emplace_back(Args&&... args) {
+                if (m_size < m_capacity) {
+                    new (m_data + m_size) T(std::forward<Args>(args)...);
+                    return m_data[m_size++];
+                }
+
+                // The new element is constructed before the others are moved, as `args` may refer to them.
+                size_t capacity = std::max<size_t>(m_capacity * 2, 1);
+                T* data = Allocate(capacity);
+                try {
+                    new (data + m_size) T(std::forward<Args>(args)...);
+                } catch (...) {
+                    m_resource->deallocate(data, capacity * sizeof(T), alignof(T));
+                    throw;
+                }
+                MoveTo(data, capacity);
+                return m_data[m_size++];
+            }
+
+            void push_back(const T& value) { emplace_back(value); }
+            void push_back(T&& value) { emplace_back(std::move(value)); }
+
+            void pop_back() noexcept {
+                m_data[--m_size].~T();
+            }
+
+            void resize(size_t size) {
+                if (size < m_size) {
+                    erase(begin() + size, end());
+                    return;
+                }
+                reserve(size);
+                while (m_size < size) {
+                    emplace_back();
+                }
+            }
+
+            template <typename... Args>
+            iterator emplace(const_iterator position, Args&&... args) {
+                size_t index = static_cast<size_t>(position - begin());
+                emplace_back(std::forward<Args>(args)...);
+                std::rotate(begin() + index, end() - 1, end());
+                return begin() + index;
+            }
+
+            iterator insert(const_iterator position, const T& value) { return emplace(position, value); }
+            iterator insert(const_iterator position, T&& value) { return emplace(position, std::move(value)); }
+
+            iterator erase(const_iterator position) {
+                return erase(position, position + 1);
+            }
+
+            iterator erase(const_iterator first, const_iterator last) {
+                iterator write = begin() + (first - begin());
+                if (first != last) {
+                    iterator new_end = std::move(begin() + (last - begin()), end(), write);
+                    std::destroy(new_end, end());
+                    m_size = static_cast<size_t>(new_end - begin());
+                }
+                return write;
+            }
+
+            //------------------------------------------------------------------------------------------------
+
+            friend bool operator == (const SmallVector& lhs, const SmallVector& rhs) {
+                return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+            }
+            friend bool operator != (const SmallVector& lhs, const SmallVector& rhs) {
+                return !(lhs == rhs);
+            }
+
+        private:
+            T* m_data;
+            size_t m_size = 0;
+            size_t m_capacity = N;
+            std::pmr::memory_resource* m_resource;
+            alignas(T) unsigned char m_inline[N * sizeof(T)];
+
+            T* InlineData() noexcept { return reinterpret_cast<T*>(m_inline); }
+            bool IsInline() const noexcept { return m_data == reinterpret_cast<const T*>(m_inline); }
+
+            T* Allocate(size_t capacity) {
+                return static_cast<T*>(m_resource->allocate(capacity * sizeof(T), alignof(T)));
+            }
+
+            void FreeData() noexcept {
+                if (!IsInline()) {
+                    m_resource->deallocate(m_data, m_capacity * sizeof(T), alignof(T));
+                    m_data = InlineData();
+                    m_capacity = N;
+                }
+            }
+
+            // Moves the elements to `data`, which has room for `capacity` elements, and frees the old storage.
+            void MoveTo(T* data, size_t capacity) noexcept {
+                std::uninitialized_move(begin(), end(), data);
+                std::destroy(begin(), end());
+                FreeData();
+                m_data = data;
+                m_capacity = capacity;
+            }
+
+            void Reallocate(size_t capacity) {
+                if (capacity <= N) {
+                    if (!IsInline()) {
+                        T* data = m_data;
+                        size_t old_capacity = m_capacity;
+                        std::uninitialized_move(data, data + m_size, InlineData());
+                        std::destroy(data, data + m_size);
+                        m_resource->deallocate(data, old_capacity * sizeof(T), alignof(T));
+                        m_data = InlineData();
+                        m_capacity = N;
+                    }
+                    return;
+                }
+                MoveTo(Allocate(capacity), capacity);
+            }
+
+            template <typename Iter>
+            void Append(Iter first, Iter last) {
+                if constexpr (std::is_base_of_v<
+                    std::forward_iterator_tag,
+                    typename std::iterator_traits<Iter>::iterator_category
+                >) {
+                    reserve(m_size + static_cast<size_t>(std::distance(first, last)));
+                }
+                for (; first != last; ++first) {
+                    emplace_back(*first);
+                }
+            }
+
+            // Takes the elements of `other`, which has the same resource, while this is empty.
+            void Steal(SmallVector& other) noexcept {
+                if (other.IsInline()) {
+                    std::uninitialized_move(other.begin(), other.end(), InlineData());
+                    m_size = other.m_size;
+                    other.clear();
+                    return;
+                }
+
+                m_data = other.m_data;
+                m_size = other.m_size;
+                m_capacity = other.m_capacity;
+                other.m_data = other.InlineData();
+                other.m_size = 0;
+                other.m_capacity = N;
+            }
+        };
+
+        //----------------------------------------------------------------------------------------------------
+
+        // The out of line storage of an array or object, allocated from the same resource as its contents.
+        // Copies of a `JsonValue` share it until one of them is changed, so like a `StringBlock` it has an
+        // atomic reference count.
+        //
+        // Storage is marked as leaked once a mutable reference to its value has been handed out, since the
+        // value may then be changed at any time through that reference.  Leaked storage is never shared
+        // again; copies of it are always made in full.  Only the sole owner of the storage can leak it.
+        template <typename T>
+        struct SharedData {
+            std::atomic<size_t> Refs;
+            bool Leaked;
+            T Value;
+
+            explicit SharedData(T&& value) noexcept
+              : Refs(1),
+                Leaked(false),
+                Value(std::move(value))
+            {}
+
+            static SharedData* Create(T&& value) {
+                auto resource = value.get_allocator().resource();
+                return new (resource->allocate(sizeof(SharedData), alignof(SharedData))) SharedData(std::move(value));
+            }
+
+            std::pmr::memory_resource* Resource() const noexcept {
+                return Value.get_allocator().resource();
+            }
+
+            bool IsShared() const noexcept {
+                return Refs.load(std::memory_order_acquire) != 1;
+            }
+
+            // Returns a new reference to this storage for a copy of its value.  As with `StringBlock`, only
+            // storage from `std::pmr::new_delete_resource()` is shared; the rest, and any leaked storage, is
+            // copied to the default resource.
+            SharedData* Share() {
+                if (Leaked || Resource() != std::pmr::new_delete_resource()) {
+                    return Create(T(Value));
+                }
+                Refs.fetch_add(1, std::memory_order_relaxed);
+                return this;
+            }
+
+            // Returns storage that only this reference uses, copying the value if it is shared, and marks it
+            // as leaked.
+            SharedData* Leak() {
+                if (!IsShared()) {
+                    Leaked = true;
+                    return this;
+                }
+                auto copy = Create(T(Value));
+                Release();
+                copy->Leaked = true;
+                return copy;
+            }
+
+            void Release() noexcept {
+                if (Refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    auto resource = Resource();
+                    this->~SharedData();
+                    resource->deallocate(this, sizeof(SharedData), alignof(SharedData));
+                }
+            }
+        };
+
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+    //--------------------------------------------------------------------------------------------------------
     //--------------------------------------------------------------------------------------------------------
 
+    // A JSON value in 16 bytes.  Numbers and booleans are stored inline, as are strings of up to
+    // `JsonString::InlineCapacity` bytes.  Longer strings share the reference counted block of a `JsonString`,
+    // and arrays and objects are held out of line, allocated from the same memory resource as their contents.
+    //
+    // Copying a value shares its array or object rather than copying it, so copies of a large tree are cheap
+    // and may be used on different threads.  The first call to the non-const `AsArray()` or `AsObject()` on a
+    // shared value gives it a copy of its own, whose elements in turn share their contents with the original.
+    // Since the reference returned by those calls can change the value later, an array or object that has
+    // been accessed that way is copied in full by any later copy of the value, rather than shared.
     class JsonValue
     {
     public:
         JsonValue() noexcept
-          : m_type(JsonValueType::Null)
+          : m_size(0),
+            m_type(JsonValueType::Null)
         {}
 
         JsonValue(std::nullptr_t) noexcept
-          : m_type(JsonValueType::Null)
+          : JsonValue()
         {}
 
         //----------------------------------------------------------------------------------------------------
 
-        JsonValue(std::string value) noexcept
+        JsonValue(JsonString value) noexcept
           : m_type(JsonValueType::String)
         {
-            new (&m_data.String) std::string(std::move(value));
+            SetString(std::move(value));
         }
 
+        JsonValue(const std::string& value) noexcept
+          : JsonValue(JsonString(value))
+        {}
+
         JsonValue(const char* value) noexcept
-          : JsonValue(std::string(value))
+          : JsonValue(JsonString(value))
         {}
 
         JsonValue(const std::string_view& value) noexcept
-          : JsonValue(std::string(value))
+          : JsonValue(JsonString(value))
+        {}
+
+        JsonValue(const std::string_view& value, std::pmr::memory_resource* resource) noexcept
+          : JsonValue(JsonString(value, resource))
         {}
 
         //----------------------------------------------------------------------------------------------------
 
         JsonValue(int64_t value) noexcept
-          : m_type(JsonValueType::Int)
+          : m_size(0),
+            m_type(JsonValueType::Int)
         {
-            m_data.Int = value;
+            Store<std::intmax_t>(value);
         }
 
         JsonValue(int32_t value) noexcept
@@ -125,9 +824,10 @@ namespace json {
         //----------------------------------------------------------------------------------------------------
 
         JsonValue(uint64_t value) noexcept
-          : m_type(JsonValueType::UInt)
+          : m_size(0),
+            m_type(JsonValueType::UInt)
         {
-            m_data.UInt = value;
+            Store<std::uintmax_t>(value);
         }
 
         JsonValue(uint32_t value) noexcept
@@ -137,9 +837,10 @@ namespace json {
         //----------------------------------------------------------------------------------------------------
 
         JsonValue(double value) noexcept
-          : m_type(JsonValueType::Real)
+          : m_size(0),
+            m_type(JsonValueType::Real)
         {
-            m_data.Real = value;
+            Store(value);
         }
 
         JsonValue(float value) noexcept
@@ -149,46 +850,28 @@ namespace json {
         //----------------------------------------------------------------------------------------------------
 
         JsonValue(bool value) noexcept
-          : m_type(JsonValueType::Boolean)
+          : m_size(0),
+            m_type(JsonValueType::Boolean)
         {
-            m_data.Bool = value;
+            Store(value);
         }
 
         //----------------------------------------------------------------------------------------------------
 
-        JsonValue(JsonArray&& value) noexcept
-          : m_type(JsonValueType::Array)
-        {
-            new (&m_data.Array) JsonArray(std::forward<JsonArray>(value));
-        }
+        inline JsonValue(JsonArray&& value) noexcept;
 
         //----------------------------------------------------------------------------------------------------
 
-        JsonValue(JsonObject&& value) noexcept
-          : m_type(JsonValueType::Object)
-        {
-            new (&m_data.Object) JsonObject(std::forward<JsonObject>(value));
-        }
+        inline JsonValue(JsonObject&& value) noexcept;
 
         //----------------------------------------------------------------------------------------------------
 
         JsonValue(JsonValueType type) noexcept
-          : m_type(type)
-        {
-            switch (type) {
-            case JsonValueType::Int: m_data.Int = 0; break;
-            case JsonValueType::UInt: m_data.UInt = 0; break;
-            case JsonValueType::Real: m_data.Real = 0; break;
-            case JsonValueType::Boolean: m_data.Bool = false; break;
-            case JsonValueType::String: new (&m_data.String) std::string(); break;
-            case JsonValueType::Array: new (&m_data.Array) JsonArray(); break;
-            case JsonValueType::Object: new (&m_data.Object) JsonObject(); break;
+          : JsonValue(type, std::pmr::get_default_resource())
+        {}
 
-            case JsonValueType::Null:
-            default:
-                break;
-            }
-        }
+        // Creates an empty value of the given type.  An array or object allocates from `resource`.
+        inline JsonValue(JsonValueType type, std::pmr::memory_resource* resource) noexcept;
 
         //----------------------------------------------------------------------------------------------------
 
@@ -199,100 +882,39 @@ namespace json {
         //----------------------------------------------------------------------------------------------------
 
         JsonValue(const JsonValue& other) noexcept
-          : m_type(JsonValueType::Null)
+          : JsonValue()
         {
             *this = other;
         }
 
         //----------------------------------------------------------------------------------------------------
 
-        JsonValue(JsonValue&& other) noexcept
-          : m_type(JsonValueType::Null)
-        {
-            *this = std::forward<JsonValue>(other);
+        JsonValue(JsonValue&& other) noexcept {
+            TakeData(other);
         }
 
         //----------------------------------------------------------------------------------------------------
         
-        JsonValue& operator = (const JsonValue& other) noexcept {
-            FreeData();
+        inline JsonValue& operator = (const JsonValue& other) noexcept;
 
-            m_type = other.m_type;
-            switch (m_type) {
-            case JsonValueType::Int: m_data.Int = other.m_data.Int; break;
-            case JsonValueType::UInt: m_data.UInt = other.m_data.UInt; break;
-            case JsonValueType::Real: m_data.Real = other.m_data.Real; break;
-            case JsonValueType::Boolean: m_data.Bool = other.m_data.Bool; break;
-            case JsonValueType::String: new (&m_data.String) std::string(other.m_data.String); break;
-            case JsonValueType::Array: new (&m_data.Array) JsonArray(other.m_data.Array); break;
-            case JsonValueType::Object: new (&m_data.Object) JsonObject(other.m_data.Object); break;
-            case JsonValueType::Null: break;
+        //----------------------------------------------------------------------------------------------------
+
+        JsonValue& operator = (JsonValue&& other) noexcept {
+            if (this != &other) {
+                FreeData();
+                TakeData(other);
             }
             return *this;
         }
 
         //----------------------------------------------------------------------------------------------------
 
-        JsonValue& operator = (JsonValue&& other) noexcept {
-            FreeData();
+        inline bool operator == (const JsonValue& other) const;
 
-            m_type = other.m_type;
-            switch (m_type) {
-            case JsonValueType::Int: m_data.Int = other.m_data.Int; break;
-            case JsonValueType::UInt: m_data.UInt = other.m_data.UInt; break;
-            case JsonValueType::Real: m_data.Real = other.m_data.Real; break;
-            case JsonValueType::Boolean: m_data.Bool = other.m_data.Bool; break;
-            case JsonValueType::String: new (&m_data.String) std::string(std::move(other.m_data.String)); break;
-            case JsonValueType::Array: new (&m_data.Array) JsonArray(std::move(other.m_data.Array)); break;
-            case JsonValueType::Object: new (&m_data.Object) JsonObject(std::move(other.m_data.Object)); break;
-            case JsonValueType::Null: break;
-            }
-            other.FreeData();
-            other.m_type = JsonValueType::Null;
+        //----------------------------------------------------------------------------------------------------
 
-            return *this;
-        }
-
-        //----------------------------------------------------------------------------------------------------
-
-        bool operator == (const JsonValue& other) const {
-            if (m_type != other.m_type) {
-                return false;
-            }
-
-            switch (m_type) {
-            case JsonValueType::Null: return true;
-            case JsonValueType::Int: return m_data.Int == other.m_data.Int;
-            case JsonValueType::UInt: return m_data.UInt == other.m_data.UInt;
-            case JsonValueType::Real: return m_data.Real == other.m_data.Real;
-            case JsonValueType::Boolean: return m_data.Bool == other.m_data.Bool;
-            case JsonValueType::String: return m_data.String == other.m_data.String;
-            case JsonValueType::Array: return m_data.Array == other.m_data.Array;
-            case JsonValueType::Object: return m_data.Object == other.m_data.Object;
-            default:
-                return false;
-            }
-        }
-
-        //----------------------------------------------------------------------------------------------------
-
-        bool operator != (const JsonValue& other) const {
-            if (m_type != other.m_type) {
-                return true;
-            }
-
-            switch (m_type) {
-            case JsonValueType::Null: return false;
-            case JsonValueType::Int: return m_data.Int != other.m_data.Int;
-            case JsonValueType::UInt: return m_data.UInt != other.m_data.UInt;
-            case JsonValueType::Real: return m_data.Real != other.m_data.Real;
-            case JsonValueType::Boolean: return m_data.Bool != other.m_data.Bool;
-            case JsonValueType::String: return m_data.String != other.m_data.String;
-            case JsonValueType::Array: return m_data.Array != other.m_data.Array;
-            case JsonValueType::Object: return m_data.Object != other.m_data.Object;
-            default:
-                return false;
-            }
+        bool operator != (const JsonValue& other) const {
+            return !(*this == other);
         }
 
         //----------------------------------------------------------------------------------------------------
@@ -313,11 +935,11 @@ namespace json {
 
         std::string AsString() const {
             switch (m_type) {
-            case JsonValueType::String: return m_data.String;
-            case JsonValueType::Int: return std::to_string(m_data.Int);
-            case JsonValueType::UInt: return std::to_string(m_data.UInt);
-            case JsonValueType::Real: return std::to_string(m_data.Real);
-            case JsonValueType::Boolean: return m_data.Bool ? std::string("true") : std::string("false");
+            case JsonValueType::String: return std::string(StringView());
+            case JsonValueType::Int: return std::to_string(Load<std::intmax_t>());
+            case JsonValueType::UInt: return std::to_string(Load<std::uintmax_t>());
+            case JsonValueType::Real: return std::to_string(Load<double>());
+            case JsonValueType::Boolean: return Load<bool>() ? std::string("true") : std::string("false");
             case JsonValueType::Null: return std::string("null");
 
             case JsonValueType::Array:
@@ -332,11 +954,11 @@ namespace json {
 
         std::intmax_t AsInt() const{
             switch (m_type) {
-            case JsonValueType::String: return std::stoll(m_data.String);
-            case JsonValueType::Int: return m_data.Int;
-            case JsonValueType::UInt: return static_cast<std::intmax_t>(m_data.UInt);
-            case JsonValueType::Real: return static_cast<std::intmax_t>(m_data.Real);
-            case JsonValueType::Boolean: return m_data.Bool ? 1 : 0;
+            case JsonValueType::String: return std::stoll(AsString());
+            case JsonValueType::Int: return Load<std::intmax_t>();
+            case JsonValueType::UInt: return static_cast<std::intmax_t>(Load<std::uintmax_t>());
+            case JsonValueType::Real: return static_cast<std::intmax_t>(Load<double>());
+            case JsonValueType::Boolean: return Load<bool>() ? 1 : 0;
 
             case JsonValueType::Null:
             case JsonValueType::Array:
@@ -351,11 +973,11 @@ namespace json {
 
         std::uintmax_t AsUInt() const {
             switch (m_type) {
-            case JsonValueType::String: return std::stoull(m_data.String);
-            case JsonValueType::Int: return static_cast<std::uintmax_t>(m_data.Int);
-            case JsonValueType::UInt: return m_data.UInt;
-            case JsonValueType::Real: return static_cast<std::uintmax_t>(m_data.Real);
-            case JsonValueType::Boolean: return m_data.Bool ? 1 : 0;
+            case JsonValueType::String: return std::stoull(AsString());
+            case JsonValueType::Int: return static_cast<std::uintmax_t>(Load<std::intmax_t>());
+            case JsonValueType::UInt: return Load<std::uintmax_t>();
+            case JsonValueType::Real: return static_cast<std::uintmax_t>(Load<double>());
+            case JsonValueType::Boolean: return Load<bool>() ? 1 : 0;
 
             case JsonValueType::Null:
             case JsonValueType::Array:
@@ -370,11 +992,11 @@ namespace json {
 
         float AsFloat() const {
             switch (m_type) {
-            case JsonValueType::String: return std::stof(m_data.String);
-            case JsonValueType::Int: return static_cast<float>(m_data.Int);
-            case JsonValueType::UInt: return static_cast<float>(m_data.UInt);
-            case JsonValueType::Real: return static_cast<float>(m_data.Real);
-            case JsonValueType::Boolean: return m_data.Bool ? 1.0f : 0.0f;
+            case JsonValueType::String: return std::stof(AsString());
+            case JsonValueType::Int: return static_cast<float>(Load<std::intmax_t>());
+            case JsonValueType::UInt: return static_cast<float>(Load<std::uintmax_t>());
+            case JsonValueType::Real: return static_cast<float>(Load<double>());
+            case JsonValueType::Boolean: return Load<bool>() ? 1.0f : 0.0f;
 
             case JsonValueType::Null:
             case JsonValueType::Array:
@@ -389,11 +1011,11 @@ namespace json {
 
         double AsDouble() const {
             switch (m_type) {
-            case JsonValueType::String: return std::stod(m_data.String);
-            case JsonValueType::Int: return static_cast<double>(m_data.Int);
-            case JsonValueType::UInt: return static_cast<double>(m_data.UInt);
-            case JsonValueType::Real: return m_data.Real;
-            case JsonValueType::Boolean: return m_data.Bool ? 1.0 : 0.0;
+            case JsonValueType::String: return std::stod(AsString());
+            case JsonValueType::Int: return static_cast<double>(Load<std::intmax_t>());
+            case JsonValueType::UInt: return static_cast<double>(Load<std::uintmax_t>());
+            case JsonValueType::Real: return Load<double>();
+            case JsonValueType::Boolean: return Load<bool>() ? 1.0 : 0.0;
 
             case JsonValueType::Null:
             case JsonValueType::Array:
@@ -408,13 +1030,13 @@ namespace json {
 
         bool AsBool() const {
             switch (m_type) {
-            case JsonValueType::Int: return (m_data.Int != 0);
-            case JsonValueType::UInt: return (m_data.UInt != 0);
-            case JsonValueType::Real: return (m_data.Real != 0.0);
-            case JsonValueType::Boolean: return m_data.Bool;
+            case JsonValueType::Int: return (Load<std::intmax_t>() != 0);
+            case JsonValueType::UInt: return (Load<std::uintmax_t>() != 0);
+            case JsonValueType::Real: return (Load<double>() != 0.0);
+            case JsonValueType::Boolean: return Load<bool>();
             case JsonValueType::String:
-                if (m_data.String == "true") { return true; }
-                if (m_data.String == "false") { return false; }
+                if (StringView() == "true") { return true; }
+                if (StringView() == "false") { return false; }
                 throw std::runtime_error("Failed to convert string to bool");
 
             case JsonValueType::Null:
@@ -428,51 +1050,86 @@ namespace json {
 
         //----------------------------------------------------------------------------------------------------
 
-        const JsonArray& AsArray() const { AssertArray(); return m_data.Array; }
-              JsonArray& AsArray()       { AssertArray(); return m_data.Array; }
+        const JsonArray& AsArray() const { AssertArray(); return ArrayData(); }
+        inline JsonArray& AsArray();
 
-        const JsonObject& AsObject() const { AssertObject(); return m_data.Object; }
-              JsonObject& AsObject()       { AssertObject(); return m_data.Object; }
+        const JsonObject& AsObject() const { AssertObject(); return ObjectData(); }
+        inline JsonObject& AsObject();
 
     private:
+        static constexpr uint8_t BlockTag = 0xFF;
+
+        // Numbers, booleans and the pointers to long strings, arrays and objects are stored at the start of
+        // `m_bytes`.  A string of up to `JsonString::InlineCapacity` bytes fills it instead, with its size in
+        // `m_size`; for a longer string `m_size` is `BlockTag`.
+        alignas(8) unsigned char m_bytes[JsonString::InlineCapacity] = {};
+        uint8_t m_size;
         JsonValueType m_type;
 
-        union Data {
-            std::intmax_t Int;
-            std::uintmax_t UInt;
-            double Real;
-            bool Bool;
-			std::string String;
-			JsonArray Array;
-			JsonObject Object;
+        template <typename T>
+        T Load() const noexcept {
+            T value;
+            std::memcpy(&value, m_bytes, sizeof(T));
+            return value;
+        }
 
-			Data() : Int(0) {}
-			~Data() {}
-		};
+        template <typename T>
+        void Store(T value) noexcept {
+            std::memcpy(m_bytes, &value, sizeof(T));
+        }
 
-		Data m_data;
+        //----------------------------------------------------------------------------------------------------
 
-        void FreeData() {
-            switch (m_type) {
-            case JsonValueType::String:
-                m_data.String.~basic_string();
-                break;
+        using SharedArray = detail::SharedData<JsonArray>;
+        using SharedObject = detail::SharedData<JsonObject>;
 
-            case JsonValueType::Array:
-                m_data.Array.~JsonArray();
-                break;
+        // The array or object, which may be shared with copies of this value.  Only the reader changes it
+        // through these, and only while it is the sole owner.
+        inline JsonArray& ArrayData() const noexcept;
+        inline JsonObject& ObjectData() const noexcept;
 
-            case JsonValueType::Object:
-                m_data.Object.~JsonObject();
-                break;
+        inline bool IsShared() const noexcept;
 
-            default:
-                break;
+        //----------------------------------------------------------------------------------------------------
+
+        bool IsInlineString() const noexcept { return m_size != BlockTag; }
+
+        std::string_view StringView() const noexcept {
+            if (IsInlineString()) { return { reinterpret_cast<const char*>(m_bytes), m_size }; }
+            auto block = Load<detail::StringBlock*>();
+            return { block->Chars(), block->Size };
+        }
+
+        void SetString(JsonString&& value) noexcept {
+            if (value.IsInline()) {
+                std::memcpy(m_bytes, value.m_bytes, sizeof(m_bytes));
+                m_size = static_cast<uint8_t>(value.Size());
+            } else {
+                Store(value.TakeBlock());
+                m_size = BlockTag;
             }
+        }
 
+        // Moves the string out of this value, leaving it null.
+        JsonString TakeString() noexcept {
+            JsonString string = IsInlineString()
+                ? JsonString(StringView())
+                : JsonString::FromBlock(Load<detail::StringBlock*>());
             m_type = JsonValueType::Null;
+            return string;
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        void TakeData(JsonValue& other) noexcept {
+            std::memcpy(m_bytes, other.m_bytes, sizeof(m_bytes));
+            m_size = other.m_size;
+            m_type = other.m_type;
+            other.m_type = JsonValueType::Null;
         }
 
+        inline void FreeData() noexcept;
+
         inline void AssertArray() const {
             if (m_type != JsonValueType::Array) {
                 throw std::logic_error("Value is not an array");
@@ -485,687 +1142,6137 @@ namespace json {
         }
 
         friend class ObjectWriter;
+        friend class ObjectReader;
     };
 
-    //--------------------------------------------------------------------------------------------------------
+    static_assert(sizeof(JsonValue) == 16, "JsonValue should be 16 bytes");
 
-    inline bool JsonObject::Exists(const std::string_view& name) const {
-        return find(name) != end();
-    }
+    //--------------------------------------------------------------------------------------------------------
 
-    inline bool JsonObject::Exists(const std::string_view& name, JsonValueType type) const {
-        auto it = find(name);
-        if (it == end()) { return false; }
-        return it->second.Type() == type;
-    }
+    // Arrays and objects allocate from a `std::pmr::memory_resource`, which is the default resource unless
+    // another is given.  Moving them keeps their resource, while copies use the default resource.  Each has
+    // room for a few elements inline, so that small ones need no allocation beyond the `JsonValue` holding
+    // them.
+    class JsonArray :
+        public detail::SmallVector<JsonValue, 4>
+    {
+        using base_type = detail::SmallVector<JsonValue, 4>;
 
-    //--------------------------------------------------------------------------------------------------------
-    //--------------------------------------------------------------------------------------------------------
-    //--------------------------------------------------------------------------------------------------------
-    
-    class ISimpleReaderHooks {
     public:
-        virtual ~ISimpleReaderHooks() = default;
+        JsonArray() noexcept = default;
 
-        virtual bool OnNull() = 0;
-        virtual bool OnBool(bool value) = 0;
-        virtual bool OnInt(int64_t value) = 0;
-        virtual bool OnUInt(uint64_t value) = 0;
-        virtual bool OnReal(double value) = 0;
-        virtual bool OnString(std::string_view value) = 0;
+        explicit JsonArray(std::pmr::memory_resource* resource) noexcept
+          : base_type(resource)
+        {}
 
-        virtual bool OnArrayStart() = 0;
-        virtual bool OnArrayEnd() = 0;
+        explicit JsonArray(std::initializer_list<JsonValue> values)
+          : base_type(values)
+        {}
 
-        virtual bool OnObjectStart() = 0;
-        virtual bool OnObjectKey(std::string_view value) = 0;
-        virtual bool OnObjectEnd() = 0;
+        template <typename Iter>
+        JsonArray(Iter first, Iter last)
+          : base_type(first, last)
+        {}
     };
 
     //--------------------------------------------------------------------------------------------------------
 
-    class SimpleReader {
+    // The order in which the members of a `JsonObject` are kept, and so iterated and written.
+    enum class KeyOrder : uint8_t {
+        Sorted,             // Sorted by key.
+        Insertion           // In the order they were inserted.
+    };
+
+    //--------------------------------------------------------------------------------------------------------
+
+    // The members of an object, kept in a contiguous array rather than a tree.  Small objects are faster to
+    // build, search and iterate this way, and need one allocation rather than one per member.  Keys are unique,
+    // and inserting a key that already exists leaves the object unchanged, as with `std::map`.  Inserting or
+    // erasing a member moves the members after it, and invalidates iterators and references.
+    //
+    // By default the members are sorted by key, and searched linearly while there are few of them or by
+    // bisection beyond that.  An object created with `KeyOrder::Insertion` keeps them in the order they were
+    // inserted instead.  Once it has more than a few members, such an object builds a hash index of its keys,
+    // so that inserting and finding a key doesn't depend on the size of the object.
+    class JsonObject {
+        using storage_type = detail::SmallVector<std::pair<JsonString, JsonValue>, 4>;
+
+        template <typename K>
+        using EnableIfKey = std::enable_if_t<std::is_convertible_v<const K&, std::string_view>>;
+
     public:
-        static bool Parse(
-            std::string_view data,
-            ISimpleReaderHooks*const hooks,
-            bool ignore_comments = false
-        ) {
-            State state{
-                ignore_comments,
-                data.data(),
-                data.data() + data.size(),
-                hooks
-            };
-            return ParseValue(state);
-        }
+        using key_type = JsonString;
+        using mapped_type = JsonValue;
+        using value_type = std::pair<JsonString, JsonValue>;
+        using size_type = size_t;
+        using iterator = value_type*;
+        using const_iterator = const value_type*;
+        using allocator_type = storage_type::allocator_type;
 
-    private:
-        struct State {
-            const bool IgnoreComments;
-            const char* NextChar;
-            const char*const End;
-            ISimpleReaderHooks*const Hooks;
+        static constexpr size_t InlineCapacity = storage_type::InlineCapacity;
 
-            bool Eof() const noexcept { return NextChar >= End; }
-            size_t BytesRemaining() const noexcept { return std::distance(NextChar, End); }
-        };
+        JsonObject() noexcept = default;
 
-        //----------------------------------------------------------------------------------------------------
+        explicit JsonObject(std::pmr::memory_resource* resource) noexcept
+          : JsonObject(KeyOrder::Sorted, resource)
+        {}
 
-        static bool ParseValue(State& state) {
-            if (!SkipCommentsAndWhitespace(state)) { return false; }
-            if (state.Eof()) { return true; }
+        explicit JsonObject(KeyOrder order, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept
+          : m_members(resource),
+            m_index(resource),
+            m_order(order)
+        {}
 
-            switch (*state.NextChar) {
-            case 't': return ParseTrue(state);
-            case 'f': return ParseFalse(state);
-            case 'n': return ParseNull(state);
-            case '"': return ParseString(state);
-            case '[': return ParseArray(state);
-            case '{': return ParseObject(state);
-            default: return ParseNumber(state);
-            }
+        explicit JsonObject(std::initializer_list<value_type> values) {
+            insert(values.begin(), values.end());
+        }
+
+        JsonObject(KeyOrder order, std::initializer_list<value_type> values)
+          : m_order(order)
+        {
+            insert(values.begin(), values.end());
+        }
+
+        template <typename Iter>
+        JsonObject(Iter first, Iter last) {
+            insert(first, last);
         }
 
         //----------------------------------------------------------------------------------------------------
 
-        static void SkipWhitespace(State& state) {
-            // Fast check for no whitespace.
-            if (state.Eof()) { return; }
-
-#ifdef CPPJSON_USE_SSE
-            const __m128i SpaceChar128 = _mm_set1_epi8(' ');
-            const __m128i ReturnChar128 = _mm_set1_epi8('\r');
-            const __m128i LineFeedChar128 = _mm_set1_epi8('\n');
-            const __m128i TabChar128 = _mm_set1_epi8('\t');
-
-            // SSE2 main loop.
-            size_t loop_count = state.BytesRemaining() / sizeof(__m128i);
-            while (loop_count != 0) {
-                __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state.NextChar));
-
-                __m128i mask = _mm_cmpeq_epi8(chars, SpaceChar128);
-                mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chars, ReturnChar128));
-                mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chars, LineFeedChar128));
-                mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chars, TabChar128));
-
-                uint16_t bitmask = static_cast<uint16_t>(~_mm_movemask_epi8(mask));
-                if (bitmask != 0) {
-#ifdef __GNUG__
-                    int32_t offset = __builtin_ffs(static_cast<int32_t>(bitmask)) - 1;
-#endif
-#ifdef _MSC_VER
-                    unsigned long offset;
-                    _BitScanForward(&offset, static_cast<uint32_t>(bitmask));
-#endif
-                    state.NextChar += offset;
-                    return;
-                }
+        iterator begin() noexcept { return m_members.begin(); }
+        iterator end() noexcept { return m_members.end(); }
+        const_iterator begin() const noexcept { return m_members.begin(); }
+        const_iterator end() const noexcept { return m_members.end(); }
+        const_iterator cbegin() const noexcept { return m_members.cbegin(); }
+        const_iterator cend() const noexcept { return m_members.cend(); }
 
-                state.NextChar += sizeof(__m128i);
-                loop_count--;
-            }
+        size_t size() const noexcept { return m_members.size(); }
+        size_t capacity() const noexcept { return m_members.capacity(); }
+        bool empty() const noexcept { return m_members.empty(); }
 
-            // Plain loop for the <16 remaining chars.
-#endif
+        void reserve(size_t capacity) { m_members.reserve(capacity); }
 
-            while (!state.Eof()) {
-                char c = *state.NextChar;
-                bool is_space = (c == ' ') || (c == '\r') || (c == '\n') || (c == '\t');
-                if (!is_space) { return; }
-                ++state.NextChar;               
-            }
+        void clear() noexcept {
+            m_members.clear();
+            m_index.clear();
         }
 
+        allocator_type get_allocator() const noexcept { return m_members.get_allocator(); }
+
+        KeyOrder Order() const noexcept { return m_order; }
+
         //----------------------------------------------------------------------------------------------------
 
-        static void ScanString(State& state) {
-            // Fast check for empty string.
-            if (*state.NextChar == '"') {
-                return;
+        iterator find(std::string_view key) noexcept {
+            if (m_order == KeyOrder::Sorted) {
+                auto it = LowerBound(key);
+                return (it != end() && it->first == key) ? it : end();
             }
+            if (!m_index.empty()) {
+                return FindIndexed(key);
+            }
+            return std::find_if(begin(), end(), [key](const value_type& member) { return member.first == key; });
+        }
+        const_iterator find(std::string_view key) const noexcept {
+            return const_cast<JsonObject*>(this)->find(key);
+        }
 
-#ifdef CPPJSON_USE_SSE
-            const __m128i QuoteChar128 = _mm_set1_epi8('"');
-            const __m128i EscapeChar128 = _mm_set1_epi8('\\');
+        size_t count(std::string_view key) const noexcept {
+            return (find(key) != end()) ? 1 : 0;
+        }
 
-            // SSE2 main loop.
-            size_t loop_count = state.BytesRemaining() / sizeof(__m128i);
-            if (loop_count != 0) {
-                uint16_t bitmask_escape = 0;
-                while (loop_count != 0) {
-                    __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state.NextChar));
+        JsonValue& at(std::string_view key) {
+            auto it = find(key);
+            if (it == end()) { throw std::out_of_range("Key not found"); }
+            return it->second;
+        }
+        const JsonValue& at(std::string_view key) const {
+            return const_cast<JsonObject*>(this)->at(key);
+        }
 
-                    __m128i mask_quote = _mm_cmpeq_epi8(chars, QuoteChar128);
-                    __m128i mask_escape = _mm_cmpeq_epi8(chars, EscapeChar128);
-                    uint16_t bitmask_quote = static_cast<uint16_t>(_mm_movemask_epi8(mask_quote));
-                    bitmask_escape |= static_cast<uint16_t>(_mm_movemask_epi8(mask_escape)) << 1;
+        // Returns the value of `key`, adding a null value first if there isn't one.
+        template <typename K, typename = EnableIfKey<K>>
+        JsonValue& operator [] (K&& key) {
+            return try_emplace(std::forward<K>(key)).first->second;
+        }
 
-                    uint16_t bitmask_unescaped_quote = bitmask_quote & ~bitmask_escape;
-                    if (bitmask_unescaped_quote != 0) {
-#ifdef __GNUG__
-                        int32_t offset = __builtin_ffs(static_cast<int32_t>(bitmask_unescaped_quote)) - 1;
-#endif
-#ifdef _MSC_VER
-                        unsigned long offset;
-                        _BitScanForward(&offset, static_cast<uint32_t>(bitmask_unescaped_quote));
-#endif
-                        state.NextChar += offset;
-                        return;
-                    }
+        //----------------------------------------------------------------------------------------------------
 
-                    --loop_count;
-                    state.NextChar += sizeof(__m128i);
-                    bitmask_escape = static_cast<uint16_t>(_mm_movemask_epi8(mask_escape)) >> (sizeof(__m128i) - 1);
+        // Adds a member with the key `key` and a value constructed from `args`, unless the key already exists.
+        template <typename K, typename... Args, typename = EnableIfKey<K>>
+        std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+            std::string_view view(key);
+            if (m_order == KeyOrder::Insertion) {
+                auto it = find(view);
+                if (it != end()) {
+                    return { it, false };
                 }
+                Append(JsonString(std::forward<K>(key)), JsonValue(std::forward<Args>(args)...));
+                return { end() - 1, true };
             }
 
-            // Plain loop for the <16 remaining chars.
-#endif
-
-            for (; !state.Eof(); ++state.NextChar) {
-                if (*state.NextChar == '\\') {
-                    ++state.NextChar;
-                    continue;
-                }
-                if (*state.NextChar == '"') {
-                    return;
-                }
+            auto it = LowerBound(view);
+            if (it != end() && it->first == view) {
+                return { it, false };
             }
+            it = m_members.emplace(it, JsonString(std::forward<K>(key)), JsonValue(std::forward<Args>(args)...));
+            return { it, true };
         }
 
-        //----------------------------------------------------------------------------------------------------
-
-        static bool ParseTrue(State& state) {
-            if (state.BytesRemaining() < 4) { return false; }
+        template <typename K, typename V, typename = EnableIfKey<K>>
+        std::pair<iterator, bool> emplace(K&& key, V&& value) {
+            return try_emplace(std::forward<K>(key), std::forward<V>(value));
+        }
 
-            uint32_t tmp = *reinterpret_cast<const uint32_t*>(state.NextChar + 1);
-            tmp &= 0xFFFFFF;
-            if (tmp == 0x657572) {
-                state.NextChar += 4;
-                return state.Hooks->OnBool(true);
-            }
-            return false;
+        std::pair<iterator, bool> insert(value_type value) {
+            return try_emplace(std::move(value.first), std::move(value.second));
         }
 
-        static bool ParseFalse(State& state) {
-            if (state.BytesRemaining() < 5) { return false; }
-            
-            uint32_t tmp = *reinterpret_cast<const uint32_t*>(state.NextChar + 1);
-            if (tmp == 0x65736C61) {
-                state.NextChar += 5;
-                return state.Hooks->OnBool(false);
+        template <typename Iter>
+        void insert(Iter first, Iter last) {
+            for (; first != last; ++first) {
+                insert(value_type(*first));
             }
-            return false;
         }
 
-        static bool ParseNull(State& state) {
-            if (state.BytesRemaining() < 4) { return false; }
+        iterator erase(const_iterator position) {
+            size_t index = static_cast<size_t>(position - begin());
+            m_members.erase(position);
+            Reindex();
+            return begin() + index;
+        }
 
-            uint32_t tmp = *reinterpret_cast<const uint32_t*>(state.NextChar + 1);
-            tmp &= 0xFFFFFF;
-            if (tmp == 0x6C6C75) {
-                state.NextChar += 4;
-                return state.Hooks->OnNull();
-            }
-            return false;
+        size_t erase(std::string_view key) {
+            auto it = find(key);
+            if (it == end()) { return 0; }
+            erase(it);
+            return 1;
         }
 
         //----------------------------------------------------------------------------------------------------
 
-        static bool ParseString(State& state) {
-            ++state.NextChar;
-            if (state.Eof()) { return false; }
-
-            const char* string_start = state.NextChar;
-            ScanString(state);
-            if (state.Eof()) { return false; }
-
-            size_t length = std::distance(string_start, state.NextChar);
-            ++state.NextChar;
-            return state.Hooks->OnString(std::string_view(string_start, length));
+        // Objects are equal if they have the same members, whatever order they are kept in.
+        friend bool operator == (const JsonObject& lhs, const JsonObject& rhs) {
+            if (lhs.m_order == KeyOrder::Sorted && rhs.m_order == KeyOrder::Sorted) {
+                return lhs.m_members == rhs.m_members;
+            }
+            if (lhs.size() != rhs.size()) {
+                return false;
+            }
+            for (auto& member : lhs) {
+                auto it = rhs.find(member.first.View());
+                if (it == rhs.end() || it->second != member.second) {
+                    return false;
+                }
+            }
+            return true;
         }
-
-        static bool ParseObjectKey(State& state) {
-            ++state.NextChar;
-            if (state.Eof()) { return false; }
-
-            const char* string_start = state.NextChar;
-            ScanString(state);
-            if (state.Eof()) { return false; }
-
-            size_t length = std::distance(string_start, state.NextChar);
-            ++state.NextChar;
-            return state.Hooks->OnObjectKey(std::string_view(string_start, length));
+        friend bool operator != (const JsonObject& lhs, const JsonObject& rhs) {
+            return !(lhs == rhs);
         }
 
         //----------------------------------------------------------------------------------------------------
 
-        static bool ParseArray(State& state) {
-            ++state.NextChar;
-
-            if (!SkipCommentsAndWhitespace(state)) { return false; }
-            if (state.Eof()) { return false; }
-
-            if (!state.Hooks->OnArrayStart()) { return false; }
+        inline bool Exists(const std::string_view& name) const;
+        inline bool Exists(const std::string_view& name, JsonValueType type) const;
 
-            if (*state.NextChar == ']') {
-                ++state.NextChar;
-                return state.Hooks->OnArrayEnd();
+    private:
+        // Up to this many members, keys are searched linearly rather than by bisection or through the index.
+        static constexpr size_t LinearSearchLimit = 8;
+
+        storage_type m_members;
+        // For `KeyOrder::Insertion`, an open addressing hash table of the members once there are more than
+        // `LinearSearchLimit`, and otherwise empty.  Each slot holds the position of a member plus one, or zero
+        // if it is free, and the table is kept at most half full.
+        std::pmr::vector<uint32_t> m_index;
+        KeyOrder m_order = KeyOrder::Sorted;
+
+        iterator LowerBound(std::string_view key) noexcept {
+            if (size() <= LinearSearchLimit) {
+                auto it = begin();
+                while (it != end() && it->first.View() < key) { ++it; }
+                return it;
             }
+            return std::lower_bound(begin(), end(), key, [](const value_type& member, std::string_view k) {
+                return member.first.View() < k;
+            });
+        }
 
-            for (;;) {
-                // Read value.
-                if (!ParseValue(state)) { return false; }
-
-                if (!SkipCommentsAndWhitespace(state)) { return false; }
-                if (state.Eof()) { return false; }
+        static size_t Hash(std::string_view key) noexcept {
+            return std::hash<std::string_view>()(key);
+        }
 
-                if (*state.NextChar == ']') {
-                    ++state.NextChar;
-                    return state.Hooks->OnArrayEnd();
+        iterator FindIndexed(std::string_view key) noexcept {
+            size_t mask = m_index.size() - 1;
+            for (size_t slot = Hash(key) & mask; m_index[slot] != 0; slot = (slot + 1) & mask) {
+                auto& member = m_members[m_index[slot] - 1];
+                if (member.first == key) {
+                    return &member;
                 }
-
-                // Read separator.
-                if (*state.NextChar != ',') { return false; }
-                ++state.NextChar;
             }
+            return end();
         }
 
-        //----------------------------------------------------------------------------------------------------
+        void IndexMember(size_t position) noexcept {
+            size_t mask = m_index.size() - 1;
+            size_t slot = Hash(m_members[position].first.View()) & mask;
+            while (m_index[slot] != 0) {
+                slot = (slot + 1) & mask;
+            }
+            m_index[slot] = static_cast<uint32_t>(position + 1);
+        }
 
-        static bool ParseObject(State& state) {
-            ++state.NextChar;
+        // Rebuilds the index from scratch, or drops it if it isn't needed.
+        void Reindex() {
+            m_index.clear();
+            if (m_order != KeyOrder::Insertion || size() <= LinearSearchLimit) {
+                return;
+            }
 
-            if (!SkipCommentsAndWhitespace(state)) { return false; }
-            if (state.Eof()) { return false; }
+            size_t slots = LinearSearchLimit * 4;
+            while (slots < size() * 2) { slots *= 2; }
+            m_index.assign(slots, 0);
+            for (size_t i = 0; i < size(); ++i) {
+                IndexMember(i);
+            }
+        }
 
-            if (!state.Hooks->OnObjectStart()) { return false; }
+        // Adds a member to the end without checking whether its key exists.  `ObjectReader` adds members in
+        // the order they are parsed, and only sorts them with `SortMembers()` if they were found out of order.
+        void Append(JsonString&& key, JsonValue&& value) {
+            m_members.emplace_back(std::move(key), std::move(value));
+            if (m_order != KeyOrder::Insertion || size() <= LinearSearchLimit) {
+                return;
+            }
 
-            if (*state.NextChar == '}') {
-                ++state.NextChar;
-                return state.Hooks->OnObjectEnd();
+            if (m_index.size() < size() * 2) {
+                Reindex();
+            } else {
+                IndexMember(size() - 1);
             }
+        }
 
-            for (;;) {
-                // Read key.
-                if (!ParseObjectKey(state)) { return false; }
+        // Sorts the members by key, keeping only the first member with each key.
+        void SortMembers() {
+            auto less = [](const value_type& lhs, const value_type& rhs) { return lhs.first < rhs.first; };
+            auto equal = [](const value_type& lhs, const value_type& rhs) { return lhs.first == rhs.first; };
+            std::stable_sort(begin(), end(), less);
+            m_members.erase(std::unique(begin(), end(), equal), end());
+        }
 
-                if (!SkipCommentsAndWhitespace(state)) { return false; }
-                if (state.Eof()) { return false; }
+        // Empties the object for reuse by `ObjectReader`, keeping its storage.
+        void Reset(KeyOrder order) noexcept {
+            clear();
+            m_order = order;
+        }
 
-                // Read separator.
-                if (*state.NextChar != ':') { return false; }
-                ++state.NextChar;
+        friend class ObjectReader;
+    };
 
-                if (!SkipCommentsAndWhitespace(state)) { return false; }
-                if (state.Eof()) { return false; }
+    //--------------------------------------------------------------------------------------------------------
 
-                // Read value.
-                if (!ParseValue(state)) { return false; }
+    inline JsonValue::JsonValue(JsonArray&& value) noexcept
+      : m_size(0),
+        m_type(JsonValueType::Array)
+    {
+        Store(SharedArray::Create(std::forward<JsonArray>(value)));
+    }
 
-                if (!SkipCommentsAndWhitespace(state)) { return false; }
-                if (state.Eof()) { return false; }
+    inline JsonValue::JsonValue(JsonObject&& value) noexcept
+      : m_size(0),
+        m_type(JsonValueType::Object)
+    {
+        Store(SharedObject::Create(std::forward<JsonObject>(value)));
+    }
 
-                if (*state.NextChar == '}') {
-                    ++state.NextChar;
-                    return state.Hooks->OnObjectEnd();
-                }
+    inline JsonValue::JsonValue(JsonValueType type, std::pmr::memory_resource* resource) noexcept
+      : m_size(0),
+        m_type(type)
+    {
+        switch (type) {
+        case JsonValueType::Int: Store<std::intmax_t>(0); break;
+        case JsonValueType::UInt: Store<std::uintmax_t>(0); break;
+        case JsonValueType::Real: Store(0.0); break;
+        case JsonValueType::Boolean: Store(false); break;
+        case JsonValueType::String: break;
+        case JsonValueType::Array: Store(SharedArray::Create(JsonArray(resource))); break;
+        case JsonValueType::Object: Store(SharedObject::Create(JsonObject(resource))); break;
+
+        case JsonValueType::Null:
+        default:
+            break;
+        }
+    }
 
-                if (*state.NextChar != ',') { return false; }
-                ++state.NextChar;
+    //--------------------------------------------------------------------------------------------------------
 
-                if (!SkipCommentsAndWhitespace(state)) { return false; }
-                if (state.Eof()) { return false; }
+    inline JsonValue& JsonValue::operator = (const JsonValue& other) noexcept {
+        if (this == &other) {
+            return *this;
+        }
+        FreeData();
+
+        switch (other.m_type) {
+        case JsonValueType::String:
+            if (other.IsInlineString()) {
+                std::memcpy(m_bytes, other.m_bytes, sizeof(m_bytes));
+            } else {
+                Store(other.Load<detail::StringBlock*>()->Share());
             }
+            break;
+        case JsonValueType::Array: Store(other.Load<SharedArray*>()->Share()); break;
+        case JsonValueType::Object: Store(other.Load<SharedObject*>()->Share()); break;
+        default: std::memcpy(m_bytes, other.m_bytes, sizeof(m_bytes)); break;
         }
+        m_size = other.m_size;
+        m_type = other.m_type;
+        return *this;
+    }
 
-        //----------------------------------------------------------------------------------------------------
+    //--------------------------------------------------------------------------------------------------------
 
-        static bool ParseNumber(State& state) {
-            bool is_negative = *state.NextChar == '-';
+    inline bool JsonValue::operator == (const JsonValue& other) const {
+        if (m_type != other.m_type) {
+            return false;
+        }
+
+        switch (m_type) {
+        case JsonValueType::Null: return true;
+        case JsonValueType::Int: return Load<std::intmax_t>() == other.Load<std::intmax_t>();
+        case JsonValueType::UInt: return Load<std::uintmax_t>() == other.Load<std::uintmax_t>();
+        case JsonValueType::Real: return Load<double>() == other.Load<double>();
+        case JsonValueType::Boolean: return Load<bool>() == other.Load<bool>();
+        case JsonValueType::String: return StringView() == other.StringView();
+        case JsonValueType::Array:
+            return Load<SharedArray*>() == other.Load<SharedArray*>() || ArrayData() == other.ArrayData();
+        case JsonValueType::Object:
+            return Load<SharedObject*>() == other.Load<SharedObject*>() || ObjectData() == other.ObjectData();
+        default:
+            return false;
+        }
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    inline JsonArray& JsonValue::ArrayData() const noexcept {
+        return Load<SharedArray*>()->Value;
+    }
+
+    inline JsonObject& JsonValue::ObjectData() const noexcept {
+        return Load<SharedObject*>()->Value;
+    }
+
+    inline JsonArray& JsonValue::AsArray() {
+        // Checked here rather than by `AssertArray()`, so the compiler can see that the storage isn't null.
+        if (m_type != JsonValueType::Array) {
+            throw std::logic_error("Value is not an array");
+        }
+        Store(Load<SharedArray*>()->Leak());
+        return ArrayData();
+    }
+
+    inline JsonObject& JsonValue::AsObject() {
+        if (m_type != JsonValueType::Object) {
+            throw std::logic_error("Value is not an object");
+        }
+        Store(Load<SharedObject*>()->Leak());
+        return ObjectData();
+    }
+
+    inline bool JsonValue::IsShared() const noexcept {
+        switch (m_type) {
+        case JsonValueType::Array: return Load<SharedArray*>()->IsShared();
+        case JsonValueType::Object: return Load<SharedObject*>()->IsShared();
+        default: return false;
+        }
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    inline void JsonValue::FreeData() noexcept {
+        switch (m_type) {
+        case JsonValueType::String:
+            if (!IsInlineString()) {
+                Load<detail::StringBlock*>()->Release();
+            }
+            break;
+
+        case JsonValueType::Array:
+            Load<SharedArray*>()->Release();
+            break;
+
+        case JsonValueType::Object:
+            Load<SharedObject*>()->Release();
+            break;
+
+        default:
+            break;
+        }
+
+        m_type = JsonValueType::Null;
+    }
+
+
+    //--------------------------------------------------------------------------------------------------------
+
+    inline bool JsonObject::Exists(const std::string_view& name) const {
+        return find(name) != end();
+    }
+
+    inline bool JsonObject::Exists(const std::string_view& name, JsonValueType type) const {
+        auto it = find(name);
+        if (it == end()) { return false; }
+        return it->second.Type() == type;
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+    //--------------------------------------------------------------------------------------------------------
+    //--------------------------------------------------------------------------------------------------------
+    
+    namespace detail {
+
+        // The widest instruction set the scanning kernels may use.  Only `Scalar` is available on targets
+        // other than x86-64, or when `CPPJSON_NO_SIMD` is defined.
+        enum class SimdLevel {
+            Scalar,
+            SSE2,
+            AVX2,
+            AVX512
+        };
+
+        //----------------------------------------------------------------------------------------------------
+
+        // Character classes for a 64-byte block, one bit per byte with bit 0 being the first byte.
+        struct BlockMasks {
+            uint64_t Quote;
+            uint64_t Backslash;
+            uint64_t Whitespace;
+            uint64_t Operator;      // One of {}[]:,
+        };
+
+        //----------------------------------------------------------------------------------------------------
+
+        // A set of scanning functions.  Each takes the `[first, last)` range to search and returns a
+        // pointer to the first matching character, or `last` if there is none.
+        struct ScanKernels {
+            // Finds the first character that is not JSON whitespace.
+            const char* (*SkipWhitespace)(const char* first, const char* last);
+            // Finds the first '"' or '\\'.
+            const char* (*FindQuoteOrEscape)(const char* first, const char* last);
+            // As `FindQuoteOrEscape`, but also checks that the characters before the match are valid UTF-8.
+            // Returns nullptr if they aren't, including when a multi-byte sequence is cut short by the match.
+            const char* (*FindQuoteOrEscapeUtf8)(const char* first, const char* last);
+            // Finds the first occurance of `c`.
+            const char* (*FindChar)(const char* first, const char* last, char c);
+            // Finds the first '\\', copying the characters before it to `out`.  Up to `last - first` bytes of
+            // `out` may be written.
+            const char* (*CopyUntilEscape)(const char* first, const char* last, char* out);
+            // Classifies the 64 bytes starting at `block`.
+            void (*ClassifyBlock)(const char* block, BlockMasks& masks);
+        };
+
+        //----------------------------------------------------------------------------------------------------
+
+        inline bool IsWhitespace(char c) {
+            return (c == ' ') || (c == '\r') || (c == '\n') || (c == '\t');
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        inline uint32_t CountTrailingZeros(uint64_t value) {
+#ifdef __GNUG__
+            return static_cast<uint32_t>(__builtin_ctzll(value));
+#elif defined(_MSC_VER)
+            unsigned long offset;
+            _BitScanForward64(&offset, value);
+            return static_cast<uint32_t>(offset);
+#else
+            uint32_t offset = 0;
+            while ((value & 1) == 0) {
+                value >>= 1;
+                ++offset;
+            }
+            return offset;
+#endif
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        // Returns the end of the multi-byte UTF-8 sequence starting at `first`, or nullptr if it is invalid.
+        // Overlong encodings, UTF-16 surrogates and code points above U+10FFFF are all invalid.
+        inline const char* SkipUtf8Sequence(const char* first, const char* last) {
+            auto lead = static_cast<uint8_t>(*first);
+            uint8_t second_min = 0x80;
+            uint8_t second_max = 0xBF;
+            ptrdiff_t length;
+            if (lead < 0xC2) {
+                // A continuation byte, or the lead of an overlong two byte sequence.
+                return nullptr;
+            } else if (lead < 0xE0) {
+                length = 2;
+            } else if (lead < 0xF0) {
+                length = 3;
+                if (lead == 0xE0) { second_min = 0xA0; }
+                if (lead == 0xED) { second_max = 0x9F; }
+            } else if (lead < 0xF5) {
+                length = 4;
+                if (lead == 0xF0) { second_min = 0x90; }
+                if (lead == 0xF4) { second_max = 0x8F; }
+            } else {
+                return nullptr;
+            }
+
+            if (last - first < length) { return nullptr; }
+            auto second = static_cast<uint8_t>(first[1]);
+            if (second < second_min || second > second_max) { return nullptr; }
+            for (ptrdiff_t i = 2; i < length; ++i) {
+                if ((static_cast<uint8_t>(first[i]) & 0xC0) != 0x80) { return nullptr; }
+            }
+            return first + length;
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        struct ScalarKernels {
+            static const char* SkipWhitespace(const char* first, const char* last) {
+                while (first < last && IsWhitespace(*first)) {
+                    ++first;
+                }
+                return (first < last) ? first : last;
+            }
+
+            static const char* FindQuoteOrEscape(const char* first, const char* last) {
+                for (; first < last; ++first) {
+                    if (*first == '"' || *first == '\\') {
+                        return first;
+                    }
+                }
+                return last;
+            }
+
+            static const char* FindQuoteOrEscapeUtf8(const char* first, const char* last) {
+                while (first < last) {
+                    char c = *first;
+                    if (c == '"' || c == '\\') {
+                        return first;
+                    }
+                    if (static_cast<uint8_t>(c) < 0x80) {
+                        ++first;
+                    } else {
+                        first = SkipUtf8Sequence(first, last);
+                        if (first == nullptr) { return nullptr; }
+                    }
+                }
+                return last;
+            }
+
+            static const char* FindChar(const char* first, const char* last, char c) {
+                for (; first < last; ++first) {
+                    if (*first == c) {
+                        return first;
+                    }
+                }
+                return last;
+            }
+
+            static const char* CopyUntilEscape(const char* first, const char* last, char* out) {
+                for (; first < last && *first != '\\'; ++first) {
+                    *out++ = *first;
+                }
+                return first;
+            }
+
+            static void ClassifyBlock(const char* block, BlockMasks& masks) {
+                masks = BlockMasks{};
+                for (uint32_t i = 0; i < 64; ++i) {
+                    uint64_t bit = uint64_t(1) << i;
+                    switch (block[i]) {
+                    case '"': masks.Quote |= bit; break;
+                    case '\\': masks.Backslash |= bit; break;
+
+                    case ' ':
+                    case '\r':
+                    case '\n':
+                    case '\t':
+                        masks.Whitespace |= bit;
+                        break;
+
+                    case '{':
+                    case '}':
+                    case '[':
+                    case ']':
+                    case ':':
+                    case ',':
+                        masks.Operator |= bit;
+                        break;
+
+                    default:
+                        break;
+                    }
+                }
+            }
+        };
+
+        //----------------------------------------------------------------------------------------------------
+
+#ifdef CPPJSON_SIMD_X64
+        struct SSE2Kernels {
+            static const char* SkipWhitespace(const char* first, const char* last) {
+                const __m128i SpaceChar128 = _mm_set1_epi8(' ');
+                const __m128i ReturnChar128 = _mm_set1_epi8('\r');
+                const __m128i LineFeedChar128 = _mm_set1_epi8('\n');
+                const __m128i TabChar128 = _mm_set1_epi8('\t');
+
+                while (last - first >= static_cast<ptrdiff_t>(sizeof(__m128i))) {
+                    __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+
+                    __m128i mask = _mm_cmpeq_epi8(chars, SpaceChar128);
+                    mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chars, ReturnChar128));
+                    mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chars, LineFeedChar128));
+                    mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chars, TabChar128));
+
+                    uint32_t bitmask = static_cast<uint16_t>(~_mm_movemask_epi8(mask));
+                    if (bitmask != 0) {
+                        return first + CountTrailingZeros(bitmask);
+                    }
+                    first += sizeof(__m128i);
+                }
+
+                // Plain loop for the <16 remaining chars.
+                return ScalarKernels::SkipWhitespace(first, last);
+            }
+
+            static const char* FindQuoteOrEscape(const char* first, const char* last) {
+                const __m128i QuoteChar128 = _mm_set1_epi8('"');
+                const __m128i EscapeChar128 = _mm_set1_epi8('\\');
+
+                while (last - first >= static_cast<ptrdiff_t>(sizeof(__m128i))) {
+                    __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+
+                    __m128i mask = _mm_or_si128(
+                        _mm_cmpeq_epi8(chars, QuoteChar128),
+                        _mm_cmpeq_epi8(chars, EscapeChar128)
+                    );
+
+                    uint32_t bitmask = static_cast<uint32_t>(_mm_movemask_epi8(mask));
+                    if (bitmask != 0) {
+                        return first + CountTrailingZeros(bitmask);
+                    }
+                    first += sizeof(__m128i);
+                }
+
+                return ScalarKernels::FindQuoteOrEscape(first, last);
+            }
+
+            // SSE2 has no byte shuffle for the table lookups of the AVX2 version, so this only skips ASCII
+            // a vector at a time and checks multi-byte sequences one by one.
+            static const char* FindQuoteOrEscapeUtf8(const char* first, const char* last) {
+                const __m128i QuoteChar128 = _mm_set1_epi8('"');
+                const __m128i EscapeChar128 = _mm_set1_epi8('\\');
+
+                while (last - first >= static_cast<ptrdiff_t>(sizeof(__m128i))) {
+                    __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+
+                    __m128i mask = _mm_or_si128(
+                        _mm_cmpeq_epi8(chars, QuoteChar128),
+                        _mm_cmpeq_epi8(chars, EscapeChar128)
+                    );
+
+                    uint32_t bitmask = static_cast<uint32_t>(_mm_movemask_epi8(mask));
+                    uint32_t non_ascii = static_cast<uint32_t>(_mm_movemask_epi8(chars));
+                    if (bitmask != 0) {
+                        // Only the characters before the match matter.
+                        non_ascii &= (bitmask & (0u - bitmask)) - 1;
+                    }
+
+                    if (non_ascii == 0) {
+                        if (bitmask != 0) {
+                            return first + CountTrailingZeros(bitmask);
+                        }
+                        first += sizeof(__m128i);
+                        continue;
+                    }
+
+                    // Check the rest of this vector one character at a time.  The last sequence may end in the
+                    // next vector.
+                    const char* vector_end = first + sizeof(__m128i);
+                    first += CountTrailingZeros(non_ascii);
+                    while (first < vector_end) {
+                        char c = *first;
+                        if (c == '"' || c == '\\') {
+                            return first;
+                        }
+                        if (static_cast<uint8_t>(c) < 0x80) {
+                            ++first;
+                        } else {
+                            first = SkipUtf8Sequence(first, last);
+                            if (first == nullptr) { return nullptr; }
+                        }
+                    }
+                }
+
+                return ScalarKernels::FindQuoteOrEscapeUtf8(first, last);
+            }
+
+            static const char* FindChar(const char* first, const char* last, char c) {
+                const __m128i Char128 = _mm_set1_epi8(c);
+
+                while (last - first >= static_cast<ptrdiff_t>(sizeof(__m128i))) {
+                    __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+
+                    uint32_t bitmask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chars, Char128)));
+                    if (bitmask != 0) {
+                        return first + CountTrailingZeros(bitmask);
+                    }
+                    first += sizeof(__m128i);
+                }
+
+                return ScalarKernels::FindChar(first, last, c);
+            }
+
+            static const char* CopyUntilEscape(const char* first, const char* last, char* out) {
+                const __m128i EscapeChar128 = _mm_set1_epi8('\\');
+
+                while (last - first >= static_cast<ptrdiff_t>(sizeof(__m128i))) {
+                    __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), chars);
+
+                    uint32_t bitmask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chars, EscapeChar128)));
+                    if (bitmask != 0) {
+                        return first + CountTrailingZeros(bitmask);
+                    }
+                    first += sizeof(__m128i);
+                    out += sizeof(__m128i);
+                }
+
+                return ScalarKernels::CopyUntilEscape(first, last, out);
+            }
+
+            static void ClassifyBlock(const char* block, BlockMasks& masks) {
+                masks = BlockMasks{};
+                for (uint32_t i = 0; i < 64; i += sizeof(__m128i)) {
+                    __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i));
+
+                    __m128i whitespace = _mm_or_si128(
+                        _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(chars, _mm_set1_epi8('\r'))),
+                        _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(chars, _mm_set1_epi8('\t')))
+                    );
+
+                    __m128i operators = _mm_or_si128(
+                        _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('[')), _mm_cmpeq_epi8(chars, _mm_set1_epi8(']'))),
+                        _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('{')), _mm_cmpeq_epi8(chars, _mm_set1_epi8('}')))
+                    );
+                    operators = _mm_or_si128(
+                        operators,
+                        _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8(':')), _mm_cmpeq_epi8(chars, _mm_set1_epi8(',')))
+                    );
+
+                    masks.Quote |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chars, _mm_set1_epi8('"'))))) << i;
+                    masks.Backslash |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chars, _mm_set1_epi8('\\'))))) << i;
+                    masks.Whitespace |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(whitespace))) << i;
+                    masks.Operator |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(operators))) << i;
+                }
+            }
+        };
+
+        //----------------------------------------------------------------------------------------------------
+
+        struct AVX2Kernels {
+            CPPJSON_TARGET_AVX2
+            static const char* SkipWhitespace(const char* first, const char* last) {
+                const __m256i SpaceChar256 = _mm256_set1_epi8(' ');
+                const __m256i ReturnChar256 = _mm256_set1_epi8('\r');
+                const __m256i LineFeedChar256 = _mm256_set1_epi8('\n');
+                const __m256i TabChar256 = _mm256_set1_epi8('\t');
+
+                while (last - first >= static_cast<ptrdiff_t>(sizeof(__m256i))) {
+                    __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+
+                    __m256i mask = _mm256_cmpeq_epi8(chars, SpaceChar256);
+                    mask = _mm256_or_si256(mask, _mm256_cmpeq_epi8(chars, ReturnChar256));
+                    mask = _mm256_or_si256(mask, _mm256_cmpeq_epi8(chars, LineFeedChar256));
+                    mask = _mm256_or_si256(mask, _mm256_cmpeq_epi8(chars, TabChar256));
+
+                    uint32_t bitmask = ~static_cast<uint32_t>(_mm256_movemask_epi8(mask));
+                    if (bitmask != 0) {
+                        return first + CountTrailingZeros(bitmask);
+                    }
+                    first += sizeof(__m256i);
+                }
+
+                // The <32 remaining chars are handled by the narrower kernel.
+                return SSE2Kernels::SkipWhitespace(first, last);
+            }
+
+            CPPJSON_TARGET_AVX2
+            static const char* FindQuoteOrEscape(const char* first, const char* last) {
+                const __m256i QuoteChar256 = _mm256_set1_epi8('"');
+                const __m256i EscapeChar256 = _mm256_set1_epi8('\\');
+
+                while (last - first >= static_cast<ptrdiff_t>(sizeof(__m256i))) {
+                    __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+
+                    __m256i mask = _mm256_or_si256(
+                        _mm256_cmpeq_epi8(chars, QuoteChar256),
+                        _mm256_cmpeq_epi8(chars, EscapeChar256)
+                    );
+
+                    uint32_t bitmask = static_cast<uint32_t>(_mm256_movemask_epi8(mask));
+                    if (bitmask != 0) {
+                        return first + CountTrailingZeros(bitmask);
+                    }
+                    first += sizeof(__m256i);
+                }
+
+                return SSE2Kernels::FindQuoteOrEscape(first, last);
+            }
+
+            CPPJSON_TARGET_AVX2
+            static const char* FindQuoteOrEscapeUtf8(const char* first, const char* last) {
+                const __m256i QuoteChar256 = _mm256_set1_epi8('"');
+                const __m256i EscapeChar256 = _mm256_set1_epi8('\\');
+                const __m256i Indices256 = _mm256_setr_epi8(
+                    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                    16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31
+                );
+
+                __m256i prev = _mm256_setzero_si256();
+                __m256i prev_incomplete = _mm256_setzero_si256();
+                __m256i errors = _mm256_setzero_si256();
+                for (;;) {
+                    __m256i chars;
+                    ptrdiff_t remaining = last - first;
+                    if (remaining >= static_cast<ptrdiff_t>(sizeof(__m256i))) {
+                        chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+                    } else {
+                        // Pad the final characters with zeros so they can be checked in one go.
+                        alignas(32) char tail[sizeof(__m256i)] = {};
+                        std::memcpy(tail, first, static_cast<size_t>(remaining));
+                        chars = _mm256_load_si256(reinterpret_cast<const __m256i*>(tail));
+                    }
+
+                    __m256i mask = _mm256_or_si256(
+                        _mm256_cmpeq_epi8(chars, QuoteChar256),
+                        _mm256_cmpeq_epi8(chars, EscapeChar256)
+                    );
+
+                    uint32_t bitmask = static_cast<uint32_t>(_mm256_movemask_epi8(mask));
+                    if (remaining < static_cast<ptrdiff_t>(sizeof(__m256i))) {
+                        // The end of the input stops the search like a match.
+                        bitmask |= uint32_t(1) << remaining;
+                    }
+                    if (bitmask != 0) {
+                        // Zero the match and everything after it, so that a sequence it cuts short is found
+                        // to be too short.
+                        auto offset = static_cast<char>(CountTrailingZeros(bitmask));
+                        chars = _mm256_and_si256(chars, _mm256_cmpgt_epi8(_mm256_set1_epi8(offset), Indices256));
+                    }
+
+                    if (_mm256_movemask_epi8(chars) == 0) {
+                        errors = _mm256_or_si256(errors, prev_incomplete);
+                        prev_incomplete = _mm256_setzero_si256();
+                    } else {
+                        errors = _mm256_or_si256(errors, FindUtf8Errors(chars, prev));
+                        prev_incomplete = FindIncompleteUtf8(chars);
+                    }
+
+                    if (bitmask != 0) {
+                        if (!_mm256_testz_si256(errors, errors)) { return nullptr; }
+                        return first + CountTrailingZeros(bitmask);
+                    }
+                    prev = chars;
+                    first += sizeof(__m256i);
+                }
+            }
+
+            // The lookup algorithm from Keiser and Lemire, "Validating UTF-8 In Less Than One Instruction Per
+            // Byte".  Each byte is classified by the high nibble of the character before it, the low nibble of
+            // the character before it and its own high nibble; an error is any bit set in all three.  Returns a
+            // vector that is non-zero for any error in `chars`, where `prev` holds the preceding 32 characters.
+            CPPJSON_TARGET_AVX2
+            static __m256i FindUtf8Errors(__m256i chars, __m256i prev) {
+                constexpr uint8_t TooShort = 1 << 0;        // 11______ 0_______
+                constexpr uint8_t TooLong = 1 << 1;         // 0_______ 10______
+                constexpr uint8_t Overlong3 = 1 << 2;       // 11100000 100_____
+                constexpr uint8_t TooLarge = 1 << 3;        // 11110100 1001____
+                constexpr uint8_t Surrogate = 1 << 4;       // 11101101 101_____
+                constexpr uint8_t Overlong2 = 1 << 5;       // 1100000_ 10______
+                constexpr uint8_t TooLarge1000 = 1 << 6;    // 11110101 1000____
+                constexpr uint8_t Overlong4 = 1 << 6;       // 11110000 1000____
+                constexpr uint8_t TwoConts = 1 << 7;        // 10______ 10______
+                constexpr uint8_t Carry = TooShort | TooLong | TwoConts;
+
+                alignas(16) static const uint8_t Byte1High[16] = {
+                    TooLong, TooLong, TooLong, TooLong, TooLong, TooLong, TooLong, TooLong,
+                    TwoConts, TwoConts, TwoConts, TwoConts,
+                    TooShort | Overlong2,
+                    TooShort,
+                    TooShort | Overlong3 | Surrogate,
+                    TooShort | TooLarge | TooLarge1000 | Overlong4
+                };
+                alignas(16) static const uint8_t Byte1Low[16] = {
+                    Carry | Overlong3 | Overlong2 | Overlong4,
+                    Carry | Overlong2,
+                    Carry,
+                    Carry,
+                    Carry | TooLarge,
+                    Carry | TooLarge | TooLarge1000,
+                    Carry | TooLarge | TooLarge1000,
+                    Carry | TooLarge | TooLarge1000,
+                    Carry | TooLarge | TooLarge1000,
+                    Carry | TooLarge | TooLarge1000,
+                    Carry | TooLarge | TooLarge1000,
+                    Carry | TooLarge | TooLarge1000,
+                    Carry | TooLarge | TooLarge1000,
+                    Carry | TooLarge | TooLarge1000 | Surrogate,
+                    Carry | TooLarge | TooLarge1000,
+                    Carry | TooLarge | TooLarge1000
+                };
+                alignas(16) static const uint8_t Byte2High[16] = {
+                    TooShort, TooShort, TooShort, TooShort, TooShort, TooShort, TooShort, TooShort,
+                    TooLong | Overlong2 | TwoConts | Overlong3 | TooLarge1000 | Overlong4,
+                    TooLong | Overlong2 | TwoConts | Overlong3 | TooLarge,
+                    TooLong | Overlong2 | TwoConts | Surrogate | TooLarge,
+                    TooLong | Overlong2 | TwoConts | Surrogate | TooLarge,
+                    TooShort, TooShort, TooShort, TooShort
+                };
+
+                const __m256i LowNibble256 = _mm256_set1_epi8(0x0F);
+                // The characters one, two and three places earlier.
+                __m256i prev_shifted = _mm256_permute2x128_si256(prev, chars, 0x21);
+                __m256i prev1 = _mm256_alignr_epi8(chars, prev_shifted, 15);
+                __m256i prev2 = _mm256_alignr_epi8(chars, prev_shifted, 14);
+                __m256i prev3 = _mm256_alignr_epi8(chars, prev_shifted, 13);
+
+                __m256i special_cases = _mm256_and_si256(
+                    _mm256_and_si256(
+                        Lookup16(Byte1High, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), LowNibble256)),
+                        Lookup16(Byte1Low, _mm256_and_si256(prev1, LowNibble256))
+                    ),
+                    Lookup16(Byte2High, _mm256_and_si256(_mm256_srli_epi16(chars, 4), LowNibble256))
+                );
+
+                // The third and fourth bytes of a sequence are reported above as two continuations in a row,
+                // which flips that error off where it is expected.
+                __m256i is_third = _mm256_subs_epu8(prev2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+                __m256i is_fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+                __m256i must_continue = _mm256_and_si256(
+                    _mm256_or_si256(is_third, is_fourth),
+                    _mm256_set1_epi8(static_cast<char>(0x80))
+                );
+                return _mm256_xor_si256(must_continue, special_cases);
+            }
+
+            // Looks up each byte of `index`, which must be less than 16, in `table`.
+            CPPJSON_TARGET_AVX2
+            static __m256i Lookup16(const uint8_t* table, __m256i index) {
+                __m256i entries = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(table)));
+                return _mm256_shuffle_epi8(entries, index);
+            }
+
+            // Returns a vector that is non-zero if the end of `chars` is part way through a sequence.
+            CPPJSON_TARGET_AVX2
+            static __m256i FindIncompleteUtf8(__m256i chars) {
+                const __m256i MaxComplete256 = _mm256_setr_epi8(
+                    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                    static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1)
+                );
+                return _mm256_subs_epu8(chars, MaxComplete256);
+            }
+
+            CPPJSON_TARGET_AVX2
+            static const char* FindChar(const char* first, const char* last, char c) {
+                const __m256i Char256 = _mm256_set1_epi8(c);
+
+                while (last - first >= static_cast<ptrdiff_t>(sizeof(__m256i))) {
+                    __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+
+                    uint32_t bitmask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chars, Char256)));
+                    if (bitmask != 0) {
+                        return first + CountTrailingZeros(bitmask);
+                    }
+                    first += sizeof(__m256i);
+                }
+
+                return SSE2Kernels::FindChar(first, last, c);
+            }
+
+            CPPJSON_TARGET_AVX2
+            static const char* CopyUntilEscape(const char* first, const char* last, char* out) {
+                const __m256i EscapeChar256 = _mm256_set1_epi8('\\');
+
+                while (last - first >= static_cast<ptrdiff_t>(sizeof(__m256i))) {
+                    __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), chars);
+
+                    uint32_t bitmask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chars, EscapeChar256)));
+                    if (bitmask != 0) {
+                        return first + CountTrailingZeros(bitmask);
+                    }
+                    first += sizeof(__m256i);
+                    out += sizeof(__m256i);
+                }
+
+                return SSE2Kernels::CopyUntilEscape(first, last, out);
+            }
+
+            CPPJSON_TARGET_AVX2
+            static void ClassifyBlock(const char* block, BlockMasks& masks) {
+                masks = BlockMasks{};
+                for (uint32_t i = 0; i < 64; i += sizeof(__m256i)) {
+                    __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + i));
+
+                    __m256i whitespace = _mm256_or_si256(
+                        _mm256_or_si256(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('\r'))),
+                        _mm256_or_si256(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8('\n')), _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('\t')))
+                    );
+
+                    __m256i operators = _mm256_or_si256(
+                        _mm256_or_si256(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8('[')), _mm256_cmpeq_epi8(chars, _mm256_set1_epi8(']'))),
+                        _mm256_or_si256(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8('{')), _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('}')))
+                    );
+                    operators = _mm256_or_si256(
+                        operators,
+                        _mm256_or_si256(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8(':')), _mm256_cmpeq_epi8(chars, _mm256_set1_epi8(',')))
+                    );
+
+                    masks.Quote |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8('"'))))) << i;
+                    masks.Backslash |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8('\\'))))) << i;
+                    masks.Whitespace |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(whitespace))) << i;
+                    masks.Operator |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(operators))) << i;
+                }
+            }
+        };
+
+        //----------------------------------------------------------------------------------------------------
+
+        struct AVX512Kernels {
+            CPPJSON_TARGET_AVX512
+            static const char* SkipWhitespace(const char* first, const char* last) {
+                const __m512i SpaceChar512 = _mm512_set1_epi8(' ');
+                const __m512i ReturnChar512 = _mm512_set1_epi8('\r');
+                const __m512i LineFeedChar512 = _mm512_set1_epi8('\n');
+                const __m512i TabChar512 = _mm512_set1_epi8('\t');
+
+                while (last - first >= static_cast<ptrdiff_t>(sizeof(__m512i))) {
+                    __m512i chars = _mm512_loadu_si512(first);
+
+                    uint64_t bitmask = _mm512_cmpeq_epi8_mask(chars, SpaceChar512)
+                        | _mm512_cmpeq_epi8_mask(chars, ReturnChar512)
+                        | _mm512_cmpeq_epi8_mask(chars, LineFeedChar512)
+                        | _mm512_cmpeq_epi8_mask(chars, TabChar512);
+                    bitmask = ~bitmask;
+                    if (bitmask != 0) {
+                        return first + CountTrailingZeros(bitmask);
+                    }
+                    first += sizeof(__m512i);
+                }
+
+                // The <64 remaining chars are handled by the narrower kernel.
+                return AVX2Kernels::SkipWhitespace(first, last);
+            }
+
+            CPPJSON_TARGET_AVX512
+            static const char* FindQuoteOrEscape(const char* first, const char* last) {
+                const __m512i QuoteChar512 = _mm512_set1_epi8('"');
+                const __m512i EscapeChar512 = _mm512_set1_epi8('\\');
+
+                while (last - first >= static_cast<ptrdiff_t>(sizeof(__m512i))) {
+                    __m512i chars = _mm512_loadu_si512(first);
+
+                    uint64_t bitmask = _mm512_cmpeq_epi8_mask(chars, QuoteChar512)
+                        | _mm512_cmpeq_epi8_mask(chars, EscapeChar512);
+                    if (bitmask != 0) {
+                        return first + CountTrailingZeros(bitmask);
+                    }
+                    first += sizeof(__m512i);
+                }
+
+                return AVX2Kernels::FindQuoteOrEscape(first, last);
+            }
+
+            CPPJSON_TARGET_AVX512
+            static const char* FindChar(const char* first, const char* last, char c) {
+                const __m512i Char512 = _mm512_set1_epi8(c);
+
+                while (last - first >= static_cast<ptrdiff_t>(sizeof(__m512i))) {
+                    __m512i chars = _mm512_loadu_si512(first);
+
+                    uint64_t bitmask = _mm512_cmpeq_epi8_mask(chars, Char512);
+                    if (bitmask != 0) {
+                        return first + CountTrailingZeros(bitmask);
+                    }
+                    first += sizeof(__m512i);
+                }
+
+                return AVX2Kernels::FindChar(first, last, c);
+            }
+
+            CPPJSON_TARGET_AVX512
+            static const char* CopyUntilEscape(const char* first, const char* last, char* out) {
+                const __m512i EscapeChar512 = _mm512_set1_epi8('\\');
+
+                while (last - first >= static_cast<ptrdiff_t>(sizeof(__m512i))) {
+                    __m512i chars = _mm512_loadu_si512(first);
+                    _mm512_storeu_si512(out, chars);
+
+                    uint64_t bitmask = _mm512_cmpeq_epi8_mask(chars, EscapeChar512);
+                    if (bitmask != 0) {
+                        return first + CountTrailingZeros(bitmask);
+                    }
+                    first += sizeof(__m512i);
+                    out += sizeof(__m512i);
+                }
+
+                return AVX2Kernels::CopyUntilEscape(first, last, out);
+            }
+
+            CPPJSON_TARGET_AVX512
+            static void ClassifyBlock(const char* block, BlockMasks& masks) {
+                __m512i chars = _mm512_loadu_si512(block);
+
+                masks.Quote = _mm512_cmpeq_epi8_mask(chars, _mm512_set1_epi8('"'));
+                masks.Backslash = _mm512_cmpeq_epi8_mask(chars, _mm512_set1_epi8('\\'));
+                masks.Whitespace = _mm512_cmpeq_epi8_mask(chars, _mm512_set1_epi8(' '))
+                    | _mm512_cmpeq_epi8_mask(chars, _mm512_set1_epi8('\r'))
+                    | _mm512_cmpeq_epi8_mask(chars, _mm512_set1_epi8('\n'))
+                    | _mm512_cmpeq_epi8_mask(chars, _mm512_set1_epi8('\t'));
+                masks.Operator = _mm512_cmpeq_epi8_mask(chars, _mm512_set1_epi8('['))
+                    | _mm512_cmpeq_epi8_mask(chars, _mm512_set1_epi8(']'))
+                    | _mm512_cmpeq_epi8_mask(chars, _mm512_set1_epi8('{'))
+                    | _mm512_cmpeq_epi8_mask(chars, _mm512_set1_epi8('}'))
+                    | _mm512_cmpeq_epi8_mask(chars, _mm512_set1_epi8(':'))
+                    | _mm512_cmpeq_epi8_mask(chars, _mm512_set1_epi8(','));
+            }
+        };
+
+        //----------------------------------------------------------------------------------------------------
+
+        inline SimdLevel DetectSimdLevel() {
+#ifdef __GNUG__
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+                return SimdLevel::AVX512;
+            }
+            if (__builtin_cpu_supports("avx2")) {
+                return SimdLevel::AVX2;
+            }
+            return SimdLevel::SSE2;
+#endif
+#ifdef _MSC_VER
+            int regs[4];
+            __cpuid(regs, 0);
+            if (regs[0] < 7) { return SimdLevel::SSE2; }
+
+            // The OS must save the YMM (and ZMM) registers on a context switch.
+            __cpuid(regs, 1);
+            bool has_osxsave = (regs[2] & (1 << 27)) != 0;
+            if (!has_osxsave) { return SimdLevel::SSE2; }
+            unsigned long long xcr0 = _xgetbv(0);
+
+            __cpuidex(regs, 7, 0);
+            bool has_avx2 = (regs[1] & (1 << 5)) != 0;
+            bool has_avx512 = ((regs[1] & (1 << 16)) != 0) && ((regs[1] & (1 << 30)) != 0);
+
+            if (has_avx512 && (xcr0 & 0xE6) == 0xE6) {
+                return SimdLevel::AVX512;
+            }
+            if (has_avx2 && (xcr0 & 0x6) == 0x6) {
+                return SimdLevel::AVX2;
+            }
+            return SimdLevel::SSE2;
+#endif
+        }
+#endif
+
+        //----------------------------------------------------------------------------------------------------
+
+        // Returns the kernels for the given level, or the scalar kernels if the level is not compiled in.
+        inline const ScanKernels& GetScanKernels(SimdLevel level) {
+            static const ScanKernels s_scalar{
+                &ScalarKernels::SkipWhitespace,
+                &ScalarKernels::FindQuoteOrEscape,
+                &ScalarKernels::FindQuoteOrEscapeUtf8,
+                &ScalarKernels::FindChar,
+                &ScalarKernels::CopyUntilEscape,
+                &ScalarKernels::ClassifyBlock
+            };
+
+#ifdef CPPJSON_SIMD_X64
+            static const ScanKernels s_sse2{
+                &SSE2Kernels::SkipWhitespace,
+                &SSE2Kernels::FindQuoteOrEscape,
+                &SSE2Kernels::FindQuoteOrEscapeUtf8,
+                &SSE2Kernels::FindChar,
+                &SSE2Kernels::CopyUntilEscape,
+                &SSE2Kernels::ClassifyBlock
+            };
+            static const ScanKernels s_avx2{
+                &AVX2Kernels::SkipWhitespace,
+                &AVX2Kernels::FindQuoteOrEscape,
+                &AVX2Kernels::FindQuoteOrEscapeUtf8,
+                &AVX2Kernels::FindChar,
+                &AVX2Kernels::CopyUntilEscape,
+                &AVX2Kernels::ClassifyBlock
+            };
+            static const ScanKernels s_avx512{
+                &AVX512Kernels::SkipWhitespace,
+                &AVX512Kernels::FindQuoteOrEscape,
+                &AVX2Kernels::FindQuoteOrEscapeUtf8,      // There's no AVX-512 version.
+                &AVX512Kernels::FindChar,
+                &AVX512Kernels::CopyUntilEscape,
+                &AVX512Kernels::ClassifyBlock
+            };
+
+            switch (level) {
+            case SimdLevel::SSE2: return s_sse2;
+            case SimdLevel::AVX2: return s_avx2;
+            case SimdLevel::AVX512: return s_avx512;
+            case SimdLevel::Scalar:
+            default:
+                break;
+            }
+#else
+            (void)level;
+#endif
+            return s_scalar;
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        // The best level supported by both the build and the CPU, detected once on first use.
+        inline SimdLevel ActiveSimdLevel() {
+#ifdef CPPJSON_SIMD_X64
+            static const SimdLevel s_level = DetectSimdLevel();
+            return s_level;
+#else
+            return SimdLevel::Scalar;
+#endif
+        }
+
+        inline const ScanKernels& ActiveScanKernels() {
+            static const ScanKernels& s_kernels = GetScanKernels(ActiveSimdLevel());
+            return s_kernels;
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        // Finds the characters that are escaped by a backslash, accounting for runs of backslashes.
+        inline uint64_t FindEscaped(uint64_t backslash, uint64_t& prev_escaped) {
+            if (backslash == 0) {
+                uint64_t escaped = prev_escaped;
+                prev_escaped = 0;
+                return escaped;
+            }
+
+            const uint64_t EvenBits = 0x5555555555555555ull;
+
+            // A backslash that is itself escaped does not start an escape sequence.
+            backslash &= ~prev_escaped;
+            uint64_t follows_escape = (backslash << 1) | prev_escaped;
+
+            // Adding the starts of odd-positioned runs to the backslashes carries each run to the
+            // character after it, flipping which alternating bits of the run are escaped.
+            uint64_t odd_sequence_starts = backslash & ~EvenBits & ~follows_escape;
+            uint64_t sequences_starting_on_even_bits = odd_sequence_starts + backslash;
+            prev_escaped = (sequences_starting_on_even_bits < backslash) ? 1 : 0;
+
+            uint64_t invert_mask = sequences_starting_on_even_bits << 1;
+            return (EvenBits ^ invert_mask) & follows_escape;
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        // Sets each bit to the parity of the bits at or below it.
+        inline uint64_t PrefixXor(uint64_t bits) {
+            bits ^= bits << 1;
+            bits ^= bits << 2;
+            bits ^= bits << 4;
+            bits ^= bits << 8;
+            bits ^= bits << 16;
+            bits ^= bits << 32;
+            return bits;
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        // Stage 1 of the indexed parser.  Records the offset of every character the second stage needs to
+        // visit: operators and quotes outside of strings, and the first character of each literal or
+        // number.  The offsets are followed by an end marker equal to the size of the data.  The storage
+        // is kept between calls to `Build()`.
+        class StructuralIndex {
+        public:
+            // The offsets are 32 bits, so only data smaller than 4 GiB (less a block) can be indexed.
+            static constexpr bool CanIndex(size_t size) noexcept {
+                return size < std::numeric_limits<uint32_t>::max() - 64;
+            }
+
+            // Returns false, leaving the index empty, if the data is too large to index or ends within a string.
+            bool Build(std::string_view data) {
+                m_count = 0;
+                if (!CanIndex(data.size())) { return false; }
+
+                // Every byte may be structural, and each block may write up to 64 offsets.
+                size_t required = data.size() + 64 + 1;
+                if (m_capacity < required) {
+                    m_offsets.reset(new uint32_t[required]);
+                    m_capacity = required;
+                }
+
+                auto& kernels = ActiveScanKernels();
+                Carry carry{};
+                BlockMasks masks;
+                uint32_t* out = m_offsets.get();
+
+                const char* block = data.data();
+                size_t full_blocks = data.size() / 64;
+                for (size_t i = 0; i < full_blocks; ++i, block += 64) {
+                    kernels.ClassifyBlock(block, masks);
+                    out = AppendBlock(out, static_cast<uint32_t>(i * 64), masks, carry);
+                }
+
+                size_t tail_length = data.size() % 64;
+                if (tail_length != 0) {
+                    // Pad the final block with whitespace so it classifies as nothing.
+                    char tail[64];
+                    std::memset(tail, ' ', sizeof(tail));
+                    std::memcpy(tail, block, tail_length);
+                    kernels.ClassifyBlock(tail, masks);
+                    out = AppendBlock(out, static_cast<uint32_t>(full_blocks * 64), masks, carry);
+                }
+
+                // An unterminated string leaves us inside a string.
+                if (carry.InString != 0) { return false; }
+
+                *out = static_cast<uint32_t>(data.size());
+                m_count = static_cast<size_t>(out - m_offsets.get());
+                return true;
+            }
+
+            // The structural offsets, excluding the end marker.
+            const uint32_t* begin() const { return m_offsets.get(); }
+            const uint32_t* end() const { return m_offsets.get() + m_count; }
+            size_t size() const { return m_count; }
+
+        private:
+            std::unique_ptr<uint32_t[]> m_offsets;
+            size_t m_capacity = 0;
+            size_t m_count = 0;
+
+            //------------------------------------------------------------------------------------------------
+
+            // State carried from one block to the next.
+            struct Carry {
+                uint64_t Escaped;       // 1 if the first byte of the next block is escaped.
+                uint64_t InString;      // All ones if the next block starts inside a string.
+                uint64_t Scalar;        // 1 if the last byte of the previous block was part of a literal.
+            };
+
+            //------------------------------------------------------------------------------------------------
+
+            static uint32_t* AppendBlock(uint32_t* out, uint32_t offset, const BlockMasks& masks, Carry& carry) {
+                uint64_t escaped = FindEscaped(masks.Backslash, carry.Escaped);
+                uint64_t quotes = masks.Quote & ~escaped;
+
+                // Each bit is set from an opening quote up to, but excluding, its closing quote.
+                uint64_t in_string = PrefixXor(quotes) ^ carry.InString;
+                carry.InString = static_cast<uint64_t>(static_cast<int64_t>(in_string) >> 63);
+
+                // Literals and numbers are everything else outside of strings.  Only the first character of
+                // each run is needed.
+                uint64_t scalar = ~(masks.Operator | masks.Whitespace | quotes | in_string);
+                uint64_t scalar_start = scalar & ~((scalar << 1) | carry.Scalar);
+                carry.Scalar = scalar >> 63;
+
+                uint64_t structurals = (masks.Operator & ~in_string) | quotes | scalar_start;
+                while (structurals != 0) {
+                    *out++ = offset + CountTrailingZeros(structurals);
+                    structurals &= structurals - 1;
+                }
+                return out;
+            }
+
+        };
+
+        //----------------------------------------------------------------------------------------------------
+
+        // Counts the elements of each array in `data` from its structural index, in the order that the arrays
+        // start.  The counts are only meaningful if the document is valid.
+        inline void CountArrayElements(const char* data, const StructuralIndex& index, std::vector<uint32_t>& counts) {
+            constexpr uint32_t Object = std::numeric_limits<uint32_t>::max();
+
+            // The index of the count for each open array, or `Object`.
+            std::vector<uint32_t> open;
+            counts.clear();
+
+            char previous = 0;
+            for (uint32_t offset : index) {
+                char c = data[offset];
+                switch (c) {
+                case '[':
+                    open.push_back(static_cast<uint32_t>(counts.size()));
+                    counts.push_back(0);
+                    break;
+                case '{':
+                    open.push_back(Object);
+                    break;
+                case ',':
+                    if (!open.empty() && open.back() != Object) { ++counts[open.back()]; }
+                    break;
+                case ']':
+                case '}':
+                    if (open.empty()) { return; }
+                    // Commas separate the elements, so a non-empty array has one more.
+                    if (open.back() != Object && previous != '[') { ++counts[open.back()]; }
+                    open.pop_back();
+                    break;
+                default:
+                    break;
+                }
+                previous = c;
+            }
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        // Finds the end of the array or object that starts with the bracket at `open`, without tokenizing its
+        // contents.  Brackets are counted in 64-byte blocks, ignoring those inside strings as the structural
+        // index does.  Returns the character after the closing bracket, or nullptr if the data ends first or
+        // the closing bracket doesn't match.
+        inline const char* FindContainerEnd(const char* open, const char* end, const ScanKernels& kernels) {
+            constexpr size_t BlockSize = 64;
+            size_t depth = 0;
+            uint64_t prev_escaped = 0;
+            uint64_t prev_in_string = 0;
+            char tail[BlockSize];
+
+            const char* position = open;
+            while (position < end) {
+                const char* block = position;
+                size_t length = std::min<size_t>(BlockSize, static_cast<size_t>(end - position));
+                position = block + length;
+
+                BlockMasks masks;
+                if (length == BlockSize) {
+                    kernels.ClassifyBlock(block, masks);
+                } else {
+                    std::memset(tail, ' ', BlockSize);
+                    std::memcpy(tail, block, length);
+                    kernels.ClassifyBlock(tail, masks);
+                }
+
+                uint64_t escaped = FindEscaped(masks.Backslash, prev_escaped);
+                uint64_t in_string = PrefixXor(masks.Quote & ~escaped) ^ prev_in_string;
+                prev_in_string = static_cast<uint64_t>(static_cast<int64_t>(in_string) >> 63);
+
+                uint64_t operators = masks.Operator & ~in_string;
+                while (operators != 0) {
+                    const char* c = block + CountTrailingZeros(operators);
+                    operators &= operators - 1;
+
+                    if (*c == '[' || *c == '{') {
+                        ++depth;
+                    } else if (*c == ']' || *c == '}') {
+                        if (--depth == 0) {
+                            char close = (*open == '[') ? ']' : '}';
+                            return (*c == close) ? c + 1 : nullptr;
+                        }
+                    }
+                }
+            }
+
+            return nullptr;
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        // Reads four hex digits.
+        inline bool ParseHex4(const char* digits, uint32_t& value) {
+            value = 0;
+            for (int i = 0; i < 4; ++i) {
+                char c = digits[i];
+                uint32_t digit;
+                if (c >= '0' && c <= '9') {
+                    digit = static_cast<uint32_t>(c - '0');
+                } else if ((c | 0x20) >= 'a' && (c | 0x20) <= 'f') {
+                    digit = static_cast<uint32_t>((c | 0x20) - 'a' + 10);
+                } else {
+                    return false;
+                }
+                value = (value << 4) | digit;
+            }
+            return true;
+        }
+
+        inline char* AppendUtf8(char* out, uint32_t code_point) {
+            if (code_point < 0x80) {
+                *out++ = static_cast<char>(code_point);
+            } else if (code_point < 0x800) {
+                *out++ = static_cast<char>(0xC0 | (code_point >> 6));
+                *out++ = static_cast<char>(0x80 | (code_point & 0x3F));
+            } else if (code_point < 0x10000) {
+                *out++ = static_cast<char>(0xE0 | (code_point >> 12));
+                *out++ = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+                *out++ = static_cast<char>(0x80 | (code_point & 0x3F));
+            } else {
+                *out++ = static_cast<char>(0xF0 | (code_point >> 18));
+                *out++ = static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+                *out++ = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+                *out++ = static_cast<char>(0x80 | (code_point & 0x3F));
+            }
+            return out;
+        }
+
+        // Decodes the escape sequences in the string contents `value` into `scratch`, and points `value` at
+        // the result.  Returns false if an escape sequence is invalid, including a UTF-16 surrogate that isn't
+        // part of a pair.
+        inline bool UnescapeString(std::string_view& value, std::string& scratch, const ScanKernels& kernels) {
+            // Escape sequences never decode to more characters than they take up.
+            if (scratch.size() < value.size()) {
+                scratch.resize(value.size());
+            }
+
+            const char* first = value.data();
+            const char* last = first + value.size();
+            char* out = scratch.data();
+            for (;;) {
+                auto escape = kernels.CopyUntilEscape(first, last, out);
+                out += escape - first;
+                first = escape;
+                if (first == last) { break; }
+
+                if (last - first < 2) { return false; }
+                char c = first[1];
+                first += 2;
+                switch (c) {
+                case '"':  *out++ = '"'; break;
+                case '\\': *out++ = '\\'; break;
+                case '/':  *out++ = '/'; break;
+                case 'b':  *out++ = '\b'; break;
+                case 'f':  *out++ = '\f'; break;
+                case 'n':  *out++ = '\n'; break;
+                case 'r':  *out++ = '\r'; break;
+                case 't':  *out++ = '\t'; break;
+
+                case 'u': {
+                    uint32_t code_point;
+                    if (last - first < 4 || !ParseHex4(first, code_point)) { return false; }
+                    first += 4;
+
+                    if (code_point >= 0xD800 && code_point < 0xDC00) {
+                        // A high surrogate must be followed by an escaped low surrogate.
+                        uint32_t low;
+                        if (last - first < 6 || first[0] != '\\' || first[1] != 'u' || !ParseHex4(first + 2, low)) {
+                            return false;
+                        }
+                        if (low < 0xDC00 || low >= 0xE000) { return false; }
+                        first += 6;
+                        code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+                    } else if (code_point >= 0xDC00 && code_point < 0xE000) {
+                        return false;
+                    }
+                    out = AppendUtf8(out, code_point);
+                    break;
+                }
+
+                default:
+                    return false;
+                }
+            }
+
+            value = std::string_view(scratch.data(), static_cast<size_t>(out - scratch.data()));
+            return true;
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        // SWAR helpers for decimal digits.  `chunk` holds eight characters loaded in memory order on a little
+        // endian machine, so the first character is in the low byte.
+        inline bool IsEightDigits(uint64_t chunk) {
+            // A byte is in '0'..'9' iff neither adding 0x46 nor subtracting 0x30 sets its top bit.
+            return (((chunk + 0x4646464646464646) | (chunk - 0x3030303030303030)) & 0x8080808080808080) == 0;
+        }
+
+        inline uint32_t ParseEightDigits(uint64_t chunk) {
+            // Combine adjacent digits into 2-digit, then 4-digit, then 8-digit values with three multiplies.
+            constexpr uint64_t Mask = 0x000000FF000000FF;
+            constexpr uint64_t Multiplier1 = 100 + (uint64_t(1000000) << 32);
+            constexpr uint64_t Multiplier2 = 1 + (uint64_t(10000) << 32);
+            chunk -= 0x3030303030303030;
+            chunk = (chunk * 10) + (chunk >> 8);
+            chunk = (((chunk & Mask) * Multiplier1) + (((chunk >> 16) & Mask) * Multiplier2)) >> 32;
+            return static_cast<uint32_t>(chunk);
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        // Correctly rounded conversion of a decimal `mantissa * 10^exponent` to a double, using the
+        // Eisel-Lemire algorithm.  Conversions it cannot prove correct are reported as failed so that the
+        // caller can fall back to an exact conversion of the original text.
+        class DecimalToDouble {
+        public:
+            static bool Convert(uint64_t mantissa, int64_t exponent, bool is_negative, double& value) {
+                // Clinger's fast path: both the mantissa and the power of ten are exact doubles, so a single
+                // IEEE multiplication or division is correctly rounded.
+                if (exponent >= -22 && exponent <= 22 && mantissa <= MaxExactMantissa) {
+                    value = static_cast<double>(mantissa);
+                    if (exponent < 0) {
+                        value /= PowersOfTen[-exponent];
+                    } else {
+                        value *= PowersOfTen[exponent];
+                    }
+                    if (is_negative) { value = -value; }
+                    return true;
+                }
+
+                if (mantissa == 0 || exponent < SmallestPower) {
+                    value = is_negative ? -0.0 : 0.0;
+                    return true;
+                }
+                if (exponent > LargestPower) {
+                    value = is_negative ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+                    return true;
+                }
+
+                // Binary exponent of 10^exponent, rounded down, plus the bias and the width of the product.
+                int64_t binary_exponent = (((152170 + 65536) * exponent) >> 16) + 1024 + 63;
+                int32_t leading_zeros = CountLeadingZeros(mantissa);
+                mantissa <<= leading_zeros;
+
+                // Both factors have their top bit set, so the product has at most one leading zero.  Unless the
+                // bottom 9 bits of the high word are all set the truncation error of the table can't carry into
+                // the bits we keep.
+                auto index = static_cast<size_t>(2 * (exponent - SmallestPower));
+                uint64_t lower;
+                uint64_t upper = Multiply(mantissa, PowersOfFive[index], lower);
+                if ((upper & 0x1FF) == 0x1FF) {
+                    uint64_t second_lower;
+                    uint64_t second_upper = Multiply(mantissa, PowersOfFive[index + 1], second_lower);
+                    lower += second_upper;
+                    if (second_upper > lower) { ++upper; }
+                    if (lower == std::numeric_limits<uint64_t>::max()) {
+                        return false;
+                    }
+                }
+
+                // Keep 54 bits: the 53 bit significand plus a rounding bit.
+                uint64_t upper_bit = upper >> 63;
+                uint64_t significand = upper >> (upper_bit + 9);
+                leading_zeros += static_cast<int32_t>(1 ^ upper_bit);
+
+                int64_t real_exponent = binary_exponent - leading_zeros;
+                if (real_exponent <= 0) {
+                    // Subnormal.  Round-to-even ties can't occur this far from 10^0.
+                    if (-real_exponent + 1 >= 64) {
+                        value = is_negative ? -0.0 : 0.0;
+                        return true;
+                    }
+                    significand >>= -real_exponent + 1;
+                    significand += significand & 1;
+                    significand >>= 1;
+                    real_exponent = (significand < (uint64_t(1) << 52)) ? 0 : 1;
+                    value = MakeDouble(significand, real_exponent, is_negative);
+                    return true;
+                }
+
+                // An exact tie between two doubles is only possible for small exponents, in which case the
+                // product is exact and a set rounding bit with nothing below it must round to even.
+                if (lower <= 1 && exponent >= -4 && exponent <= 23 && (significand & 3) == 1) {
+                    if ((significand << (upper_bit + 9)) == upper) {
+                        significand &= ~uint64_t(1);
+                    }
+                }
+
+                significand += significand & 1;
+                significand >>= 1;
+                if (significand >= (uint64_t(1) << 53)) {
+                    // Rounding carried into a new bit.
+                    significand = uint64_t(1) << 52;
+                    ++real_exponent;
+                }
+                significand &= ~(uint64_t(1) << 52);
+
+                if (real_exponent > 2046) {
+                    value = is_negative ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+                    return true;
+                }
+
+                value = MakeDouble(significand, real_exponent, is_negative);
+                return true;
+            }
+
+        private:
+            static constexpr uint64_t MaxExactMantissa = (uint64_t(1) << 53);
+            static constexpr int64_t SmallestPower = -342;
+            static constexpr int64_t LargestPower = 308;
+
+            static constexpr double PowersOfTen[] = {
+                1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+            };
+
+            // 5^q for q in [SmallestPower, LargestPower], normalised so the top bit is set and truncated to 128
+            // bits, stored as {high, low} pairs.  Negative powers are rounded up.
+            static constexpr uint64_t PowersOfFive[] = {
+                0xeef453d6923bd65a, 0x113faa2906a13b3f, 0x9558b4661b6565f8, 0x4ac7ca59a424c507,
+                0xbaaee17fa23ebf76, 0x5d79bcf00d2df649, 0xe95a99df8ace6f53, 0xf4d82c2c107973dc,
+                0x91d8a02bb6c10594, 0x79071b9b8a4be869, 0xb64ec836a47146f9, 0x9748e2826cdee284,
+                0xe3e27a444d8d98b7, 0xfd1b1b2308169b25, 0x8e6d8c6ab0787f72, 0xfe30f0f5e50e20f7,
+                0xb208ef855c969f4f, 0xbdbd2d335e51a935, 0xde8b2b66b3bc4723, 0xad2c788035e61382,
+                0x8b16fb203055ac76, 0x4c3bcb5021afcc31, 0xaddcb9e83c6b1793, 0xdf4abe242a1bbf3d,
+                0xd953e8624b85dd78, 0xd71d6dad34a2af0d, 0x87d4713d6f33aa6b, 0x8672648c40e5ad68,
+                0xa9c98d8ccb009506, 0x680efdaf511f18c2, 0xd43bf0effdc0ba48, 0x0212bd1b2566def2,
+                0x84a57695fe98746d, 0x014bb630f7604b57, 0xa5ced43b7e3e9188, 0x419ea3bd35385e2d,
+                0xcf42894a5dce35ea, 0x52064cac828675b9, 0x818995ce7aa0e1b2, 0x7343efebd1940993,
+                0xa1ebfb4219491a1f, 0x1014ebe6c5f90bf8, 0xca66fa129f9b60a6, 0xd41a26e077774ef6,
+                0xfd00b897478238d0, 0x8920b098955522b4, 0x9e20735e8cb16382, 0x55b46e5f5d5535b0,
+                0xc5a890362fddbc62, 0xeb2189f734aa831d, 0xf712b443bbd52b7b, 0xa5e9ec7501d523e4,
+                0x9a6bb0aa55653b2d, 0x47b233c92125366e, 0xc1069cd4eabe89f8, 0x999ec0bb696e840a,
+                0xf148440a256e2c76, 0xc00670ea43ca250d, 0x96cd2a865764dbca, 0x380406926a5e5728,
+                0xbc807527ed3e12bc, 0xc605083704f5ecf2, 0xeba09271e88d976b, 0xf7864a44c633682e,
+                0x93445b8731587ea3, 0x7ab3ee6afbe0211d, 0xb8157268fdae9e4c, 0x5960ea05bad82964,
+                0xe61acf033d1a45df, 0x6fb92487298e33bd, 0x8fd0c16206306bab, 0xa5d3b6d479f8e056,
+                0xb3c4f1ba87bc8696, 0x8f48a4899877186c, 0xe0b62e2929aba83c, 0x331acdabfe94de87,
+                0x8c71dcd9ba0b4925, 0x9ff0c08b7f1d0b14, 0xaf8e5410288e1b6f, 0x07ecf0ae5ee44dd9,
+                0xdb71e91432b1a24a, 0xc9e82cd9f69d6150, 0x892731ac9faf056e, 0xbe311c083a225cd2,
+                0xab70fe17c79ac6ca, 0x6dbd630a48aaf406, 0xd64d3d9db981787d, 0x092cbbccdad5b108,
+                0x85f0468293f0eb4e, 0x25bbf56008c58ea5, 0xa76c582338ed2621, 0xaf2af2b80af6f24e,
+                0xd1476e2c07286faa, 0x1af5af660db4aee1, 0x82cca4db847945ca, 0x50d98d9fc890ed4d,
+                0xa37fce126597973c, 0xe50ff107bab528a0, 0xcc5fc196fefd7d0c, 0x1e53ed49a96272c8,
+                0xff77b1fcbebcdc4f, 0x25e8e89c13bb0f7a, 0x9faacf3df73609b1, 0x77b191618c54e9ac,
+                0xc795830d75038c1d, 0xd59df5b9ef6a2417, 0xf97ae3d0d2446f25, 0x4b0573286b44ad1d,
+                0x9becce62836ac577, 0x4ee367f9430aec32, 0xc2e801fb244576d5, 0x229c41f793cda73f,
+                0xf3a20279ed56d48a, 0x6b43527578c1110f, 0x9845418c345644d6, 0x830a13896b78aaa9,
+                0xbe5691ef416bd60c, 0x23cc986bc656d553, 0xedec366b11c6cb8f, 0x2cbfbe86b7ec8aa8,
+                0x94b3a202eb1c3f39, 0x7bf7d71432f3d6a9, 0xb9e08a83a5e34f07, 0xdaf5ccd93fb0cc53,
+                0xe858ad248f5c22c9, 0xd1b3400f8f9cff68, 0x91376c36d99995be, 0x23100809b9c21fa1,
+                0xb58547448ffffb2d, 0xabd40a0c2832a78a, 0xe2e69915b3fff9f9, 0x16c90c8f323f516c,
+                0x8dd01fad907ffc3b, 0xae3da7d97f6792e3, 0xb1442798f49ffb4a, 0x99cd11cfdf41779c,
+                0xdd95317f31c7fa1d, 0x40405643d711d583, 0x8a7d3eef7f1cfc52, 0x482835ea666b2572,
+                0xad1c8eab5ee43b66, 0xda3243650005eecf, 0xd863b256369d4a40, 0x90bed43e40076a82,
+                0x873e4f75e2224e68, 0x5a7744a6e804a291, 0xa90de3535aaae202, 0x711515d0a205cb36,
+                0xd3515c2831559a83, 0x0d5a5b44ca873e03, 0x8412d9991ed58091, 0xe858790afe9486c2,
+                0xa5178fff668ae0b6, 0x626e974dbe39a872, 0xce5d73ff402d98e3, 0xfb0a3d212dc8128f,
+                0x80fa687f881c7f8e, 0x7ce66634bc9d0b99, 0xa139029f6a239f72, 0x1c1fffc1ebc44e80,
+                0xc987434744ac874e, 0xa327ffb266b56220, 0xfbe9141915d7a922, 0x4bf1ff9f0062baa8,
+                0x9d71ac8fada6c9b5, 0x6f773fc3603db4a9, 0xc4ce17b399107c22, 0xcb550fb4384d21d3,
+                0xf6019da07f549b2b, 0x7e2a53a146606a48, 0x99c102844f94e0fb, 0x2eda7444cbfc426d,
+                0xc0314325637a1939, 0xfa911155fefb5308, 0xf03d93eebc589f88, 0x793555ab7eba27ca,
+                0x96267c7535b763b5, 0x4bc1558b2f3458de, 0xbbb01b9283253ca2, 0x9eb1aaedfb016f16,
+                0xea9c227723ee8bcb, 0x465e15a979c1cadc, 0x92a1958a7675175f, 0x0bfacd89ec191ec9,
+                0xb749faed14125d36, 0xcef980ec671f667b, 0xe51c79a85916f484, 0x82b7e12780e7401a,
+                0x8f31cc0937ae58d2, 0xd1b2ecb8b0908810, 0xb2fe3f0b8599ef07, 0x861fa7e6dcb4aa15,
+                0xdfbdcece67006ac9, 0x67a791e093e1d49a, 0x8bd6a141006042bd, 0xe0c8bb2c5c6d24e0,
+                0xaecc49914078536d, 0x58fae9f773886e18, 0xda7f5bf590966848, 0xaf39a475506a899e,
+                0x888f99797a5e012d, 0x6d8406c952429603, 0xaab37fd7d8f58178, 0xc8e5087ba6d33b83,
+                0xd5605fcdcf32e1d6, 0xfb1e4a9a90880a64, 0x855c3be0a17fcd26, 0x5cf2eea09a55067f,
+                0xa6b34ad8c9dfc06f, 0xf42faa48c0ea481e, 0xd0601d8efc57b08b, 0xf13b94daf124da26,
+                0x823c12795db6ce57, 0x76c53d08d6b70858, 0xa2cb1717b52481ed, 0x54768c4b0c64ca6e,
+                0xcb7ddcdda26da268, 0xa9942f5dcf7dfd09, 0xfe5d54150b090b02, 0xd3f93b35435d7c4c,
+                0x9efa548d26e5a6e1, 0xc47bc5014a1a6daf, 0xc6b8e9b0709f109a, 0x359ab6419ca1091b,
+                0xf867241c8cc6d4c0, 0xc30163d203c94b62, 0x9b407691d7fc44f8, 0x79e0de63425dcf1d,
+                0xc21094364dfb5636, 0x985915fc12f542e4, 0xf294b943e17a2bc4, 0x3e6f5b7b17b2939d,
+                0x979cf3ca6cec5b5a, 0xa705992ceecf9c42, 0xbd8430bd08277231, 0x50c6ff782a838353,
+                0xece53cec4a314ebd, 0xa4f8bf5635246428, 0x940f4613ae5ed136, 0x871b7795e136be99,
+                0xb913179899f68584, 0x28e2557b59846e3f, 0xe757dd7ec07426e5, 0x331aeada2fe589cf,
+                0x9096ea6f3848984f, 0x3ff0d2c85def7621, 0xb4bca50b065abe63, 0x0fed077a756b53a9,
+                0xe1ebce4dc7f16dfb, 0xd3e8495912c62894, 0x8d3360f09cf6e4bd, 0x64712dd7abbbd95c,
+                0xb080392cc4349dec, 0xbd8d794d96aacfb3, 0xdca04777f541c567, 0xecf0d7a0fc5583a0,
+                0x89e42caaf9491b60, 0xf41686c49db57244, 0xac5d37d5b79b6239, 0x311c2875c522ced5,
+                0xd77485cb25823ac7, 0x7d633293366b828b, 0x86a8d39ef77164bc, 0xae5dff9c02033197,
+                0xa8530886b54dbdeb, 0xd9f57f830283fdfc, 0xd267caa862a12d66, 0xd072df63c324fd7b,
+                0x8380dea93da4bc60, 0x4247cb9e59f71e6d, 0xa46116538d0deb78, 0x52d9be85f074e608,
+                0xcd795be870516656, 0x67902e276c921f8b, 0x806bd9714632dff6, 0x00ba1cd8a3db53b6,
+                0xa086cfcd97bf97f3, 0x80e8a40eccd228a4, 0xc8a883c0fdaf7df0, 0x6122cd128006b2cd,
+                0xfad2a4b13d1b5d6c, 0x796b805720085f81, 0x9cc3a6eec6311a63, 0xcbe3303674053bb0,
+                0xc3f490aa77bd60fc, 0xbedbfc4411068a9c, 0xf4f1b4d515acb93b, 0xee92fb5515482d44,
+                0x991711052d8bf3c5, 0x751bdd152d4d1c4a, 0xbf5cd54678eef0b6, 0xd262d45a78a0635d,
+                0xef340a98172aace4, 0x86fb897116c87c34, 0x9580869f0e7aac0e, 0xd45d35e6ae3d4da0,
+                0xbae0a846d2195712, 0x8974836059cca109, 0xe998d258869facd7, 0x2bd1a438703fc94b,
+                0x91ff83775423cc06, 0x7b6306a34627ddcf, 0xb67f6455292cbf08, 0x1a3bc84c17b1d542,
+                0xe41f3d6a7377eeca, 0x20caba5f1d9e4a93, 0x8e938662882af53e, 0x547eb47b7282ee9c,
+                0xb23867fb2a35b28d, 0xe99e619a4f23aa43, 0xdec681f9f4c31f31, 0x6405fa00e2ec94d4,
+                0x8b3c113c38f9f37e, 0xde83bc408dd3dd04, 0xae0b158b4738705e, 0x9624ab50b148d445,
+                0xd98ddaee19068c76, 0x3badd624dd9b0957, 0x87f8a8d4cfa417c9, 0xe54ca5d70a80e5d6,
+                0xa9f6d30a038d1dbc, 0x5e9fcf4ccd211f4c, 0xd47487cc8470652b, 0x7647c3200069671f,
+                0x84c8d4dfd2c63f3b, 0x29ecd9f40041e073, 0xa5fb0a17c777cf09, 0xf468107100525890,
+                0xcf79cc9db955c2cc, 0x7182148d4066eeb4, 0x81ac1fe293d599bf, 0xc6f14cd848405530,
+                0xa21727db38cb002f, 0xb8ada00e5a506a7c, 0xca9cf1d206fdc03b, 0xa6d90811f0e4851c,
+                0xfd442e4688bd304a, 0x908f4a166d1da663, 0x9e4a9cec15763e2e, 0x9a598e4e043287fe,
+                0xc5dd44271ad3cdba, 0x40eff1e1853f29fd, 0xf7549530e188c128, 0xd12bee59e68ef47c,
+                0x9a94dd3e8cf578b9, 0x82bb74f8301958ce, 0xc13a148e3032d6e7, 0xe36a52363c1faf01,
+                0xf18899b1bc3f8ca1, 0xdc44e6c3cb279ac1, 0x96f5600f15a7b7e5, 0x29ab103a5ef8c0b9,
+                0xbcb2b812db11a5de, 0x7415d448f6b6f0e7, 0xebdf661791d60f56, 0x111b495b3464ad21,
+                0x936b9fcebb25c995, 0xcab10dd900beec34, 0xb84687c269ef3bfb, 0x3d5d514f40eea742,
+                0xe65829b3046b0afa, 0x0cb4a5a3112a5112, 0x8ff71a0fe2c2e6dc, 0x47f0e785eaba72ab,
+                0xb3f4e093db73a093, 0x59ed216765690f56, 0xe0f218b8d25088b8, 0x306869c13ec3532c,
+                0x8c974f7383725573, 0x1e414218c73a13fb, 0xafbd2350644eeacf, 0xe5d1929ef90898fa,
+                0xdbac6c247d62a583, 0xdf45f746b74abf39, 0x894bc396ce5da772, 0x6b8bba8c328eb783,
+                0xab9eb47c81f5114f, 0x066ea92f3f326564, 0xd686619ba27255a2, 0xc80a537b0efefebd,
+                0x8613fd0145877585, 0xbd06742ce95f5f36, 0xa798fc4196e952e7, 0x2c48113823b73704,
+                0xd17f3b51fca3a7a0, 0xf75a15862ca504c5, 0x82ef85133de648c4, 0x9a984d73dbe722fb,
+                0xa3ab66580d5fdaf5, 0xc13e60d0d2e0ebba, 0xcc963fee10b7d1b3, 0x318df905079926a8,
+                0xffbbcfe994e5c61f, 0xfdf17746497f7052, 0x9fd561f1fd0f9bd3, 0xfeb6ea8bedefa633,
+                0xc7caba6e7c5382c8, 0xfe64a52ee96b8fc0, 0xf9bd690a1b68637b, 0x3dfdce7aa3c673b0,
+                0x9c1661a651213e2d, 0x06bea10ca65c084e, 0xc31bfa0fe5698db8, 0x486e494fcff30a62,
+                0xf3e2f893dec3f126, 0x5a89dba3c3efccfa, 0x986ddb5c6b3a76b7, 0xf89629465a75e01c,
+                0xbe89523386091465, 0xf6bbb397f1135823, 0xee2ba6c0678b597f, 0x746aa07ded582e2c,
+                0x94db483840b717ef, 0xa8c2a44eb4571cdc, 0xba121a4650e4ddeb, 0x92f34d62616ce413,
+                0xe896a0d7e51e1566, 0x77b020baf9c81d17, 0x915e2486ef32cd60, 0x0ace1474dc1d122e,
+                0xb5b5ada8aaff80b8, 0x0d819992132456ba, 0xe3231912d5bf60e6, 0x10e1fff697ed6c69,
+                0x8df5efabc5979c8f, 0xca8d3ffa1ef463c1, 0xb1736b96b6fd83b3, 0xbd308ff8a6b17cb2,
+                0xddd0467c64bce4a0, 0xac7cb3f6d05ddbde, 0x8aa22c0dbef60ee4, 0x6bcdf07a423aa96b,
+                0xad4ab7112eb3929d, 0x86c16c98d2c953c6, 0xd89d64d57a607744, 0xe871c7bf077ba8b7,
+                0x87625f056c7c4a8b, 0x11471cd764ad4972, 0xa93af6c6c79b5d2d, 0xd598e40d3dd89bcf,
+                0xd389b47879823479, 0x4aff1d108d4ec2c3, 0x843610cb4bf160cb, 0xcedf722a585139ba,
+                0xa54394fe1eedb8fe, 0xc2974eb4ee658828, 0xce947a3da6a9273e, 0x733d226229feea32,
+                0x811ccc668829b887, 0x0806357d5a3f525f, 0xa163ff802a3426a8, 0xca07c2dcb0cf26f7,
+                0xc9bcff6034c13052, 0xfc89b393dd02f0b5, 0xfc2c3f3841f17c67, 0xbbac2078d443ace2,
+                0x9d9ba7832936edc0, 0xd54b944b84aa4c0d, 0xc5029163f384a931, 0x0a9e795e65d4df11,
+                0xf64335bcf065d37d, 0x4d4617b5ff4a16d5, 0x99ea0196163fa42e, 0x504bced1bf8e4e45,
+                0xc06481fb9bcf8d39, 0xe45ec2862f71e1d6, 0xf07da27a82c37088, 0x5d767327bb4e5a4c,
+                0x964e858c91ba2655, 0x3a6a07f8d510f86f, 0xbbe226efb628afea, 0x890489f70a55368b,
+                0xeadab0aba3b2dbe5, 0x2b45ac74ccea842e, 0x92c8ae6b464fc96f, 0x3b0b8bc90012929d,
+                0xb77ada0617e3bbcb, 0x09ce6ebb40173744, 0xe55990879ddcaabd, 0xcc420a6a101d0515,
+                0x8f57fa54c2a9eab6, 0x9fa946824a12232d, 0xb32df8e9f3546564, 0x47939822dc96abf9,
+                0xdff9772470297ebd, 0x59787e2b93bc56f7, 0x8bfbea76c619ef36, 0x57eb4edb3c55b65a,
+                0xaefae51477a06b03, 0xede622920b6b23f1, 0xdab99e59958885c4, 0xe95fab368e45eced,
+                0x88b402f7fd75539b, 0x11dbcb0218ebb414, 0xaae103b5fcd2a881, 0xd652bdc29f26a119,
+                0xd59944a37c0752a2, 0x4be76d3346f0495f, 0x857fcae62d8493a5, 0x6f70a4400c562ddb,
+                0xa6dfbd9fb8e5b88e, 0xcb4ccd500f6bb952, 0xd097ad07a71f26b2, 0x7e2000a41346a7a7,
+                0x825ecc24c873782f, 0x8ed400668c0c28c8, 0xa2f67f2dfa90563b, 0x728900802f0f32fa,
+                0xcbb41ef979346bca, 0x4f2b40a03ad2ffb9, 0xfea126b7d78186bc, 0xe2f610c84987bfa8,
+                0x9f24b832e6b0f436, 0x0dd9ca7d2df4d7c9, 0xc6ede63fa05d3143, 0x91503d1c79720dbb,
+                0xf8a95fcf88747d94, 0x75a44c6397ce912a, 0x9b69dbe1b548ce7c, 0xc986afbe3ee11aba,
+                0xc24452da229b021b, 0xfbe85badce996168, 0xf2d56790ab41c2a2, 0xfae27299423fb9c3,
+                0x97c560ba6b0919a5, 0xdccd879fc967d41a, 0xbdb6b8e905cb600f, 0x5400e987bbc1c920,
+                0xed246723473e3813, 0x290123e9aab23b68, 0x9436c0760c86e30b, 0xf9a0b6720aaf6521,
+                0xb94470938fa89bce, 0xf808e40e8d5b3e69, 0xe7958cb87392c2c2, 0xb60b1d1230b20e04,
+                0x90bd77f3483bb9b9, 0xb1c6f22b5e6f48c2, 0xb4ecd5f01a4aa828, 0x1e38aeb6360b1af3,
+                0xe2280b6c20dd5232, 0x25c6da63c38de1b0, 0x8d590723948a535f, 0x579c487e5a38ad0e,
+                0xb0af48ec79ace837, 0x2d835a9df0c6d851, 0xdcdb1b2798182244, 0xf8e431456cf88e65,
+                0x8a08f0f8bf0f156b, 0x1b8e9ecb641b58ff, 0xac8b2d36eed2dac5, 0xe272467e3d222f3f,
+                0xd7adf884aa879177, 0x5b0ed81dcc6abb0f, 0x86ccbb52ea94baea, 0x98e947129fc2b4e9,
+                0xa87fea27a539e9a5, 0x3f2398d747b36224, 0xd29fe4b18e88640e, 0x8eec7f0d19a03aad,
+                0x83a3eeeef9153e89, 0x1953cf68300424ac, 0xa48ceaaab75a8e2b, 0x5fa8c3423c052dd7,
+                0xcdb02555653131b6, 0x3792f412cb06794d, 0x808e17555f3ebf11, 0xe2bbd88bbee40bd0,
+                0xa0b19d2ab70e6ed6, 0x5b6aceaeae9d0ec4, 0xc8de047564d20a8b, 0xf245825a5a445275,
+                0xfb158592be068d2e, 0xeed6e2f0f0d56712, 0x9ced737bb6c4183d, 0x55464dd69685606b,
+                0xc428d05aa4751e4c, 0xaa97e14c3c26b886, 0xf53304714d9265df, 0xd53dd99f4b3066a8,
+                0x993fe2c6d07b7fab, 0xe546a8038efe4029, 0xbf8fdb78849a5f96, 0xde98520472bdd033,
+                0xef73d256a5c0f77c, 0x963e66858f6d4440, 0x95a8637627989aad, 0xdde7001379a44aa8,
+                0xbb127c53b17ec159, 0x5560c018580d5d52, 0xe9d71b689dde71af, 0xaab8f01e6e10b4a6,
+                0x9226712162ab070d, 0xcab3961304ca70e8, 0xb6b00d69bb55c8d1, 0x3d607b97c5fd0d22,
+                0xe45c10c42a2b3b05, 0x8cb89a7db77c506a, 0x8eb98a7a9a5b04e3, 0x77f3608e92adb242,
+                0xb267ed1940f1c61c, 0x55f038b237591ed3, 0xdf01e85f912e37a3, 0x6b6c46dec52f6688,
+                0x8b61313bbabce2c6, 0x2323ac4b3b3da015, 0xae397d8aa96c1b77, 0xabec975e0a0d081a,
+                0xd9c7dced53c72255, 0x96e7bd358c904a21, 0x881cea14545c7575, 0x7e50d64177da2e54,
+                0xaa242499697392d2, 0xdde50bd1d5d0b9e9, 0xd4ad2dbfc3d07787, 0x955e4ec64b44e864,
+                0x84ec3c97da624ab4, 0xbd5af13bef0b113e, 0xa6274bbdd0fadd61, 0xecb1ad8aeacdd58e,
+                0xcfb11ead453994ba, 0x67de18eda5814af2, 0x81ceb32c4b43fcf4, 0x80eacf948770ced7,
+                0xa2425ff75e14fc31, 0xa1258379a94d028d, 0xcad2f7f5359a3b3e, 0x096ee45813a04330,
+                0xfd87b5f28300ca0d, 0x8bca9d6e188853fc, 0x9e74d1b791e07e48, 0x775ea264cf55347e,
+                0xc612062576589dda, 0x95364afe032a819e, 0xf79687aed3eec551, 0x3a83ddbd83f52205,
+                0x9abe14cd44753b52, 0xc4926a9672793543, 0xc16d9a0095928a27, 0x75b7053c0f178294,
+                0xf1c90080baf72cb1, 0x5324c68b12dd6339, 0x971da05074da7bee, 0xd3f6fc16ebca5e04,
+                0xbce5086492111aea, 0x88f4bb1ca6bcf585, 0xec1e4a7db69561a5, 0x2b31e9e3d06c32e6,
+                0x9392ee8e921d5d07, 0x3aff322e62439fd0, 0xb877aa3236a4b449, 0x09befeb9fad487c3,
+                0xe69594bec44de15b, 0x4c2ebe687989a9b4, 0x901d7cf73ab0acd9, 0x0f9d37014bf60a11,
+                0xb424dc35095cd80f, 0x538484c19ef38c95, 0xe12e13424bb40e13, 0x2865a5f206b06fba,
+                0x8cbccc096f5088cb, 0xf93f87b7442e45d4, 0xafebff0bcb24aafe, 0xf78f69a51539d749,
+                0xdbe6fecebdedd5be, 0xb573440e5a884d1c, 0x89705f4136b4a597, 0x31680a88f8953031,
+                0xabcc77118461cefc, 0xfdc20d2b36ba7c3e, 0xd6bf94d5e57a42bc, 0x3d32907604691b4d,
+                0x8637bd05af6c69b5, 0xa63f9a49c2c1b110, 0xa7c5ac471b478423, 0x0fcf80dc33721d54,
+                0xd1b71758e219652b, 0xd3c36113404ea4a9, 0x83126e978d4fdf3b, 0x645a1cac083126ea,
+                0xa3d70a3d70a3d70a, 0x3d70a3d70a3d70a4, 0xcccccccccccccccc, 0xcccccccccccccccd,
+                0x8000000000000000, 0x0000000000000000, 0xa000000000000000, 0x0000000000000000,
+                0xc800000000000000, 0x0000000000000000, 0xfa00000000000000, 0x0000000000000000,
+                0x9c40000000000000, 0x0000000000000000, 0xc350000000000000, 0x0000000000000000,
+                0xf424000000000000, 0x0000000000000000, 0x9896800000000000, 0x0000000000000000,
+                0xbebc200000000000, 0x0000000000000000, 0xee6b280000000000, 0x0000000000000000,
+                0x9502f90000000000, 0x0000000000000000, 0xba43b74000000000, 0x0000000000000000,
+                0xe8d4a51000000000, 0x0000000000000000, 0x9184e72a00000000, 0x0000000000000000,
+                0xb5e620f480000000, 0x0000000000000000, 0xe35fa931a0000000, 0x0000000000000000,
+                0x8e1bc9bf04000000, 0x0000000000000000, 0xb1a2bc2ec5000000, 0x0000000000000000,
+                0xde0b6b3a76400000, 0x0000000000000000, 0x8ac7230489e80000, 0x0000000000000000,
+                0xad78ebc5ac620000, 0x0000000000000000, 0xd8d726b7177a8000, 0x0000000000000000,
+                0x878678326eac9000, 0x0000000000000000, 0xa968163f0a57b400, 0x0000000000000000,
+                0xd3c21bcecceda100, 0x0000000000000000, 0x84595161401484a0, 0x0000000000000000,
+                0xa56fa5b99019a5c8, 0x0000000000000000, 0xcecb8f27f4200f3a, 0x0000000000000000,
+                0x813f3978f8940984, 0x4000000000000000, 0xa18f07d736b90be5, 0x5000000000000000,
+                0xc9f2c9cd04674ede, 0xa400000000000000, 0xfc6f7c4045812296, 0x4d00000000000000,
+                0x9dc5ada82b70b59d, 0xf020000000000000, 0xc5371912364ce305, 0x6c28000000000000,
+                0xf684df56c3e01bc6, 0xc732000000000000, 0x9a130b963a6c115c, 0x3c7f400000000000,
+                0xc097ce7bc90715b3, 0x4b9f100000000000, 0xf0bdc21abb48db20, 0x1e86d40000000000,
+                0x96769950b50d88f4, 0x1314448000000000, 0xbc143fa4e250eb31, 0x17d955a000000000,
+                0xeb194f8e1ae525fd, 0x5dcfab0800000000, 0x92efd1b8d0cf37be, 0x5aa1cae500000000,
+                0xb7abc627050305ad, 0xf14a3d9e40000000, 0xe596b7b0c643c719, 0x6d9ccd05d0000000,
+                0x8f7e32ce7bea5c6f, 0xe4820023a2000000, 0xb35dbf821ae4f38b, 0xdda2802c8a800000,
+                0xe0352f62a19e306e, 0xd50b2037ad200000, 0x8c213d9da502de45, 0x4526f422cc340000,
+                0xaf298d050e4395d6, 0x9670b12b7f410000, 0xdaf3f04651d47b4c, 0x3c0cdd765f114000,
+                0x88d8762bf324cd0f, 0xa5880a69fb6ac800, 0xab0e93b6efee0053, 0x8eea0d047a457a00,
+                0xd5d238a4abe98068, 0x72a4904598d6d880, 0x85a36366eb71f041, 0x47a6da2b7f864750,
+                0xa70c3c40a64e6c51, 0x999090b65f67d924, 0xd0cf4b50cfe20765, 0xfff4b4e3f741cf6d,
+                0x82818f1281ed449f, 0xbff8f10e7a8921a4, 0xa321f2d7226895c7, 0xaff72d52192b6a0d,
+                0xcbea6f8ceb02bb39, 0x9bf4f8a69f764490, 0xfee50b7025c36a08, 0x02f236d04753d5b4,
+                0x9f4f2726179a2245, 0x01d762422c946590, 0xc722f0ef9d80aad6, 0x424d3ad2b7b97ef5,
+                0xf8ebad2b84e0d58b, 0xd2e0898765a7deb2, 0x9b934c3b330c8577, 0x63cc55f49f88eb2f,
+                0xc2781f49ffcfa6d5, 0x3cbf6b71c76b25fb, 0xf316271c7fc3908a, 0x8bef464e3945ef7a,
+                0x97edd871cfda3a56, 0x97758bf0e3cbb5ac, 0xbde94e8e43d0c8ec, 0x3d52eeed1cbea317,
+                0xed63a231d4c4fb27, 0x4ca7aaa863ee4bdd, 0x945e455f24fb1cf8, 0x8fe8caa93e74ef6a,
+                0xb975d6b6ee39e436, 0xb3e2fd538e122b44, 0xe7d34c64a9c85d44, 0x60dbbca87196b616,
+                0x90e40fbeea1d3a4a, 0xbc8955e946fe31cd, 0xb51d13aea4a488dd, 0x6babab6398bdbe41,
+                0xe264589a4dcdab14, 0xc696963c7eed2dd1, 0x8d7eb76070a08aec, 0xfc1e1de5cf543ca2,
+                0xb0de65388cc8ada8, 0x3b25a55f43294bcb, 0xdd15fe86affad912, 0x49ef0eb713f39ebe,
+                0x8a2dbf142dfcc7ab, 0x6e3569326c784337, 0xacb92ed9397bf996, 0x49c2c37f07965404,
+                0xd7e77a8f87daf7fb, 0xdc33745ec97be906, 0x86f0ac99b4e8dafd, 0x69a028bb3ded71a3,
+                0xa8acd7c0222311bc, 0xc40832ea0d68ce0c, 0xd2d80db02aabd62b, 0xf50a3fa490c30190,
+                0x83c7088e1aab65db, 0x792667c6da79e0fa, 0xa4b8cab1a1563f52, 0x577001b891185938,
+                0xcde6fd5e09abcf26, 0xed4c0226b55e6f86, 0x80b05e5ac60b6178, 0x544f8158315b05b4,
+                0xa0dc75f1778e39d6, 0x696361ae3db1c721, 0xc913936dd571c84c, 0x03bc3a19cd1e38e9,
+                0xfb5878494ace3a5f, 0x04ab48a04065c723, 0x9d174b2dcec0e47b, 0x62eb0d64283f9c76,
+                0xc45d1df942711d9a, 0x3ba5d0bd324f8394, 0xf5746577930d6500, 0xca8f44ec7ee36479,
+                0x9968bf6abbe85f20, 0x7e998b13cf4e1ecb, 0xbfc2ef456ae276e8, 0x9e3fedd8c321a67e,
+                0xefb3ab16c59b14a2, 0xc5cfe94ef3ea101e, 0x95d04aee3b80ece5, 0xbba1f1d158724a12,
+                0xbb445da9ca61281f, 0x2a8a6e45ae8edc97, 0xea1575143cf97226, 0xf52d09d71a3293bd,
+                0x924d692ca61be758, 0x593c2626705f9c56, 0xb6e0c377cfa2e12e, 0x6f8b2fb00c77836c,
+                0xe498f455c38b997a, 0x0b6dfb9c0f956447, 0x8edf98b59a373fec, 0x4724bd4189bd5eac,
+                0xb2977ee300c50fe7, 0x58edec91ec2cb657, 0xdf3d5e9bc0f653e1, 0x2f2967b66737e3ed,
+                0x8b865b215899f46c, 0xbd79e0d20082ee74, 0xae67f1e9aec07187, 0xecd8590680a3aa11,
+                0xda01ee641a708de9, 0xe80e6f4820cc9495, 0x884134fe908658b2, 0x3109058d147fdcdd,
+                0xaa51823e34a7eede, 0xbd4b46f0599fd415, 0xd4e5e2cdc1d1ea96, 0x6c9e18ac7007c91a,
+                0x850fadc09923329e, 0x03e2cf6bc604ddb0, 0xa6539930bf6bff45, 0x84db8346b786151c,
+                0xcfe87f7cef46ff16, 0xe612641865679a63, 0x81f14fae158c5f6e, 0x4fcb7e8f3f60c07e,
+                0xa26da3999aef7749, 0xe3be5e330f38f09d, 0xcb090c8001ab551c, 0x5cadf5bfd3072cc5,
+                0xfdcb4fa002162a63, 0x73d9732fc7c8f7f6, 0x9e9f11c4014dda7e, 0x2867e7fddcdd9afa,
+                0xc646d63501a1511d, 0xb281e1fd541501b8, 0xf7d88bc24209a565, 0x1f225a7ca91a4226,
+                0x9ae757596946075f, 0x3375788de9b06958, 0xc1a12d2fc3978937, 0x0052d6b1641c83ae,
+                0xf209787bb47d6b84, 0xc0678c5dbd23a49a, 0x9745eb4d50ce6332, 0xf840b7ba963646e0,
+                0xbd176620a501fbff, 0xb650e5a93bc3d898, 0xec5d3fa8ce427aff, 0xa3e51f138ab4cebe,
+                0x93ba47c980e98cdf, 0xc66f336c36b10137, 0xb8a8d9bbe123f017, 0xb80b0047445d4184,
+                0xe6d3102ad96cec1d, 0xa60dc059157491e5, 0x9043ea1ac7e41392, 0x87c89837ad68db2f,
+                0xb454e4a179dd1877, 0x29babe4598c311fb, 0xe16a1dc9d8545e94, 0xf4296dd6fef3d67a,
+                0x8ce2529e2734bb1d, 0x1899e4a65f58660c, 0xb01ae745b101e9e4, 0x5ec05dcff72e7f8f,
+                0xdc21a1171d42645d, 0x76707543f4fa1f73, 0x899504ae72497eba, 0x6a06494a791c53a8,
+                0xabfa45da0edbde69, 0x0487db9d17636892, 0xd6f8d7509292d603, 0x45a9d2845d3c42b6,
+                0x865b86925b9bc5c2, 0x0b8a2392ba45a9b2, 0xa7f26836f282b732, 0x8e6cac7768d7141e,
+                0xd1ef0244af2364ff, 0x3207d795430cd926, 0x8335616aed761f1f, 0x7f44e6bd49e807b8,
+                0xa402b9c5a8d3a6e7, 0x5f16206c9c6209a6, 0xcd036837130890a1, 0x36dba887c37a8c0f,
+                0x802221226be55a64, 0xc2494954da2c9789, 0xa02aa96b06deb0fd, 0xf2db9baa10b7bd6c,
+                0xc83553c5c8965d3d, 0x6f92829494e5acc7, 0xfa42a8b73abbf48c, 0xcb772339ba1f17f9,
+                0x9c69a97284b578d7, 0xff2a760414536efb, 0xc38413cf25e2d70d, 0xfef5138519684aba,
+                0xf46518c2ef5b8cd1, 0x7eb258665fc25d69, 0x98bf2f79d5993802, 0xef2f773ffbd97a61,
+                0xbeeefb584aff8603, 0xaafb550ffacfd8fa, 0xeeaaba2e5dbf6784, 0x95ba2a53f983cf38,
+                0x952ab45cfa97a0b2, 0xdd945a747bf26183, 0xba756174393d88df, 0x94f971119aeef9e4,
+                0xe912b9d1478ceb17, 0x7a37cd5601aab85d, 0x91abb422ccb812ee, 0xac62e055c10ab33a,
+                0xb616a12b7fe617aa, 0x577b986b314d6009, 0xe39c49765fdf9d94, 0xed5a7e85fda0b80b,
+                0x8e41ade9fbebc27d, 0x14588f13be847307, 0xb1d219647ae6b31c, 0x596eb2d8ae258fc8,
+                0xde469fbd99a05fe3, 0x6fca5f8ed9aef3bb, 0x8aec23d680043bee, 0x25de7bb9480d5854,
+                0xada72ccc20054ae9, 0xaf561aa79a10ae6a, 0xd910f7ff28069da4, 0x1b2ba1518094da04,
+                0x87aa9aff79042286, 0x90fb44d2f05d0842, 0xa99541bf57452b28, 0x353a1607ac744a53,
+                0xd3fa922f2d1675f2, 0x42889b8997915ce8, 0x847c9b5d7c2e09b7, 0x69956135febada11,
+                0xa59bc234db398c25, 0x43fab9837e699095, 0xcf02b2c21207ef2e, 0x94f967e45e03f4bb,
+                0x8161afb94b44f57d, 0x1d1be0eebac278f5, 0xa1ba1ba79e1632dc, 0x6462d92a69731732,
+                0xca28a291859bbf93, 0x7d7b8f7503cfdcfe, 0xfcb2cb35e702af78, 0x5cda735244c3d43e,
+                0x9defbf01b061adab, 0x3a0888136afa64a7, 0xc56baec21c7a1916, 0x088aaa1845b8fdd0,
+                0xf6c69a72a3989f5b, 0x8aad549e57273d45, 0x9a3c2087a63f6399, 0x36ac54e2f678864b,
+                0xc0cb28a98fcf3c7f, 0x84576a1bb416a7dd, 0xf0fdf2d3f3c30b9f, 0x656d44a2a11c51d5,
+                0x969eb7c47859e743, 0x9f644ae5a4b1b325, 0xbc4665b596706114, 0x873d5d9f0dde1fee,
+                0xeb57ff22fc0c7959, 0xa90cb506d155a7ea, 0x9316ff75dd87cbd8, 0x09a7f12442d588f2,
+                0xb7dcbf5354e9bece, 0x0c11ed6d538aeb2f, 0xe5d3ef282a242e81, 0x8f1668c8a86da5fa,
+                0x8fa475791a569d10, 0xf96e017d694487bc, 0xb38d92d760ec4455, 0x37c981dcc395a9ac,
+                0xe070f78d3927556a, 0x85bbe253f47b1417, 0x8c469ab843b89562, 0x93956d7478ccec8e,
+                0xaf58416654a6babb, 0x387ac8d1970027b2, 0xdb2e51bfe9d0696a, 0x06997b05fcc0319e,
+                0x88fcf317f22241e2, 0x441fece3bdf81f03, 0xab3c2fddeeaad25a, 0xd527e81cad7626c3,
+                0xd60b3bd56a5586f1, 0x8a71e223d8d3b074, 0x85c7056562757456, 0xf6872d5667844e49,
+                0xa738c6bebb12d16c, 0xb428f8ac016561db, 0xd106f86e69d785c7, 0xe13336d701beba52,
+                0x82a45b450226b39c, 0xecc0024661173473, 0xa34d721642b06084, 0x27f002d7f95d0190,
+                0xcc20ce9bd35c78a5, 0x31ec038df7b441f4, 0xff290242c83396ce, 0x7e67047175a15271,
+                0x9f79a169bd203e41, 0x0f0062c6e984d386, 0xc75809c42c684dd1, 0x52c07b78a3e60868,
+                0xf92e0c3537826145, 0xa7709a56ccdf8a82, 0x9bbcc7a142b17ccb, 0x88a66076400bb691,
+                0xc2abf989935ddbfe, 0x6acff893d00ea435, 0xf356f7ebf83552fe, 0x0583f6b8c4124d43,
+                0x98165af37b2153de, 0xc3727a337a8b704a, 0xbe1bf1b059e9a8d6, 0x744f18c0592e4c5c,
+                0xeda2ee1c7064130c, 0x1162def06f79df73, 0x9485d4d1c63e8be7, 0x8addcb5645ac2ba8,
+                0xb9a74a0637ce2ee1, 0x6d953e2bd7173692, 0xe8111c87c5c1ba99, 0xc8fa8db6ccdd0437,
+                0x910ab1d4db9914a0, 0x1d9c9892400a22a2, 0xb54d5e4a127f59c8, 0x2503beb6d00cab4b,
+                0xe2a0b5dc971f303a, 0x2e44ae64840fd61d, 0x8da471a9de737e24, 0x5ceaecfed289e5d2,
+                0xb10d8e1456105dad, 0x7425a83e872c5f47, 0xdd50f1996b947518, 0xd12f124e28f77719,
+                0x8a5296ffe33cc92f, 0x82bd6b70d99aaa6f, 0xace73cbfdc0bfb7b, 0x636cc64d1001550b,
+                0xd8210befd30efa5a, 0x3c47f7e05401aa4e, 0x8714a775e3e95c78, 0x65acfaec34810a71,
+                0xa8d9d1535ce3b396, 0x7f1839a741a14d0d, 0xd31045a8341ca07c, 0x1ede48111209a050,
+                0x83ea2b892091e44d, 0x934aed0aab460432, 0xa4e4b66b68b65d60, 0xf81da84d5617853f,
+                0xce1de40642e3f4b9, 0x36251260ab9d668e, 0x80d2ae83e9ce78f3, 0xc1d72b7c6b426019,
+                0xa1075a24e4421730, 0xb24cf65b8612f81f, 0xc94930ae1d529cfc, 0xdee033f26797b627,
+                0xfb9b7cd9a4a7443c, 0x169840ef017da3b1, 0x9d412e0806e88aa5, 0x8e1f289560ee864e,
+                0xc491798a08a2ad4e, 0xf1a6f2bab92a27e2, 0xf5b5d7ec8acb58a2, 0xae10af696774b1db,
+                0x9991a6f3d6bf1765, 0xacca6da1e0a8ef29, 0xbff610b0cc6edd3f, 0x17fd090a58d32af3,
+                0xeff394dcff8a948e, 0xddfc4b4cef07f5b0, 0x95f83d0a1fb69cd9, 0x4abdaf101564f98e,
+                0xbb764c4ca7a4440f, 0x9d6d1ad41abe37f1, 0xea53df5fd18d5513, 0x84c86189216dc5ed,
+                0x92746b9be2f8552c, 0x32fd3cf5b4e49bb4, 0xb7118682dbb66a77, 0x3fbc8c33221dc2a1,
+                0xe4d5e82392a40515, 0x0fabaf3feaa5334a, 0x8f05b1163ba6832d, 0x29cb4d87f2a7400e,
+                0xb2c71d5bca9023f8, 0x743e20e9ef511012, 0xdf78e4b2bd342cf6, 0x914da9246b255416,
+                0x8bab8eefb6409c1a, 0x1ad089b6c2f7548e, 0xae9672aba3d0c320, 0xa184ac2473b529b1,
+                0xda3c0f568cc4f3e8, 0xc9e5d72d90a2741e, 0x8865899617fb1871, 0x7e2fa67c7a658892,
+                0xaa7eebfb9df9de8d, 0xddbb901b98feeab7, 0xd51ea6fa85785631, 0x552a74227f3ea565,
+                0x8533285c936b35de, 0xd53a88958f87275f, 0xa67ff273b8460356, 0x8a892abaf368f137,
+                0xd01fef10a657842c, 0x2d2b7569b0432d85, 0x8213f56a67f6b29b, 0x9c3b29620e29fc73,
+                0xa298f2c501f45f42, 0x8349f3ba91b47b8f, 0xcb3f2f7642717713, 0x241c70a936219a73,
+                0xfe0efb53d30dd4d7, 0xed238cd383aa0110, 0x9ec95d1463e8a506, 0xf4363804324a40aa,
+                0xc67bb4597ce2ce48, 0xb143c6053edcd0d5, 0xf81aa16fdc1b81da, 0xdd94b7868e94050a,
+                0x9b10a4e5e9913128, 0xca7cf2b4191c8326, 0xc1d4ce1f63f57d72, 0xfd1c2f611f63a3f0,
+                0xf24a01a73cf2dccf, 0xbc633b39673c8cec, 0x976e41088617ca01, 0xd5be0503e085d813,
+                0xbd49d14aa79dbc82, 0x4b2d8644d8a74e18, 0xec9c459d51852ba2, 0xddf8e7d60ed1219e,
+                0x93e1ab8252f33b45, 0xcabb90e5c942b503, 0xb8da1662e7b00a17, 0x3d6a751f3b936243,
+                0xe7109bfba19c0c9d, 0x0cc512670a783ad4, 0x906a617d450187e2, 0x27fb2b80668b24c5,
+                0xb484f9dc9641e9da, 0xb1f9f660802dedf6, 0xe1a63853bbd26451, 0x5e7873f8a0396973,
+                0x8d07e33455637eb2, 0xdb0b487b6423e1e8, 0xb049dc016abc5e5f, 0x91ce1a9a3d2cda62,
+                0xdc5c5301c56b75f7, 0x7641a140cc7810fb, 0x89b9b3e11b6329ba, 0xa9e904c87fcb0a9d,
+                0xac2820d9623bf429, 0x546345fa9fbdcd44, 0xd732290fbacaf133, 0xa97c177947ad4095,
+                0x867f59a9d4bed6c0, 0x49ed8eabcccc485d, 0xa81f301449ee8c70, 0x5c68f256bfff5a74,
+                0xd226fc195c6a2f8c, 0x73832eec6fff3111, 0x83585d8fd9c25db7, 0xc831fd53c5ff7eab,
+                0xa42e74f3d032f525, 0xba3e7ca8b77f5e55, 0xcd3a1230c43fb26f, 0x28ce1bd2e55f35eb,
+                0x80444b5e7aa7cf85, 0x7980d163cf5b81b3, 0xa0555e361951c366, 0xd7e105bcc332621f,
+                0xc86ab5c39fa63440, 0x8dd9472bf3fefaa7, 0xfa856334878fc150, 0xb14f98f6f0feb951,
+                0x9c935e00d4b9d8d2, 0x6ed1bf9a569f33d3, 0xc3b8358109e84f07, 0x0a862f80ec4700c8,
+                0xf4a642e14c6262c8, 0xcd27bb612758c0fa, 0x98e7e9cccfbd7dbd, 0x8038d51cb897789c,
+                0xbf21e44003acdd2c, 0xe0470a63e6bd56c3, 0xeeea5d5004981478, 0x1858ccfce06cac74,
+                0x95527a5202df0ccb, 0x0f37801e0c43ebc8, 0xbaa718e68396cffd, 0xd30560258f54e6ba,
+                0xe950df20247c83fd, 0x47c6b82ef32a2069, 0x91d28b7416cdd27e, 0x4cdc331d57fa5441,
+                0xb6472e511c81471d, 0xe0133fe4adf8e952, 0xe3d8f9e563a198e5, 0x58180fddd97723a6,
+                0x8e679c2f5e44ff8f, 0x570f09eaa7ea7648
+            };
+
+            //------------------------------------------------------------------------------------------------
+
+            static int32_t CountLeadingZeros(uint64_t value) {
+#ifdef __GNUG__
+                return __builtin_clzll(value);
+#elif defined(_MSC_VER) && defined(_M_X64)
+                unsigned long offset;
+                _BitScanReverse64(&offset, value);
+                return 63 - static_cast<int32_t>(offset);
+#else
+                int32_t count = 0;
+                while ((value & (uint64_t(1) << 63)) == 0) {
+                    value <<= 1;
+                    ++count;
+                }
+                return count;
+#endif
+            }
+
+            //------------------------------------------------------------------------------------------------
+
+            // Returns the high 64 bits of `a * b` and stores the low 64 bits in `low`.
+            static uint64_t Multiply(uint64_t a, uint64_t b, uint64_t& low) {
+#if defined(__GNUG__) && defined(__SIZEOF_INT128__)
+                __extension__ typedef unsigned __int128 uint128_t;
+                uint128_t product = static_cast<uint128_t>(a) * b;
+                low = static_cast<uint64_t>(product);
+                return static_cast<uint64_t>(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+                uint64_t high;
+                low = _umul128(a, b, &high);
+                return high;
+#else
+                uint64_t a_lo = a & 0xFFFFFFFF, a_hi = a >> 32;
+                uint64_t b_lo = b & 0xFFFFFFFF, b_hi = b >> 32;
+                uint64_t lo_lo = a_lo * b_lo;
+                uint64_t hi_lo = a_hi * b_lo;
+                uint64_t lo_hi = a_lo * b_hi;
+                uint64_t hi_hi = a_hi * b_hi;
+                uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+                low = (cross << 32) | (lo_lo & 0xFFFFFFFF);
+                return (hi_lo >> 32) + (cross >> 32) + hi_hi;
+#endif
+            }
+
+            //------------------------------------------------------------------------------------------------
+
+            static double MakeDouble(uint64_t significand, int64_t real_exponent, bool is_negative) {
+                uint64_t bits = significand | (static_cast<uint64_t>(real_exponent) << 52);
+                if (is_negative) { bits |= uint64_t(1) << 63; }
+                double value;
+                std::memcpy(&value, &bits, sizeof(value));
+                return value;
+            }
+        };
+
+        //----------------------------------------------------------------------------------------------------
+
+        // Exact, locale independent conversion of the JSON number in `[first, last)` to a double.  Used for the
+        // rare inputs that `DecimalToDouble` can't decide.  `is_large` says which way to saturate if the value
+        // is out of range.
+        inline double ParseDoubleExact(const char* first, const char* last, bool is_large) {
+#if defined(__cpp_lib_to_chars)
+            double value = 0.0;
+            auto result = std::from_chars(first, last, value);
+            if (result.ec == std::errc::result_out_of_range) {
+                value = is_large ? std::numeric_limits<double>::infinity() : 0.0;
+                if (*first == '-') { value = -value; }
+            }
+            return value;
+#else
+            // No locale independent alternative.  Only reached for more than 19 significant digits or exact
+            // ties, and only differs from `from_chars` under locales that don't use '.' as the decimal point.
+            (void)last;
+            (void)is_large;
+            return std::strtod(first, nullptr);
+#endif
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        // The arrays and objects that are open while parsing, one bit per level.  The first `InlineDepth` levels
+        // are stored inline, so only unusually deep documents allocate.
+        class ScopeStack {
+        public:
+            static constexpr size_t InlineDepth = 1024;
+
+            size_t Depth() const noexcept { return m_depth; }
+            bool Empty() const noexcept { return m_depth == 0; }
+
+            // Whether the innermost scope is an object rather than an array.
+            bool InObject() const noexcept {
+                size_t level = m_depth - 1;
+                return ((Word(level) >> (level % 64)) & 1) != 0;
+            }
+
+            void Push(bool is_object) {
+                size_t word = m_depth / 64;
+                if (word >= InlineWords && word - InlineWords == m_overflow.size()) {
+                    m_overflow.push_back(0);
+                }
+
+                uint64_t& bits = (word < InlineWords) ? m_inline[word] : m_overflow[word - InlineWords];
+                uint64_t bit = uint64_t(1) << (m_depth % 64);
+                bits = is_object ? (bits | bit) : (bits & ~bit);
+                ++m_depth;
+            }
+
+            void Pop() noexcept { --m_depth; }
+            void Clear() noexcept { m_depth = 0; }
+
+        private:
+            static constexpr size_t InlineWords = InlineDepth / 64;
+
+            uint64_t Word(size_t level) const noexcept {
+                size_t word = level / 64;
+                return (word < InlineWords) ? m_inline[word] : m_overflow[word - InlineWords];
+            }
+
+            size_t m_depth = 0;
+            uint64_t m_inline[InlineWords];
+            std::vector<uint64_t> m_overflow;
+        };
+
+        //----------------------------------------------------------------------------------------------------
+
+        // A read-only view of a whole file, memory mapped where the platform supports it.  At least `Padding`
+        // zero bytes are readable past the end of the data so that no parser read can fault.
+        class MappedFile {
+        public:
+            static constexpr size_t Padding = 64;
+
+            MappedFile() = default;
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            ~MappedFile() {
+#if defined(CPPJSON_MMAP_POSIX)
+                if (m_mapping != nullptr) { munmap(m_mapping, m_mapping_size); }
+#elif defined(CPPJSON_MMAP_WIN32)
+                if (m_mapping != nullptr) { UnmapViewOfFile(m_mapping); }
+#endif
+            }
+
+            bool Open(const char* path) {
+#if defined(CPPJSON_MMAP_POSIX)
+                int fd = open(path, O_RDONLY);
+                if (fd < 0) { return false; }
+
+                struct stat info;
+                if (fstat(fd, &info) != 0) {
+                    close(fd);
+                    return false;
+                }
+                if (!S_ISREG(info.st_mode)) {
+                    // Pipes and devices can't be mapped.
+                    close(fd);
+                    return ReadFile(path);
+                }
+
+                m_size = static_cast<size_t>(info.st_size);
+                if (m_size == 0) {
+                    close(fd);
+                    m_data = EmptyData();
+                    return true;
+                }
+
+                // Reserve zeroed pages covering the file plus padding, then map the file over the start of
+                // them.  The padding is then readable however close the file size is to a page boundary.
+                auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+                m_mapping_size = (m_size + Padding + page_size - 1) / page_size * page_size;
+                m_mapping = mmap(nullptr, m_mapping_size, PROT_READ, MAP_PRIVATE | MAP_ANON, -1, 0);
+                if (m_mapping == MAP_FAILED) {
+                    m_mapping = nullptr;
+                    close(fd);
+                    return false;
+                }
+
+                void* file_mapping = mmap(m_mapping, m_size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0);
+                close(fd);
+                if (file_mapping == MAP_FAILED) { return false; }
+
+                madvise(m_mapping, m_size, MADV_SEQUENTIAL);
+                m_data = static_cast<const char*>(m_mapping);
+                return true;
+
+#elif defined(CPPJSON_MMAP_WIN32)
+                HANDLE file = CreateFileA(
+                    path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr
+                );
+                if (file == INVALID_HANDLE_VALUE) { return false; }
+
+                LARGE_INTEGER size;
+                if (!GetFileSizeEx(file, &size)) {
+                    CloseHandle(file);
+                    return false;
+                }
+                m_size = static_cast<size_t>(size.QuadPart);
+
+                // Views can't be extended past the end of the file, so only map it if the last page has room
+                // for the padding.
+                SYSTEM_INFO system_info;
+                GetSystemInfo(&system_info);
+                size_t page_size = system_info.dwPageSize;
+                size_t tail = m_size % page_size;
+                if (m_size == 0 || tail == 0 || page_size - tail < Padding) {
+                    CloseHandle(file);
+                    return ReadFile(path);
+                }
+
+                HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                CloseHandle(file);
+                if (mapping == nullptr) { return false; }
+
+                m_mapping = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                CloseHandle(mapping);
+                if (m_mapping == nullptr) { return false; }
+
+                m_data = static_cast<const char*>(m_mapping);
+                return true;
+
+#else
+                return ReadFile(path);
+#endif
+            }
+
+            std::string_view Data() const noexcept { return { m_data, m_size }; }
+
+        private:
+            const char* m_data = nullptr;
+            size_t m_size = 0;
+#if defined(CPPJSON_MMAP_POSIX)
+            void* m_mapping = nullptr;
+            size_t m_mapping_size = 0;
+#elif defined(CPPJSON_MMAP_WIN32)
+            void* m_mapping = nullptr;
+#endif
+            std::unique_ptr<char[]> m_buffer;
+
+            //------------------------------------------------------------------------------------------------
+
+            static const char* EmptyData() {
+                static const char padding[Padding] = {};
+                return padding;
+            }
+
+            //------------------------------------------------------------------------------------------------
+
+            // Fallback that copies the file into a padded buffer.
+            bool ReadFile(const char* path) {
+                std::FILE* file = std::fopen(path, "rb");
+                if (file == nullptr) { return false; }
+
+                m_buffer.reset();
+                size_t capacity = 0;
+                m_size = 0;
+                for (;;) {
+                    if (m_size == capacity) {
+                        capacity = std::max<size_t>(capacity * 2, 1 << 16);
+                        std::unique_ptr<char[]> buffer(new char[capacity + Padding]);
+                        if (m_size != 0) { std::memcpy(buffer.get(), m_buffer.get(), m_size); }
+                        m_buffer = std::move(buffer);
+                    }
+                    size_t read = std::fread(m_buffer.get() + m_size, 1, capacity - m_size, file);
+                    if (read == 0) { break; }
+                    m_size += read;
+                }
+
+                bool ok = std::ferror(file) == 0;
+                std::fclose(file);
+                std::memset(m_buffer.get() + m_size, 0, Padding);
+                m_data = m_buffer.get();
+                return ok;
+            }
+        };
+
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+    //--------------------------------------------------------------------------------------------------------
+    //--------------------------------------------------------------------------------------------------------
+    
+    // What the parser should do after a hook.  Hooks passed to `SimpleReader` by reference may return this
+    // instead of `bool`, where `true` is `Continue` and `false` is `Fail`.
+    enum class HookResult {
+        Continue,   // Parse the value as usual.
+        Skip,       // Skip the array, object or member value without tokenizing it or invoking any hooks.  Only
+                    // `OnArrayStart()`, `OnObjectStart()` and `OnObjectKey()` can skip; elsewhere this is the
+                    // same as `Continue`.
+        Stop,       // End parsing successfully.
+        Fail        // End parsing with an error.
+    };
+
+    //--------------------------------------------------------------------------------------------------------
+
+    // Options for the parsers.  A `bool` converts to options with only `IgnoreComments` set, so the parsers
+    // can still be passed the `ignore_comments` flag alone.
+    struct ParseOptions {
+        static constexpr size_t DefaultMaxDepth = detail::ScopeStack::InlineDepth;
+
+        ParseOptions(bool ignore_comments = false) noexcept
+          : IgnoreComments(ignore_comments)
+        { }
+
+        // Whether C-style comments are skipped rather than rejected.
+        bool IgnoreComments;
+        // Whether the contents of strings and keys must be valid UTF-8.  This is checked as each string is
+        // scanned, rather than in a separate pass over the input.
+        bool ValidateUtf8 = false;
+        // The deepest nesting of arrays and objects that is accepted.  The parsers don't recurse, but a
+        // `JsonValue` is destroyed and written recursively, so this also bounds their use of the stack.
+        size_t MaxDepth = DefaultMaxDepth;
+        // Whether `ObjectReader` counts the elements of every array in a SIMD pre-pass, so that each
+        // `JsonArray` is allocated at its exact size rather than grown.  The pre-pass is shared with the
+        // index built by `ParseIndexed()`.  Ignored with `IgnoreComments`, as comments can't be indexed.
+        bool PresizeArrays = false;
+        // A pool through which `ObjectReader` interns object keys and short string values, or null to copy
+        // every string.  `NdjsonReader` gives each batch a pool of its own with the same `MaxValueSize()` and
+        // `MaxSize()` instead, as batches are parsed in parallel.
+        StringPool* Strings = nullptr;
+        // Whether `ObjectReader` keeps the members of each object in the order they appear in the input, with
+        // `KeyOrder::Insertion`, rather than sorted by key.  `ObjectWriter` then writes them in that order too.
+        bool PreserveKeyOrder = false;
+    };
+
+    //--------------------------------------------------------------------------------------------------------
+
+    class ISimpleReaderHooks {
+    public:
+        virtual ~ISimpleReaderHooks() = default;
+
+        virtual bool OnNull() = 0;
+        virtual bool OnBool(bool value) = 0;
+        virtual bool OnInt(int64_t value) = 0;
+        virtual bool OnUInt(uint64_t value) = 0;
+        virtual bool OnReal(double value) = 0;
+        virtual bool OnString(std::string_view value) = 0;
+
+        virtual bool OnArrayStart() = 0;
+        virtual bool OnArrayEnd() = 0;
+
+        virtual bool OnObjectStart() = 0;
+        virtual bool OnObjectKey(std::string_view value) = 0;
+        virtual bool OnObjectEnd() = 0;
+    };
+
+    //--------------------------------------------------------------------------------------------------------
+
+    // A copy of a string followed by `Padding` zero bytes, for use with the `ParsePadded()` functions.
+    class PaddedString {
+    public:
+        static constexpr size_t Padding = 64;
+
+        explicit PaddedString(std::string_view data)
+          : m_data(new char[data.size() + Padding]),
+            m_size(data.size())
+        {
+            std::memcpy(m_data.get(), data.data(), data.size());
+            std::memset(m_data.get() + data.size(), 0, Padding);
+        }
+
+        const char* Data() const noexcept { return m_data.get(); }
+        size_t Size() const noexcept { return m_size; }
+        std::string_view View() const noexcept { return { m_data.get(), m_size }; }
+
+        operator std::string_view() const noexcept { return View(); }
+
+    private:
+        std::unique_ptr<char[]> m_data;
+        size_t m_size;
+    };
+
+    //--------------------------------------------------------------------------------------------------------
+
+    class SimpleReader {
+    public:
+        static bool Parse(
+            std::string_view data,
+            ISimpleReaderHooks*const hooks,
+            const ParseOptions& options = ParseOptions()
+        ) {
+            return Parse(data, *hooks, options);
+        }
+
+        // As above, but calls the hooks directly so they can be inlined into the parser.  `THooks` must
+        // provide the same members as `ISimpleReaderHooks`, though they need not be virtual, and may return a
+        // `HookResult`.  Skipped values are only checked for balanced brackets and terminated strings.
+        // Passing an `ISimpleReaderHooks` reference dispatches each call virtually.
+        template <typename THooks>
+        static bool Parse(
+            std::string_view data,
+            THooks& hooks,
+            const ParseOptions& options = ParseOptions()
+        ) {
+            return ParseRange(data, data.data() + data.size(), hooks, options);
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        // As `Parse()`, but `data` must be followed by at least `PaddedString::Padding` readable bytes, such as
+        // those of a `PaddedString`.  Their contents don't matter.  The whitespace, string and comment kernels
+        // may then read whole vectors past the end of the data instead of finishing each search with a narrower
+        // loop.  Literals and numbers are still bounds checked as in `Parse()`, since with arbitrary padding a
+        // token could otherwise run on into it.
+        static bool ParsePadded(
+            std::string_view data,
+            ISimpleReaderHooks*const hooks,
+            const ParseOptions& options = ParseOptions()
+        ) {
+            return ParsePadded(data, *hooks, options);
+        }
+
+        template <typename THooks>
+        static bool ParsePadded(
+            std::string_view data,
+            THooks& hooks,
+            const ParseOptions& options = ParseOptions()
+        ) {
+            return ParseRange(data, data.data() + data.size() + PaddedString::Padding, hooks, options);
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        // Parses the file at `path`, which is memory mapped rather than copied where the platform supports
+        // it.  Strings passed to the hooks point into the mapping and are only valid until the hook returns.
+        // Returns false if the file can't be read.
+        static bool ParseFile(
+            const std::string& path,
+            ISimpleReaderHooks*const hooks,
+            const ParseOptions& options = ParseOptions()
+        ) {
+            return ParseFile(path, *hooks, options);
+        }
+
+        template <typename THooks>
+        static bool ParseFile(
+            const std::string& path,
+            THooks& hooks,
+            const ParseOptions& options = ParseOptions()
+        ) {
+            static_assert(detail::MappedFile::Padding >= PaddedString::Padding);
+            detail::MappedFile file;
+            if (!file.Open(path.c_str())) { return false; }
+            return ParsePadded(file.Data(), hooks, options);
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        // Parses `data` in two stages.  The first stage classifies the whole buffer in 64-byte blocks to
+        // build an index of structural characters, the second walks that index invoking the same hooks
+        // as `Parse()`.  This is considerably faster for large documents.  Comments are not supported by
+        // the first stage, so `IgnoreComments` falls back to `Parse()`, as do inputs of 4 GiB or more, which
+        // are too large to index.
+        static bool ParseIndexed(
+            std::string_view data,
+            ISimpleReaderHooks*const hooks,
+            const ParseOptions& options = ParseOptions()
+        ) {
+            return ParseIndexed(data, *hooks, options);
+        }
+
+        template <typename THooks>
+        static bool ParseIndexed(
+            std::string_view data,
+            THooks& hooks,
+            const ParseOptions& options = ParseOptions()
+        ) {
+            if (options.IgnoreComments || !detail::StructuralIndex::CanIndex(data.size())) {
+                return Parse(data, hooks, options);
+            }
+
+            detail::StructuralIndex index;
+            if (!index.Build(data)) { return false; }
+            return ParseIndexed(data, index, hooks, options);
+        }
+
+    private:
+        friend class StreamingReader;
+        friend class NdjsonReader;
+        friend class SequenceReader;
+        friend class ObjectReader;
+        friend class JsonLazyValue;
+
+        // Parses `data` by walking `index`, which must have been built from it.
+        template <typename THooks>
+        static bool ParseIndexed(
+            std::string_view data,
+            const detail::StructuralIndex& index,
+            THooks& hooks,
+            const ParseOptions& options
+        ) {
+            HookState<THooks> state{
+                {
+                    false,
+                    data.data(),
+                    data.data() + data.size(),
+                    detail::ActiveScanKernels(),
+                    options.ValidateUtf8,
+                    options.MaxDepth
+                },
+                hooks
+            };
+            return WalkStructuralIndex(state, index) || state.Stopped;
+        }
+
+        struct State {
+            const bool IgnoreComments;
+            const char* NextChar;
+            const char*const End;
+            const detail::ScanKernels& Kernels;
+            const bool ValidateUtf8 = false;
+            const size_t MaxDepth = ParseOptions::DefaultMaxDepth;
+            // How far the scanning kernels may read, which is past `End` if the input is padded.  Anything they
+            // find beyond `End` is treated as the end of the input.
+            const char*const ScanEnd = End;
+            bool Stopped = false;       // Set when a hook returns `HookResult::Stop`.
+            std::string Scratch;        // Holds strings with escape sequences once they are decoded.
+
+            bool Eof() const noexcept { return NextChar >= End; }
+            size_t BytesRemaining() const noexcept { return std::distance(NextChar, End); }
+        };
+
+        template <typename THooks>
+        struct HookState : State {
+            THooks& Hooks;
+        };
+
+        //----------------------------------------------------------------------------------------------------
+
+        // Parses `data`, letting the scanning kernels read up to `scan_end`.
+        template <typename THooks>
+        static bool ParseRange(std::string_view data, const char* scan_end, THooks& hooks, const ParseOptions& options) {
+            HookState<THooks> state{
+                {
+                    options.IgnoreComments,
+                    data.data(),
+                    data.data() + data.size(),
+                    detail::ActiveScanKernels(),
+                    options.ValidateUtf8,
+                    options.MaxDepth,
+                    scan_end
+                },
+                hooks
+            };
+            return ParseValue(state) || state.Stopped;
+        }
+
+        // As `ParseRange()`, but fails if anything other than whitespace or comments follows the value.
+        template <typename THooks>
+        static bool ParseComplete(std::string_view data, const char* scan_end, THooks& hooks, const ParseOptions& options) {
+            HookState<THooks> state{
+                {
+                    options.IgnoreComments,
+                    data.data(),
+                    data.data() + data.size(),
+                    detail::ActiveScanKernels(),
+                    options.ValidateUtf8,
+                    options.MaxDepth,
+                    scan_end
+                },
+                hooks
+            };
+            return (ParseValue(state) && SkipCommentsAndWhitespace(state) && state.Eof()) || state.Stopped;
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        // Parses the value at `NextChar`.  Rather than recursing into arrays and objects, the open containers
+        // are kept on an explicit stack so that deeply nested documents can't overflow the call stack.
+        template <typename THooks>
+        static bool ParseValue(HookState<THooks>& state) {
+            detail::ScopeStack scopes;
+            return ParseValue(state, scopes);
+        }
+
+        // As above, but with a stack that the caller can reuse.  `scopes` must be empty.
+        template <typename THooks>
+        static bool ParseValue(HookState<THooks>& state, detail::ScopeStack& scopes) {
+            for (;;) {
+                // Read value.
+                if (!SkipCommentsAndWhitespace(state)) { return false; }
+                if (state.Eof()) { return scopes.Empty(); }
+
+                switch (*state.NextChar) {
+                case 't': if (!ParseTrue(state)) { return false; } break;
+                case 'f': if (!ParseFalse(state)) { return false; } break;
+                case 'n': if (!ParseNull(state)) { return false; } break;
+                case '"': if (!ParseString(state)) { return false; } break;
+
+                case '[':
+                case '{': {
+                    bool is_object = (*state.NextChar == '{');
+                    if (scopes.Depth() >= state.MaxDepth) { return false; }
+
+                    auto open = state.NextChar;
+                    ++state.NextChar;
+                    if (!SkipCommentsAndWhitespace(state)) { return false; }
+                    if (state.Eof()) { return false; }
+
+                    auto result = is_object
+                        ? ToHookResult(state.Hooks.OnObjectStart())
+                        : ToHookResult(state.Hooks.OnArrayStart());
+                    if (result == HookResult::Stop) { return Stop(state); }
+                    if (result == HookResult::Fail) { return false; }
+                    if (result == HookResult::Skip) {
+                        state.NextChar = open;
+                        if (!SkipValue(state)) { return false; }
+                        break;
+                    }
+
+                    if (*state.NextChar == (is_object ? '}' : ']')) {
+                        ++state.NextChar;
+                        auto end_result = is_object
+                            ? ToHookResult(state.Hooks.OnObjectEnd())
+                            : ToHookResult(state.Hooks.OnArrayEnd());
+                        if (!ShouldContinue(state, end_result)) { return false; }
+                        break;
+                    }
+
+                    scopes.Push(is_object);
+                    if (!is_object) {
+                        // Read the first element.
+                        continue;
+                    }
+
+                    auto member_result = ParseObjectMember(state);
+                    if (member_result == HookResult::Continue) { continue; }
+                    if (member_result == HookResult::Stop) { return Stop(state); }
+                    if (member_result == HookResult::Fail) { return false; }
+                    break;
+                }
+
+                default: if (!ParseNumber(state)) { return false; } break;
+                }
+
+                // The value is complete, so read separators until another value is due.
+                for (;;) {
+                    if (scopes.Empty()) { return true; }
+
+                    if (!SkipCommentsAndWhitespace(state)) { return false; }
+                    if (state.Eof()) { return false; }
+
+                    char c = *state.NextChar++;
+                    if (c == ',') {
+                        if (!scopes.InObject()) { break; }
+
+                        if (!SkipCommentsAndWhitespace(state)) { return false; }
+                        if (state.Eof()) { return false; }
+
+                        auto member_result = ParseObjectMember(state);
+                        if (member_result == HookResult::Continue) { break; }
+                        if (member_result == HookResult::Stop) { return Stop(state); }
+                        if (member_result == HookResult::Fail) { return false; }
+                    } else if (c == ']' && !scopes.InObject()) {
+                        scopes.Pop();
+                        if (!ShouldContinue(state, state.Hooks.OnArrayEnd())) { return false; }
+                    } else if (c == '}' && scopes.InObject()) {
+                        scopes.Pop();
+                        if (!ShouldContinue(state, state.Hooks.OnObjectEnd())) { return false; }
+                    } else {
+                        return false;
+                    }
+                }
+            }
+        }
+
+
+        //----------------------------------------------------------------------------------------------------
+
+        template <typename THooks>
+        static bool WalkStructuralIndex(HookState<THooks>& state, const detail::StructuralIndex& index) {
+            enum class Expect {
+                Value,
+                ObjectKey,
+                Separator
+            };
+
+            const char* data = state.NextChar;
+            const uint32_t* next = index.begin();
+            const uint32_t* last = index.end();
+
+            detail::ScopeStack scopes;
+            Expect expect = Expect::Value;
+
+            if (next == last) {
+                // Only whitespace.
+                return true;
+            }
+
+            for (;;) {
+                switch (expect) {
+                case Expect::Value: {
+                    if (next == last) { return false; }
+                    uint32_t offset = *next++;
+
+                    switch (data[offset]) {
+                    case '[':
+                        if (scopes.Depth() >= state.MaxDepth) { return false; }
+                        switch (ToHookResult(state.Hooks.OnArrayStart())) {
+                        case HookResult::Continue: break;
+                        case HookResult::Skip:
+                            next = SkipIndexedContainer(data, next, last);
+                            if (next == nullptr) { return false; }
+                            expect = Expect::Separator;
+                            continue;
+                        case HookResult::Stop: return Stop(state);
+                        case HookResult::Fail: return false;
+                        }
+                        if (next != last && data[*next] == ']') {
+                            ++next;
+                            if (!ShouldContinue(state, state.Hooks.OnArrayEnd())) { return false; }
+                            expect = Expect::Separator;
+                        } else {
+                            scopes.Push(false);
+                        }
+                        break;
+
+                    case '{':
+                        if (scopes.Depth() >= state.MaxDepth) { return false; }
+                        switch (ToHookResult(state.Hooks.OnObjectStart())) {
+                        case HookResult::Continue: break;
+                        case HookResult::Skip:
+                            next = SkipIndexedContainer(data, next, last);
+                            if (next == nullptr) { return false; }
+                            expect = Expect::Separator;
+                            continue;
+                        case HookResult::Stop: return Stop(state);
+                        case HookResult::Fail: return false;
+                        }
+                        if (next != last && data[*next] == '}') {
+                            ++next;
+                            if (!ShouldContinue(state, state.Hooks.OnObjectEnd())) { return false; }
+                            expect = Expect::Separator;
+                        } else {
+                            scopes.Push(true);
+                            expect = Expect::ObjectKey;
+                        }
+                        break;
+
+                    case '"': {
+                        // Quotes are always indexed in pairs.
+                        uint32_t end_offset = *next++;
+                        auto value = std::string_view(data + offset + 1, end_offset - offset - 1);
+                        if (!UnescapeIndexed(state, value)) { return false; }
+                        if (!ShouldContinue(state, state.Hooks.OnString(value))) { return false; }
+                        expect = Expect::Separator;
+                        break;
+                    }
+
+                    case ']':
+                    case '}':
+                    case ',':
+                    case ':':
+                        return false;
+
+                    default:
+                        state.NextChar = data + offset;
+                        if (!ParseScalar(state)) { return false; }
+                        if (!scopes.Empty() && !IsIndexedScalarEnd(state)) { return false; }
+                        expect = Expect::Separator;
+                        break;
+                    }
+                    break;
+                }
+
+                case Expect::ObjectKey: {
+                    if (next == last || data[*next] != '"') { return false; }
+                    uint32_t offset = *next++;
+                    uint32_t end_offset = *next++;
+
+                    auto key = std::string_view(data + offset + 1, end_offset - offset - 1);
+                    if (!UnescapeIndexed(state, key)) { return false; }
+                    auto result = ToHookResult(state.Hooks.OnObjectKey(key));
+                    if (result == HookResult::Stop) { return Stop(state); }
+                    if (result == HookResult::Fail) { return false; }
+
+                    if (next == last || data[*next] != ':') { return false; }
+                    ++next;
+                    expect = Expect::Value;
+
+                    if (result == HookResult::Skip) {
+                        if (next == last) { return false; }
+                        uint32_t value_offset = *next++;
+                        switch (data[value_offset]) {
+                        case '[':
+                        case '{':
+                            next = SkipIndexedContainer(data, next, last);
+                            if (next == nullptr) { return false; }
+                            break;
+                        case '"':
+                            ++next;
+                            break;
+                        case ']':
+                        case '}':
+                        case ',':
+                        case ':':
+                            return false;
+                        default: {
+                            // Scalars are still parsed, as by `Parse()`, so that a skipped value must be valid.
+                            SkipHooks skip_hooks;
+                            HookState<SkipHooks> skip_state{
+                                { false, data + value_offset, state.End, state.Kernels },
+                                skip_hooks
+                            };
+                            if (!ParseScalar(skip_state) || !IsIndexedScalarEnd(skip_state)) { return false; }
+                            break;
+                        }
+                        }
+                        expect = Expect::Separator;
+                    }
+                    break;
+                }
+
+                case Expect::Separator: {
+                    if (scopes.Empty()) {
+                        // The root value is complete.
+                        return true;
+                    }
+                    if (next == last) { return false; }
+
+                    char c = data[*next++];
+                    if (c == ',') {
+                        expect = scopes.InObject() ? Expect::ObjectKey : Expect::Value;
+                    } else if (c == ']' && !scopes.InObject()) {
+                        scopes.Pop();
+                        if (!ShouldContinue(state, state.Hooks.OnArrayEnd())) { return false; }
+                    } else if (c == '}' && scopes.InObject()) {
+                        scopes.Pop();
+                        if (!ShouldContinue(state, state.Hooks.OnObjectEnd())) { return false; }
+                    } else {
+                        return false;
+                    }
+                    break;
+                }
+                }
+            }
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        // Whether the scalar just parsed within a container is followed by whitespace or a separator, as the
+        // index only records where each token starts.
+        static bool IsIndexedScalarEnd(const State& state) {
+            if (state.Eof()) { return true; }
+            char c = *state.NextChar;
+            bool is_separator = (c == ',') || (c == ']') || (c == '}');
+            return is_separator || detail::IsWhitespace(c);
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        // Returns the entry after the bracket that closes the container opened by the entry before `next`, or
+        // nullptr if there isn't one.
+        static const uint32_t* SkipIndexedContainer(const char* data, const uint32_t* next, const uint32_t* last) {
+            size_t depth = 1;
+            while (next != last) {
+                char c = data[*next++];
+                if (c == '[' || c == '{') {
+                    ++depth;
+                } else if ((c == ']' || c == '}') && --depth == 0) {
+                    return next;
+                }
+            }
+            return nullptr;
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        template <typename THooks>
+        static bool ParseScalar(HookState<THooks>& state) {
+            switch (*state.NextChar) {
+            case 't': return ParseTrue(state);
+            case 'f': return ParseFalse(state);
+            case 'n': return ParseNull(state);
+            default: return ParseNumber(state);
+            }
+        }
+        //----------------------------------------------------------------------------------------------------
+
+        static void SkipWhitespace(State& state) {
+            // Fast checks for no whitespace, or the single space of a separator, before using the kernel.
+            if (state.Eof() || !detail::IsWhitespace(*state.NextChar)) { return; }
+            ++state.NextChar;
+            if (state.Eof() || !detail::IsWhitespace(*state.NextChar)) { return; }
+
+            state.NextChar = std::min(state.Kernels.SkipWhitespace(state.NextChar + 1, state.ScanEnd), state.End);
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        // Finds the closing quote of the string at `NextChar`.  Returns whether the string has any escape
+        // sequences.  If `ValidateUtf8` is set then invalid UTF-8 is treated as an unterminated string.
+        static bool ScanString(State& state) {
+            // Most strings are short, so try a few characters inline before using the kernel.  Non-ASCII
+            // characters are left to the kernel when they need checking.
+            const char* inline_end = state.NextChar + std::min<size_t>(state.BytesRemaining(), 16);
+            const bool validate_utf8 = state.ValidateUtf8;
+            for (; state.NextChar < inline_end; ++state.NextChar) {
+                char c = *state.NextChar;
+                if (c == '"') { return false; }
+                if (c == '\\' || (validate_utf8 && static_cast<uint8_t>(c) >= 0x80)) { break; }
+            }
+
+            bool has_escapes = false;
+            for (;;) {
+                if (state.ValidateUtf8) {
+                    auto next = state.Kernels.FindQuoteOrEscapeUtf8(state.NextChar, state.ScanEnd);
+                    state.NextChar = (next != nullptr) ? std::min(next, state.End) : state.End;
+                } else {
+                    state.NextChar = std::min(state.Kernels.FindQuoteOrEscape(state.NextChar, state.ScanEnd), state.End);
+                }
+                if (state.Eof() || *state.NextChar == '"') {
+                    return has_escapes;
+                }
+
+                // Skip the escape character and the character it escapes.
+                has_escapes = true;
+                if (state.BytesRemaining() <= 2) {
+                    state.NextChar = state.End;
+                    return has_escapes;
+                }
+                state.NextChar += 2;
+            }
+        }
+
+        // Decodes any escape sequences in `value` into the scratch buffer.  Strings without any are passed to
+        // the hooks straight from the input.
+        static bool Unescape(State& state, std::string_view& value) {
+            return detail::UnescapeString(value, state.Scratch, state.Kernels);
+        }
+
+        // As above, for strings found by the structural index, which doesn't record whether they have any
+        // escape sequences.  Also checks the string is valid UTF-8 if `ValidateUtf8` is set.
+        static bool UnescapeIndexed(State& state, std::string_view& value) {
+            auto last = value.data() + value.size();
+            if (!state.ValidateUtf8) {
+                if (state.Kernels.FindChar(value.data(), last, '\\') == last) { return true; }
+                return Unescape(state, value);
+            }
+
+            // Searching on to the end of the input lets the kernel use whole vectors.  The first unescaped quote
+            // is the one that closes the string, at `last`.
+            bool has_escapes = false;
+            for (auto next = value.data();;) {
+                next = state.Kernels.FindQuoteOrEscapeUtf8(next, state.End);
+                if (next == nullptr) { return false; }
+                if (next >= last) { break; }
+                has_escapes = true;
+                next += 2;
+            }
+            return !has_escapes || Unescape(state, value);
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        // Reads four characters as a little endian word.
+        static uint32_t ReadWord(const char* chars) {
+            uint32_t word;
+            std::memcpy(&word, chars, sizeof(word));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+            word = ((word & 0xFF) << 24) | ((word & 0xFF00) << 8) | ((word >> 8) & 0xFF00) | (word >> 24);
+#endif
+            return word;
+        }
+
+        template <typename THooks>
+        static bool ParseTrue(HookState<THooks>& state) {
+            if (state.BytesRemaining() < 4) { return false; }
+
+            if (ReadWord(state.NextChar) == 0x65757274) {
+                state.NextChar += 4;
+                return ShouldContinue(state, state.Hooks.OnBool(true));
+            }
+            return false;
+        }
+
+        template <typename THooks>
+        static bool ParseFalse(HookState<THooks>& state) {
+            if (state.BytesRemaining() < 5) { return false; }
+
+            if (ReadWord(state.NextChar + 1) == 0x65736C61) {
+                state.NextChar += 5;
+                return ShouldContinue(state, state.Hooks.OnBool(false));
+            }
+            return false;
+        }
+
+        template <typename THooks>
+        static bool ParseNull(HookState<THooks>& state) {
+            if (state.BytesRemaining() < 4) { return false; }
+
+            if (ReadWord(state.NextChar) == 0x6C6C756E) {
+                state.NextChar += 4;
+                return ShouldContinue(state, state.Hooks.OnNull());
+            }
+            return false;
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        template <typename THooks>
+        static bool ParseString(HookState<THooks>& state) {
+            ++state.NextChar;
+            if (state.Eof()) { return false; }
+
+            const char* string_start = state.NextChar;
+            bool has_escapes = ScanString(state);
+            if (state.Eof()) { return false; }
+
+            std::string_view value(string_start, std::distance(string_start, state.NextChar));
+            ++state.NextChar;
+            if (has_escapes && !Unescape(state, value)) { return false; }
+            return ShouldContinue(state, state.Hooks.OnString(value));
+        }
+
+        template <typename THooks>
+        static HookResult ParseObjectKey(HookState<THooks>& state) {
+            ++state.NextChar;
+            if (state.Eof()) { return HookResult::Fail; }
+
+            const char* string_start = state.NextChar;
+            bool has_escapes = ScanString(state);
+            if (state.Eof()) { return HookResult::Fail; }
+
+            std::string_view key(string_start, std::distance(string_start, state.NextChar));
+            ++state.NextChar;
+            if (has_escapes && !Unescape(state, key)) { return HookResult::Fail; }
+            return ToHookResult(state.Hooks.OnObjectKey(key));
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        // Reads the key at `NextChar` and the colon after it.  Returns `HookResult::Continue` if the member's
+        // value should be read next, or `HookResult::Skip` if the key hook asked for it to be skipped and it
+        // has been.
+        template <typename THooks>
+        static HookResult ParseObjectMember(HookState<THooks>& state) {
+            if (*state.NextChar != '"') { return HookResult::Fail; }
+            auto result = ParseObjectKey(state);
+            if (result == HookResult::Stop || result == HookResult::Fail) { return result; }
+
+            if (!SkipCommentsAndWhitespace(state)) { return HookResult::Fail; }
+            if (state.Eof()) { return HookResult::Fail; }
+
+            // Read separator.
+            if (*state.NextChar != ':') { return HookResult::Fail; }
+            ++state.NextChar;
+
+            if (!SkipCommentsAndWhitespace(state)) { return HookResult::Fail; }
+            if (state.Eof()) { return HookResult::Fail; }
+
+            if (result == HookResult::Skip && !SkipValue(state)) { return HookResult::Fail; }
+            return result;
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        template <typename TResult>
+        static HookResult ToHookResult(TResult result) {
+            if constexpr (std::is_same_v<TResult, bool>) {
+                return result ? HookResult::Continue : HookResult::Fail;
+            } else {
+                return result;
+            }
+        }
+
+        // Returns whether to carry on after a hook that can't skip, for which `HookResult::Skip` is the same
+        // as `Continue`.
+        template <typename TResult>
+        static bool ShouldContinue(State& state, TResult result) {
+            switch (ToHookResult(result)) {
+            case HookResult::Stop: return Stop(state);
+            case HookResult::Fail: return false;
+            default: return true;
+            }
+        }
+
+        // Unwinds the parser after a hook returned `HookResult::Stop`.  The public functions report success
+        // when `Stopped` is set.
+        static bool Stop(State& state) {
+            state.Stopped = true;
+            return false;
+        }
+
+        // Hooks that accept everything, for skipping values that have to be tokenized.
+        struct SkipHooks {
+            bool OnNull() { return true; }
+            bool OnBool(bool) { return true; }
+            bool OnInt(int64_t) { return true; }
+            bool OnUInt(uint64_t) { return true; }
+            bool OnReal(double) { return true; }
+            bool OnString(std::string_view) { return true; }
+
+            bool OnArrayStart() { return true; }
+            bool OnArrayEnd() { return true; }
+
+            bool OnObjectStart() { return true; }
+            bool OnObjectKey(std::string_view) { return true; }
+            bool OnObjectEnd() { return true; }
+        };
+
+        // Skips the value at `NextChar` without invoking any hooks.  Arrays and objects are skipped by counting
+        // brackets, unless comments are enabled because they may contain brackets.  Scalars are short enough
+        // that they're simply parsed.
+        static bool SkipValue(State& state) {
+            char c = *state.NextChar;
+            if ((c == '[' || c == '{') && !state.IgnoreComments) {
+                auto end = detail::FindContainerEnd(state.NextChar, state.End, state.Kernels);
+                if (end == nullptr) { return false; }
+                state.NextChar = end;
+                return true;
+            }
+
+            SkipHooks hooks;
+            HookState<SkipHooks> skip_state{
+                {
+                    state.IgnoreComments,
+                    state.NextChar,
+                    state.End,
+                    state.Kernels,
+                    false,
+                    state.MaxDepth
+                },
+                hooks
+            };
+            if (!ParseValue(skip_state)) { return false; }
+            state.NextChar = skip_state.NextChar;
+            return true;
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        template <typename THooks>
+        static bool ParseNumber(HookState<THooks>& state) {
+            auto number_start = state.NextChar;
+            bool is_negative = *state.NextChar == '-';
             if (is_negative) { ++state.NextChar; }
 
-            if (state.Eof()) { return false; }
+            // Integer part.  Digits are accumulated as they are scanned; the result is only used when there are
+            // no more than 19 of them, so wrapping is harmless.
+            auto start = state.NextChar;
+            uint64_t mantissa = ScanDigits(state, 0);
+            auto integer_digits = state.NextChar - start;
+            if (integer_digits == 0) { return false; }
+
+            bool is_double = false;
+            int64_t exponent = 0;
+            int64_t fraction_digits = 0;
+            if (!state.Eof() && *state.NextChar == '.') {
+                is_double = true;
+                auto fraction_start = ++state.NextChar;
+                mantissa = ScanDigits(state, mantissa);
+                fraction_digits = state.NextChar - fraction_start;
+                if (fraction_digits == 0) { return false; }
+                exponent = -fraction_digits;
+            }
+
+            if (!state.Eof() && (*state.NextChar == 'e' || *state.NextChar == 'E')) {
+                is_double = true;
+                ++state.NextChar;
+                bool is_negative_exponent = false;
+                if (!state.Eof() && (*state.NextChar == '-' || *state.NextChar == '+')) {
+                    is_negative_exponent = *state.NextChar == '-';
+                    ++state.NextChar;
+                }
+                auto exponent_start = state.NextChar;
+                int64_t exponent_value = 0;
+                while (!state.Eof() && IsDigit(*state.NextChar)) {
+                    // Anything this large is already out of range, so stop accumulating before it can overflow.
+                    if (exponent_value < 0x10000) {
+                        exponent_value = exponent_value * 10 + (*state.NextChar - '0');
+                    }
+                    ++state.NextChar;
+                }
+                if (state.NextChar == exponent_start) { return false; }
+                exponent += is_negative_exponent ? -exponent_value : exponent_value;
+            }
+
+            if (is_double) {
+                double value;
+                if (!ParseDouble(number_start, state.NextChar, start, integer_digits + fraction_digits, mantissa, exponent, is_negative, value)) {
+                    return false;
+                }
+                return ShouldContinue(state, state.Hooks.OnReal(value));
+                
+            } else {
+                uint64_t value = mantissa;
+                if (integer_digits > 19 && !ParseLongInteger(start, state.NextChar, value)) {
+                    // Overflow saturates, as strtoull does.
+                    value = std::numeric_limits<uint64_t>::max();
+                }
+                if (is_negative) {
+                    auto limit = static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) + 1;
+                    if (value > limit) {
+                        // Underflow.
+                        return false;
+                    }
+                    return ShouldContinue(state, state.Hooks.OnInt(-static_cast<int64_t>(value)));
+                } else {
+                    return ShouldContinue(state, state.Hooks.OnUInt(value));
+                }
+            }
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        static bool IsDigit(char c) {
+            return c >= '0' && c <= '9';
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        // Accumulates the run of digits at `NextChar` onto `value`, eight at a time where possible.  The result
+        // wraps if there are more than 19 digits in total.
+        static uint64_t ScanDigits(State& state, uint64_t value) {
+#if !defined(__BYTE_ORDER__) || (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+            while (state.BytesRemaining() >= 8) {
+                uint64_t chunk;
+                std::memcpy(&chunk, state.NextChar, sizeof(chunk));
+                if (!detail::IsEightDigits(chunk)) { break; }
+                value = value * 100000000 + detail::ParseEightDigits(chunk);
+                state.NextChar += 8;
+            }
+#endif
+            while (!state.Eof() && IsDigit(*state.NextChar)) {
+                value = value * 10 + static_cast<uint64_t>(*state.NextChar - '0');
+                ++state.NextChar;
+            }
+            return value;
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        // Converts the digits in `[first, last)` when there are too many for `ScanDigits` to be sure it didn't
+        // wrap.  Returns false on overflow.
+        static bool ParseLongInteger(const char* first, const char* last, uint64_t& value) {
+            while (first < last && *first == '0') { ++first; }
+
+            constexpr size_t MaxDigits = 20;
+            auto digits = static_cast<size_t>(last - first);
+            if (digits > MaxDigits) { return false; }
+
+            value = 0;
+            for (; first < last; ++first) {
+                auto digit = static_cast<uint64_t>(*first - '0');
+                if (value > (std::numeric_limits<uint64_t>::max() - digit) / 10) { return false; }
+                value = value * 10 + digit;
+            }
+            return true;
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        // Converts a scanned real number.  `digits_start` points at the first of `digit_count` mantissa digits
+        // (possibly split by a '.'), `mantissa` holds their value if there are no more than 19 of them and
+        // `exponent` is the power of ten that applies to it.
+        static bool ParseDouble(
+            const char* number_start,
+            const char* number_end,
+            const char* digits_start,
+            int64_t digit_count,
+            uint64_t mantissa,
+            int64_t exponent,
+            bool is_negative,
+            double& value
+        ) {
+            constexpr int64_t MaxDigits = 19;
+
+            if (digit_count > MaxDigits) {
+                // Leading zeros don't contribute to the mantissa.
+                auto c = digits_start;
+                while (c < number_end && (*c == '0' || *c == '.')) {
+                    if (*c == '0') { --digit_count; }
+                    ++c;
+                }
+
+                if (digit_count > MaxDigits) {
+                    // Too many digits to hold exactly.  Keep the first 19 and try both roundings of what was
+                    // dropped; if they agree the result is correct.
+                    mantissa = 0;
+                    for (int64_t taken = 0; taken < MaxDigits; ++c) {
+                        if (*c != '.') {
+                            mantissa = mantissa * 10 + static_cast<uint64_t>(*c - '0');
+                            ++taken;
+                        }
+                    }
+                    exponent += digit_count - MaxDigits;
+
+                    double rounded_up;
+                    if (
+                        detail::DecimalToDouble::Convert(mantissa, exponent, is_negative, value) &&
+                        detail::DecimalToDouble::Convert(mantissa + 1, exponent, is_negative, rounded_up) &&
+                        value == rounded_up
+                    ) {
+                        return true;
+                    }
+                    value = detail::ParseDoubleExact(number_start, number_end, exponent > 0);
+                    return true;
+                }
+            }
+
+            if (!detail::DecimalToDouble::Convert(mantissa, exponent, is_negative, value)) {
+                value = detail::ParseDoubleExact(number_start, number_end, exponent > 0);
+            }
+            return true;
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        static bool SkipCommentsAndWhitespace(State& state) {
+            while (!state.Eof()) {
+                SkipWhitespace(state);
+
+                if (state.Eof() || *state.NextChar != '/') {
+                    return true;
+                }
+                if (!ParseComment(state)) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        static bool ParseComment(State& state) {
+            if (!state.IgnoreComments) {
+                return false;
+            }
+
+            ++state.NextChar;
+            if (state.Eof()) {
+                return false;
+            }
+
+            if (*state.NextChar == '/') {
+                // Single line comment
+                ++state.NextChar;
+                ScanEndOfLine(state);
+                return true;
+
+            } else if (*state.NextChar == '*') {
+                // Multi-line comment
+                ++state.NextChar;
+                return ScanEndOfMultilineComment(state);
+
+            } else {
+                // Invalid.
+                return false;
+            }
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        static void ScanEndOfLine(State& state) {
+            state.NextChar = std::min(state.Kernels.FindChar(state.NextChar, state.ScanEnd, '\n'), state.End);
+            if (!state.Eof()) {
+                ++state.NextChar;
+            }
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        static bool ScanEndOfMultilineComment(State& state) {
+            for (;;) {
+                state.NextChar = std::min(state.Kernels.FindChar(state.NextChar, state.ScanEnd, '*'), state.End);
+                if (state.Eof()) {
+                    return false;
+                }
+
+                ++state.NextChar;
+                if (!state.Eof() && *state.NextChar == '/') {
+                    ++state.NextChar;
+                    return true;
+                }
+            }
+        }
+    };
+
+    //--------------------------------------------------------------------------------------------------------
+
+    // A push parser for documents that arrive in pieces.  Each call to `Feed()` parses as much of the chunk
+    // as it can and invokes the same hooks as `SimpleReader::Parse()`.  Strings, numbers, literals and
+    // comments may be split anywhere across chunks; only the part of a token that straddles a boundary is
+    // copied, so memory use is bounded by the largest token and the nesting depth rather than the size of
+    // the document.  Documents nested deeper than `ParseOptions::MaxDepth` are rejected.  Chunks need not
+    // outlive the call to `Feed()`.
+    class StreamingReader {
+    public:
+        explicit StreamingReader(ISimpleReaderHooks*const hooks, bool ignore_comments = false)
+          : StreamingReader(hooks, ParseOptions(ignore_comments))
+        { }
+
+        // Only `IgnoreComments`, `ValidateUtf8` and `MaxDepth` apply.  Strings and keys split across chunks
+        // are checked once they are complete.
+        StreamingReader(ISimpleReaderHooks*const hooks, const ParseOptions& options)
+          : m_hooks(*hooks),
+            m_ignore_comments(options.IgnoreComments),
+            m_validate_utf8(options.ValidateUtf8),
+            m_max_depth(options.MaxDepth),
+            m_kernels(detail::ActiveScanKernels())
+        { }
+
+        // Parses the next chunk of the document.  Returns false if the input is invalid or a hook returned
+        // false, after which all further calls fail.  Anything after the end of the top level value is
+        // ignored.
+        bool Feed(std::string_view chunk) {
+            if (m_expect == Expect::Failed) { return false; }
+            if (!ParseChunk(chunk.data(), chunk.data() + chunk.size())) {
+                m_expect = Expect::Failed;
+                return false;
+            }
+            return true;
+        }
+
+        // Signals the end of the input.  Returns true if a complete top level value was parsed.  A number at
+        // the top level can't be completed until this is called.
+        bool Finish() {
+            if (m_expect == Expect::Failed) { return false; }
+
+            bool ok = true;
+            if (m_token == Token::Number) {
+                ok = CompleteNumber(nullptr, nullptr);
+            } else if (m_token != Token::None && m_token != Token::LineComment) {
+                ok = false;
+            }
+            m_token = Token::None;
+
+            if (!ok || m_expect != Expect::Done) {
+                m_expect = Expect::Failed;
+                return false;
+            }
+            return true;
+        }
+
+        // Whether the top level value has been parsed in full.
+        bool IsComplete() const noexcept { return m_expect == Expect::Done; }
+
+    private:
+        enum class Expect : uint8_t {
+            Value,
+            ValueOrArrayEnd,
+            ObjectKey,
+            ObjectKeyOrEnd,
+            Colon,
+            SeparatorOrEnd,
+            Done,
+            Failed
+        };
+
+        // A token that was still open at the end of the previous chunk.
+        enum class Token : uint8_t {
+            None,
+            String,
+            ObjectKey,
+            Number,
+            Literal,
+            CommentStart,
+            LineComment,
+            BlockComment,
+            BlockCommentStar
+        };
+
+        ISimpleReaderHooks& m_hooks;
+        const bool m_ignore_comments;
+        const bool m_validate_utf8;
+        const size_t m_max_depth;
+        const detail::ScanKernels& m_kernels;
+
+        Expect m_expect = Expect::Value;
+        Token m_token = Token::None;
+        detail::ScopeStack m_scopes;
+
+        // The part of an open string or number seen in earlier chunks.
+        std::string m_buffer;
+        bool m_escape_pending = false;
+        bool m_has_escapes = false;
+        // Strings with escape sequences are decoded into here.
+        std::string m_scratch;
+        // The literal being matched, and how many of its characters have been seen.
+        const char* m_literal = nullptr;
+        size_t m_literal_matched = 0;
+
+        //----------------------------------------------------------------------------------------------------
+
+        bool ParseChunk(const char* next, const char* end) {
+            // An open token continues from the start of the chunk.
+            if (m_token != Token::None) {
+                next = ContinueToken(next, next, end);
+                if (next == nullptr) { return false; }
+            }
+
+            while (next < end) {
+                // Most tokens are separated by at most a single space, so only use the kernel for longer runs.
+                if (detail::IsWhitespace(*next)) {
+                    ++next;
+                    if (next < end && detail::IsWhitespace(*next)) {
+                        next = m_kernels.SkipWhitespace(next, end);
+                    }
+                    if (next == end) { break; }
+                }
+
+                char c = *next;
+                if (m_expect == Expect::Done) {
+                    // Trailing content is ignored, as by `SimpleReader`.
+                    return true;
+                }
+                if (c == '/') {
+                    if (!m_ignore_comments) { return false; }
+                    m_token = Token::CommentStart;
+                    next = ContinueToken(next + 1, next + 1, end);
+                    if (next == nullptr) { return false; }
+                    continue;
+                }
+
+                switch (m_expect) {
+                case Expect::ValueOrArrayEnd:
+                    if (c == ']') {
+                        if (!EndScope()) { return false; }
+                        ++next;
+                        break;
+                    }
+                    // Fall through.
+
+                case Expect::Value:
+                    next = StartValue(next, end);
+                    if (next == nullptr) { return false; }
+                    break;
+
+                case Expect::ObjectKeyOrEnd:
+                    if (c == '}') {
+                        if (!EndScope()) { return false; }
+                        ++next;
+                        break;
+                    }
+                    // Fall through.
+
+                case Expect::ObjectKey:
+                    if (c != '"') { return false; }
+                    m_token = Token::ObjectKey;
+                    next = ContinueToken(next + 1, next + 1, end);
+                    if (next == nullptr) { return false; }
+                    break;
+
+                case Expect::Colon:
+                    if (c != ':') { return false; }
+                    m_expect = Expect::Value;
+                    ++next;
+                    break;
+
+                case Expect::SeparatorOrEnd:
+                    if (c == ',') {
+                        m_expect = m_scopes.InObject() ? Expect::ObjectKey : Expect::Value;
+                    } else if (c == (m_scopes.InObject() ? '}' : ']')) {
+                        if (!EndScope()) { return false; }
+                    } else {
+                        return false;
+                    }
+                    ++next;
+                    break;
+
+                default:
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        const char* StartValue(const char* next, const char* end) {
+            switch (*next) {
+            case '{':
+                if (m_scopes.Depth() >= m_max_depth) { return nullptr; }
+                if (!m_hooks.OnObjectStart()) { return nullptr; }
+                m_scopes.Push(true);
+                m_expect = Expect::ObjectKeyOrEnd;
+                return next + 1;
+
+            case '[':
+                if (m_scopes.Depth() >= m_max_depth) { return nullptr; }
+                if (!m_hooks.OnArrayStart()) { return nullptr; }
+                m_scopes.Push(false);
+                m_expect = Expect::ValueOrArrayEnd;
+                return next + 1;
+
+            case '"':
+                m_token = Token::String;
+                return ContinueToken(next + 1, next + 1, end);
+
+            case 't': m_literal = "true"; break;
+            case 'f': m_literal = "false"; break;
+            case 'n': m_literal = "null"; break;
+
+            default:
+                m_token = Token::Number;
+                return ContinueToken(next, next, end);
+            }
+
+            m_token = Token::Literal;
+            m_literal_matched = 0;
+            return ContinueToken(next, next, end);
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        // Continues the open token from `next`, where `start` is where the token (or this chunk's part of
+        // it) begins.  Returns the position after the token, `end` if the token is still open, or nullptr on
+        // error.
+        const char* ContinueToken(const char* start, const char* next, const char* end) {
+            switch (m_token) {
+            case Token::String:
+            case Token::ObjectKey:
+                return ContinueString(start, next, end);
+
+            case Token::Number:
+                while (next < end && IsNumberChar(*next)) { ++next; }
+                if (next == end) {
+                    m_buffer.append(start, end);
+                    return end;
+                }
+                return CompleteNumber(start, next) ? next : nullptr;
+
+            case Token::Literal:
+                for (; next < end; ++next) {
+                    if (m_literal[m_literal_matched] == '\0') { break; }
+                    if (*next != m_literal[m_literal_matched]) { return nullptr; }
+                    ++m_literal_matched;
+                }
+                if (m_literal[m_literal_matched] != '\0') { return end; }
+                m_token = Token::None;
+                return CompleteLiteral() ? next : nullptr;
+
+            case Token::CommentStart:
+                if (next == end) { return end; }
+                if (*next == '/') {
+                    m_token = Token::LineComment;
+                } else if (*next == '*') {
+                    m_token = Token::BlockComment;
+                } else {
+                    return nullptr;
+                }
+                return ContinueToken(next + 1, next + 1, end);
+
+            case Token::LineComment:
+                next = m_kernels.FindChar(next, end, '\n');
+                if (next == end) { return end; }
+                m_token = Token::None;
+                return next + 1;
+
+            case Token::BlockCommentStar:
+                if (next == end) { return end; }
+                if (*next == '/') {
+                    m_token = Token::None;
+                    return next + 1;
+                }
+                m_token = Token::BlockComment;
+                if (*next == '*') { return ContinueToken(next, next, end); }
+                return ContinueToken(next + 1, next + 1, end);
+
+            case Token::BlockComment:
+                next = m_kernels.FindChar(next, end, '*');
+                if (next == end) { return end; }
+                m_token = Token::BlockCommentStar;
+                return ContinueToken(next + 1, next + 1, end);
+
+            default:
+                return nullptr;
+            }
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        const char* ContinueString(const char* start, const char* next, const char* end) {
+            if (m_escape_pending && next < end) {
+                // The previous chunk ended with a backslash.
+                m_escape_pending = false;
+                ++next;
+            }
+
+            for (;;) {
+                next = m_kernels.FindQuoteOrEscape(next, end);
+                if (next == end) {
+                    m_buffer.append(start, end);
+                    return end;
+                }
+
+                if (*next == '"') { break; }
+
+                // Skip the escaped character, which may be in the next chunk.
+                m_has_escapes = true;
+                if (end - next < 2) {
+                    m_buffer.append(start, end);
+                    m_escape_pending = true;
+                    return end;
+                }
+                next += 2;
+            }
+
+            // Strings that fit in one chunk are passed straight from it.
+            std::string_view value(start, static_cast<size_t>(next - start));
+            if (!m_buffer.empty()) {
+                m_buffer.append(start, next);
+                value = m_buffer;
+            }
+            if (m_validate_utf8 && !IsValidUtf8(value)) { return nullptr; }
+            if (m_has_escapes) {
+                m_has_escapes = false;
+                if (!detail::UnescapeString(value, m_scratch, m_kernels)) { return nullptr; }
+            }
+
+            bool ok;
+            if (m_token == Token::ObjectKey) {
+                ok = m_hooks.OnObjectKey(value);
+                m_expect = Expect::Colon;
+            } else {
+                ok = m_hooks.OnString(value);
+                EndValue();
+            }
+
+            m_buffer.clear();
+            m_token = Token::None;
+            return ok ? next + 1 : nullptr;
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        // Checks the contents of a complete string, before its escape sequences are decoded.  A multi-byte
+        // sequence may have been split across chunks, so this can't be done as each chunk is scanned.
+        bool IsValidUtf8(std::string_view value) const {
+            const char* last = value.data() + value.size();
+            for (const char* next = value.data();;) {
+                next = m_kernels.FindQuoteOrEscapeUtf8(next, last);
+                if (next == nullptr) { return false; }
+                if (next == last) { return true; }
+                // Skip the escape sequence, which `UnescapeString()` will check.
+                next += 2;
+            }
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        // Parses the number made up of anything buffered plus `[start, next)`.
+        bool CompleteNumber(const char* start, const char* next) {
+            if (!m_buffer.empty()) {
+                m_buffer.append(start, next);
+                start = m_buffer.data();
+                next = start + m_buffer.size();
+            }
+
+            SimpleReader::HookState<ISimpleReaderHooks> state{
+                { false, start, next, m_kernels },
+                m_hooks
+            };
+            bool ok = SimpleReader::ParseNumber(state) && state.Eof();
+
+            m_buffer.clear();
+            m_token = Token::None;
+            EndValue();
+            return ok;
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        bool CompleteLiteral() {
+            bool ok;
+            switch (m_literal[0]) {
+            case 't': ok = m_hooks.OnBool(true); break;
+            case 'f': ok = m_hooks.OnBool(false); break;
+            default: ok = m_hooks.OnNull(); break;
+            }
+            EndValue();
+            return ok;
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        bool EndScope() {
+            bool ok = m_scopes.InObject() ? m_hooks.OnObjectEnd() : m_hooks.OnArrayEnd();
+            m_scopes.Pop();
+            EndValue();
+            return ok;
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        void EndValue() {
+            m_expect = m_scopes.Empty() ? Expect::Done : Expect::SeparatorOrEnd;
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        static bool IsNumberChar(char c) {
+            return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+        }
+    };
+
+    //--------------------------------------------------------------------------------------------------------
+
+    class ObjectReader final :
+        private ISimpleReaderHooks
+    {
+    public:
+        // A reader can be kept to parse many documents with `Parse(data, out)`, reusing its buffers each time.
+        ObjectReader() {
+            m_stack.resize(16);
+        }
+
+        // Parses `data` into `out`.  The arrays, object members and long strings of the value `out` held
+        // before are taken apart and reused for the new value, so parsing documents of a similar shape into
+        // the same value allocates nothing once the first has been parsed.  Returns false and leaves `out`
+        // null if the input is invalid.
+        bool Parse(std::string_view data, JsonValue& out, const ParseOptions& options = ParseOptions()) {
+            m_resource = std::pmr::get_default_resource();
+            Recycle(out);
+            Reset();
+            Prepare(data, options);
+            if (!SimpleReader::Parse(data, *this, options) || m_stack_top != -1 || !m_has_top_value) {
+                return false;
+            }
+            out = std::move(m_stack[0].Value);
+            return true;
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        static std::optional<JsonValue> Parse(std::string_view data, const ParseOptions& options = ParseOptions()) {
+            ObjectReader parser;
+            parser.Prepare(data, options);
+            if (!SimpleReader::Parse(data, parser, options)) {
+                return std::nullopt;
+            }
+            return parser.TakeValue();
+        }
+
+        // As above, but every array, object and long string in the value is allocated from `resource`.  With a
+        // `std::pmr::monotonic_buffer_resource` the tree is built by bump allocation, and destroying it frees
+        // nothing until the resource itself is released.  The resource must outlive the value; copies of it use
+        // the default resource instead.  Strings interned through `ParseOptions::Strings` belong to the pool.
+        static std::optional<JsonValue> Parse(
+            std::string_view data,
+            std::pmr::memory_resource* resource,
+            const ParseOptions& options = ParseOptions()
+        ) {
+            ObjectReader parser;
+            parser.m_resource = resource;
+            parser.Prepare(data, options);
+            if (!SimpleReader::Parse(data, parser, options)) {
+                return std::nullopt;
+            }
+            return parser.TakeValue();
+        }
+
+        static std::optional<JsonValue> ParseIndexed(std::string_view data, const ParseOptions& options = ParseOptions()) {
+            ObjectReader parser;
+            parser.SetOptions(options);
+            if (options.IgnoreComments || !options.PresizeArrays || !detail::StructuralIndex::CanIndex(data.size())) {
+                if (!SimpleReader::ParseIndexed(data, parser, options)) {
+                    return std::nullopt;
+                }
+                return parser.TakeValue();
+            }
+
+            // Build the index here so that the arrays can be counted from it too.
+            if (!parser.m_index.Build(data)) { return std::nullopt; }
+            detail::CountArrayElements(data.data(), parser.m_index, parser.m_array_sizes);
+            if (!SimpleReader::ParseIndexed(data, parser.m_index, parser, options)) {
+                return std::nullopt;
+            }
+            return parser.TakeValue();
+        }
+
+        // As `Parse()`, but `data` must be followed by at least `PaddedString::Padding` readable bytes.  See
+        // `SimpleReader::ParsePadded()`.
+        static std::optional<JsonValue> ParsePadded(std::string_view data, const ParseOptions& options = ParseOptions()) {
+            ObjectReader parser;
+            parser.Prepare(data, options);
+            if (!SimpleReader::ParsePadded(data, parser, options)) {
+                return std::nullopt;
+            }
+            return parser.TakeValue();
+        }
+
+        // Parses the file at `path` without first copying it into memory.  Returns `std::nullopt` if the file
+        // can't be read or is invalid.
+        static std::optional<JsonValue> ParseFile(const std::string& path, const ParseOptions& options = ParseOptions()) {
+            detail::MappedFile file;
+            if (!file.Open(path.c_str())) { return std::nullopt; }
+            return ParsePadded(file.Data(), options);
+        }
+
+        // Parses only the values at `paths`, which are JSON Pointers where a `*` token matches any member or
+        // array element.  Objects and arrays on the way to a selected value are kept, even if it turns out not
+        // to exist, so the result has the same shape as the document.  Unselected array elements are dropped
+        // rather than left as gaps.  Everything else is skipped without being materialized, and parsing stops
+        // as soon as every path without a wildcard has been found.  Returns null if the root is a scalar that
+        // isn't selected.  Throws `std::invalid_argument` if a path isn't a valid JSON Pointer.
+        static std::optional<JsonValue> ParsePaths(
+            std::string_view data,
+            const std::vector<std::string_view>& paths,
+            const ParseOptions& options = ParseOptions()
+        );
+
+    private:
+        class Projection;
+
+        friend class NdjsonReader;
+        friend class SequenceReader;
+
+        // Prepares to parse another value, keeping the stack's storage.
+        void Reset() noexcept {
+            m_has_top_value = false;
+            m_stack_top = -1;
+            m_array_sizes.clear();
+            m_next_array = 0;
+        }
+
+        // Takes the string pool and key order from `options`.
+        void SetOptions(const ParseOptions& options) {
+            m_strings = options.Strings;
+            m_key_order = options.PreserveKeyOrder ? KeyOrder::Insertion : KeyOrder::Sorted;
+        }
+
+        // Takes the options as above and, with `ParseOptions::PresizeArrays`, counts the elements of each array
+        // in `data` so that they can be allocated at their exact sizes.
+        void Prepare(std::string_view data, const ParseOptions& options) {
+            SetOptions(options);
+            if (!options.PresizeArrays || options.IgnoreComments) { return; }
+            if (m_index.Build(data)) {
+                detail::CountArrayElements(data.data(), m_index, m_array_sizes);
+            }
+        }
+
+        std::optional<JsonValue> TakeValue() {
+            if (m_stack_top != -1) { return std::nullopt; }
+            if (!m_has_top_value) { return std::nullopt; }
+            return std::make_optional(std::move(m_stack[0].Value));
+        }
+
+        struct Node {
+            JsonValue Value;
+            std::string ObjectKey;
+            bool Unsorted = false;      // An object's keys were not all parsed in ascending order.
+        };
+
+        bool m_has_top_value = false;
+        int m_stack_top = -1;
+        std::vector<Node> m_stack;
+
+        // The number of elements in each array, in the order they start, if they were counted in advance.
+        detail::StructuralIndex m_index;
+        std::vector<uint32_t> m_array_sizes;
+        size_t m_next_array = 0;
+
+        // Interns keys and short strings, if `ParseOptions::Strings` is set.
+        StringPool* m_strings = nullptr;
+        // The order in which the members of each object are kept.
+        KeyOrder m_key_order = KeyOrder::Sorted;
+        // Allocates the arrays, objects and strings of the value.
+        std::pmr::memory_resource* m_resource = std::pmr::get_default_resource();
+
+        // Storage taken from previously parsed values, to be reused for the next.  Arrays and objects are kept
+        // as empty values, so that their out of line storage is reused too.
+        std::vector<JsonValue> m_spare_arrays;
+        std::vector<JsonValue> m_spare_objects;
+        std::vector<JsonString> m_spare_strings;
+
+        //----------------------------------------------------------------------------------------------------
+
+        // Takes apart `value`, keeping its arrays, objects and any strings or keys too long to be stored
+        // inline.  Arrays and objects shared with a copy of the value, or allocated from a resource other than
+        // `m_resource`, are released instead.  Leaves `value` null.
+        void Recycle(JsonValue& value) {
+            switch (value.m_type) {
+            case JsonValueType::String:
+                if (!value.IsInlineString()) {
+                    m_spare_strings.push_back(value.TakeString());
+                }
+                break;
+
+            case JsonValueType::Array: {
+                auto& json_array = value.ArrayData();
+                if (value.IsShared() || json_array.get_allocator().resource() != m_resource) { break; }
+                for (auto& element : json_array) {
+                    Recycle(element);
+                }
+                json_array.clear();
+                m_spare_arrays.push_back(std::move(value));
+                return;
+            }
+
+            case JsonValueType::Object: {
+                auto& json_object = value.ObjectData();
+                if (value.IsShared() || json_object.get_allocator().resource() != m_resource) { break; }
+                for (auto& member : json_object) {
+                    if (!member.first.IsInline()) {
+                        m_spare_strings.push_back(std::move(member.first));
+                    }
+                    Recycle(member.second);
+                }
+                json_object.clear();
+                m_spare_objects.push_back(std::move(value));
+                return;
+            }
+
+            default:
+                break;
+            }
+            value = JsonValue();
+        }
+
+        JsonValue MakeArray() {
+            JsonValue json_array = TakeSpare(m_spare_arrays, JsonValueType::Array);
+            if (m_next_array < m_array_sizes.size()) {
+                json_array.ArrayData().reserve(m_array_sizes[m_next_array++]);
+            }
+            return json_array;
+        }
+
+        JsonValue MakeObject() {
+            JsonValue json_object = TakeSpare(m_spare_objects, JsonValueType::Object);
+            json_object.ObjectData().Reset(m_key_order);
+            return json_object;
+        }
+
+        JsonValue TakeSpare(std::vector<JsonValue>& spares, JsonValueType type) {
+            if (spares.empty()) {
+                return JsonValue(type, m_resource);
+            }
+            JsonValue value = std::move(spares.back());
+            spares.pop_back();
+            return value;
+        }
+
+        JsonValue MakeString(std::string_view value) {
+            if (m_strings) {
+                return JsonValue(m_strings->InternValue(value));
+            }
+            if (value.size() <= JsonString::InlineCapacity) {
+                return JsonValue(value, m_resource);
+            }
+            return JsonValue(MakeSpareString(value));
+        }
+
+        JsonString MakeKey(std::string_view value) {
+            if (m_strings) {
+                return m_strings->Intern(value);
+            }
+            return MakeSpareString(value);
+        }
+
+        // Copies `value` into a spare string if one can be reused.  Only strings that aren't shared with the
+        // pool or another value can be overwritten.
+        JsonString MakeSpareString(std::string_view value) {
+            while (!m_spare_strings.empty() && value.size() > JsonString::InlineCapacity) {
+                JsonString string = std::move(m_spare_strings.back());
+                m_spare_strings.pop_back();
+                if (string.TryReuse(value, m_resource)) {
+                    return string;
+                }
+            }
+            return JsonString(value, m_resource);
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        Node& AllocateNode() {
+            if (m_stack_top + 1 == static_cast<int>(m_stack.size())) {
+                m_stack.resize(m_stack.size() + 16);
+            }
+            ++m_stack_top;
+            return m_stack[m_stack_top];
+        }
+
+        bool SetValue(JsonValue&& value) {
+            if (m_stack_top == -1) {
+                if (m_has_top_value) {
+                    return false;
+                }
+
+                m_stack[0].Value = std::forward<JsonValue>(value);
+                m_has_top_value = true;
+                return true;
+            }
+
+            return SetValue(m_stack[m_stack_top], std::forward<JsonValue>(value));
+        }
+
+        bool SetValue(Node& parent, JsonValue&& value) {
+            auto& parent_value = parent.Value;
+            if (parent_value.Type() == JsonValueType::Array) {
+                auto& json_array = parent_value.ArrayData();
+                json_array.emplace_back(std::forward<JsonValue>(value));
+                return true;
+            }
+
+            if (parent_value.Type() == JsonValueType::Object) {
+                auto& json_object = parent_value.ObjectData();
+                std::string_view object_key = parent.ObjectKey;
+                if (json_object.Order() == KeyOrder::Insertion) {
+                    // Duplicate keys are found as they are parsed, and only the first is kept.
+                    if (json_object.find(object_key) == json_object.end()) {
+                        json_object.Append(MakeKey(object_key), std::forward<JsonValue>(value));
+                    } else {
+                        Recycle(value);
+                    }
+                    return true;
+                }
+
+                // Sorted members are appended as they are parsed, and only sorted at the end of the object if a
+                // key was out of order, which also catches duplicate keys.
+                if (!json_object.empty() && (json_object.end() - 1)->first.View() >= object_key) {
+                    parent.Unsorted = true;
+                }
+                json_object.Append(MakeKey(object_key), std::forward<JsonValue>(value));
+                return true;
+            }
+
+            return false;
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        bool OnNull() override {
+            return SetValue(JsonValue());
+        }
+        bool OnBool(bool value) override {
+            return SetValue(JsonValue(value));
+        }
+        bool OnInt(intmax_t value) override {
+            return SetValue(JsonValue(value));
+        }
+        bool OnUInt(uintmax_t value) override {
+            return SetValue(JsonValue(value));
+        }
+        bool OnReal(double value) override {
+            return SetValue(JsonValue(value));
+        }
+        bool OnString(std::string_view value) override {
+            return SetValue(MakeString(value));
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        bool OnArrayStart() override {
+            if (m_stack_top == -1) {
+                if (m_has_top_value) {
+                    return false;
+                }
+                m_has_top_value = true;
+            }
+
+            auto& node = AllocateNode();
+            node.Value = MakeArray();
+            return true;
+        }
+        bool OnArrayEnd() override {
+            if (m_stack_top < 0) { return false; }
+            if (m_stack_top == 0) {
+                --m_stack_top;
+                return true;
+            }
+
+            auto& array_node = m_stack[m_stack_top];
+            auto& parent_node = m_stack[m_stack_top - 1];
+            if (!SetValue(parent_node, std::move(array_node.Value))) { return false; }
+            --m_stack_top;
+            return true;
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        bool OnObjectStart() override {
+            if (m_stack_top == -1) {
+                if (m_has_top_value) {
+                    return false;
+                }
+                m_has_top_value = true;
+            }
+
+            auto& node = AllocateNode();
+            node.Value = MakeObject();
+            node.Unsorted = false;
+            return true;
+        }
+        bool OnObjectKey(std::string_view value) override {
+            auto& object_node = m_stack[m_stack_top];
+            object_node.ObjectKey = value;
+            return true;
+        }
+        bool OnObjectEnd() override {
+            if (m_stack_top < 0) { return false; }
+
+            auto& object_node = m_stack[m_stack_top];
+            if (object_node.Unsorted) {
+                object_node.Value.ObjectData().SortMembers();
+            }
+            if (m_stack_top == 0) {
+                --m_stack_top;
+                return true;
+            }
+
+            auto& parent_node = m_stack[m_stack_top - 1];
+            if (!SetValue(parent_node, std::move(object_node.Value))) { return false; }
+            --m_stack_top;
+            return true;
+        }
+
+        friend class SimpleReader;
+    };
+
+    //--------------------------------------------------------------------------------------------------------
+
+    // Forwards the `SimpleReader` events for values selected by a set of JSON Pointers to an `ObjectReader`,
+    // and skips the rest.  The pointers are compiled into a trie.  A `*` token can overlap with the other
+    // tokens at the same level, so each value is matched by a set of trie nodes rather than a single one.
+    class ObjectReader::Projection {
+    public:
+        Projection(const std::vector<std::string_view>& paths, const ParseOptions& options) {
+            m_reader.SetOptions(options);
+            m_nodes.emplace_back();
+            for (auto path : paths) {
+                AddPath(path);
+            }
+
+            // A path that starts with a wildcard could match until the end of the document.
+            m_can_stop = m_remaining != 0 && !m_nodes[0].Target;
+
+            // The root value matches the root node.
+            m_states.push_back(0);
+        }
+
+        std::optional<JsonValue> TakeValue() {
+            if (!m_reader.m_has_top_value) { return JsonValue(); }
+            return m_reader.TakeValue();
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        HookResult OnNull() { return OnScalar([&]() { return m_reader.OnNull(); }); }
+        HookResult OnBool(bool value) { return OnScalar([&]() { return m_reader.OnBool(value); }); }
+        HookResult OnInt(int64_t value) { return OnScalar([&]() { return m_reader.OnInt(value); }); }
+        HookResult OnUInt(uint64_t value) { return OnScalar([&]() { return m_reader.OnUInt(value); }); }
+        HookResult OnReal(double value) { return OnScalar([&]() { return m_reader.OnReal(value); }); }
+        HookResult OnString(std::string_view value) { return OnScalar([&]() { return m_reader.OnString(value); }); }
+
+        HookResult OnArrayStart() { return OnContainerStart(true); }
+        HookResult OnArrayEnd() { return OnContainerEnd(true); }
+
+        HookResult OnObjectStart() { return OnContainerStart(false); }
+        HookResult OnObjectEnd() { return OnContainerEnd(false); }
+
+        HookResult OnObjectKey(std::string_view value) {
+            if (m_selected_depth != 0) { return ToResult(m_reader.OnObjectKey(value)); }
+
+            auto& frame = m_frames.back();
+            m_states.resize(frame.StatesEnd);
+            Match(frame, value, NoIndex);
+            if (m_states.size() == frame.StatesEnd) { return HookResult::Skip; }
+
+            return ToResult(m_reader.OnObjectKey(value));
+        }
+
+    private:
+        static constexpr uint32_t NoNode = std::numeric_limits<uint32_t>::max();
+        static constexpr uint64_t NoIndex = std::numeric_limits<uint64_t>::max();
+
+        struct Child {
+            std::string Token;
+            uint64_t Index;             // The token as an array index, or `NoIndex`.
+            uint32_t Node;
+        };
+
+        struct PathNode {
+            std::vector<Child> Children;
+            uint32_t Wildcard = NoNode;
+            bool Selected = false;      // A path ends here, so the whole value is kept.
+            bool Target = false;        // The end of the part of a path before any wildcard.
+            bool Finished = false;
+        };
+
+        // An array or object that has been forwarded to the reader, and the trie nodes it matched.
+        struct Frame {
+            size_t StatesBegin;
+            size_t StatesEnd;
+            uint64_t Index;
+            bool IsArray;
+        };
+
+        std::vector<PathNode> m_nodes;
+
+        // The trie nodes of each frame in turn, followed by those of the value that is starting.
+        std::vector<uint32_t> m_states;
+        std::vector<Frame> m_frames;
+
+        // The depth within a selected array or object, where every event is forwarded.
+        size_t m_selected_depth = 0;
+
+        // The number of targets that haven't been finished.
+        size_t m_remaining = 0;
+        bool m_can_stop = false;
+
+        ObjectReader m_reader;
+
+        //----------------------------------------------------------------------------------------------------
+
+        void AddPath(std::string_view path) {
+            if (!path.empty() && path[0] != '/') {
+                throw std::invalid_argument("Invalid JSON Pointer");
+            }
+
+            uint32_t node = 0;
+            uint32_t target = 0;
+            bool has_wildcard = false;
+            for (size_t start = 1; start <= path.size();) {
+                size_t slash = std::min(path.find('/', start), path.size());
+                auto token = path.substr(start, slash - start);
+                start = slash + 1;
+
+                if (token == "*") {
+                    node = AddWildcard(node);
+                    has_wildcard = true;
+                } else {
+                    node = AddChild(node, Unescape(token));
+                    if (!has_wildcard) { target = node; }
+                }
+            }
+
+            m_nodes[node].Selected = true;
+            if (!m_nodes[target].Target) {
+                m_nodes[target].Target = true;
+                ++m_remaining;
+            }
+        }
+
+        uint32_t AddWildcard(uint32_t parent) {
+            if (m_nodes[parent].Wildcard == NoNode) {
+                m_nodes[parent].Wildcard = static_cast<uint32_t>(m_nodes.size());
+                m_nodes.emplace_back();
+            }
+            return m_nodes[parent].Wildcard;
+        }
+
+        uint32_t AddChild(uint32_t parent, std::string token) {
+            for (auto& child : m_nodes[parent].Children) {
+                if (child.Token == token) { return child.Node; }
+            }
+
+            auto node = static_cast<uint32_t>(m_nodes.size());
+            auto index = ToIndex(token);
+            m_nodes[parent].Children.push_back({ std::move(token), index, node });
+            m_nodes.emplace_back();
+            return node;
+        }
+
+        static std::string Unescape(std::string_view token) {
+            std::string result;
+            for (size_t i = 0; i < token.size(); ++i) {
+                if (token[i] != '~') {
+                    result += token[i];
+                } else if (i + 1 < token.size() && (token[i + 1] == '0' || token[i + 1] == '1')) {
+                    result += (token[++i] == '0') ? '~' : '/';
+                } else {
+                    throw std::invalid_argument("Invalid JSON Pointer");
+                }
+            }
+            return result;
+        }
+
+        // Array indices are digits without leading zeros.
+        static uint64_t ToIndex(std::string_view token) {
+            if (token.empty() || token.size() > 19 || (token[0] == '0' && token.size() > 1)) { return NoIndex; }
+
+            uint64_t index = 0;
+            for (char c : token) {
+                if (c < '0' || c > '9') { return NoIndex; }
+                index = index * 10 + static_cast<uint64_t>(c - '0');
+            }
+            return index;
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        static HookResult ToResult(bool ok) {
+            return ok ? HookResult::Continue : HookResult::Fail;
+        }
+
+        // Appends the children of `frame`'s nodes that match the member `key`, or the element at `index` if
+        // it isn't `NoIndex`.
+        void Match(const Frame& frame, std::string_view key, uint64_t index) {
+            for (size_t i = frame.StatesBegin; i < frame.StatesEnd; ++i) {
+                const auto& node = m_nodes[m_states[i]];
+                for (const auto& child : node.Children) {
+                    bool matches = (index == NoIndex) ? (child.Token == key) : (child.Index == index);
+                    if (matches) { m_states.push_back(child.Node); }
+                }
+                if (node.Wildcard != NoNode) { m_states.push_back(node.Wildcard); }
+            }
+        }
+
+        // Matches the value that is starting, leaving its nodes at the end of `m_states` from the returned
+        // offset.  Members were already matched by `OnObjectKey()`.
+        size_t BeginValue() {
+            if (m_frames.empty()) { return 0; }
+
+            auto& frame = m_frames.back();
+            if (frame.IsArray) {
+                m_states.resize(frame.StatesEnd);
+                Match(frame, std::string_view(), frame.Index++);
+            }
+            return frame.StatesEnd;
+        }
+
+        bool IsSelected(size_t begin, size_t end) const {
+            for (size_t i = begin; i < end; ++i) {
+                if (m_nodes[m_states[i]].Selected) { return true; }
+            }
+            return false;
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        template <typename TForward>
+        HookResult OnScalar(TForward forward) {
+            if (m_selected_depth != 0) { return ToResult(forward()); }
+
+            size_t begin = BeginValue();
+            size_t end = m_states.size();
+            if (IsSelected(begin, end) && !forward()) { return HookResult::Fail; }
+            return Finish(begin, end);
+        }
+
+        HookResult OnContainerStart(bool is_array) {
+            if (m_selected_depth != 0) {
+                ++m_selected_depth;
+                return ToResult(is_array ? m_reader.OnArrayStart() : m_reader.OnObjectStart());
+            }
+
+            size_t begin = BeginValue();
+            size_t end = m_states.size();
+            if (begin == end) { return HookResult::Skip; }
+
+            if (!(is_array ? m_reader.OnArrayStart() : m_reader.OnObjectStart())) { return HookResult::Fail; }
+            if (IsSelected(begin, end)) { m_selected_depth = 1; }
+            m_frames.push_back({ begin, end, 0, is_array });
+            return HookResult::Continue;
+        }
+
+        HookResult OnContainerEnd(bool is_array) {
+            if (!(is_array ? m_reader.OnArrayEnd() : m_reader.OnObjectEnd())) { return HookResult::Fail; }
+            if (m_selected_depth > 1) {
+                --m_selected_depth;
+                return HookResult::Continue;
+            }
+
+            m_selected_depth = 0;
+            auto frame = m_frames.back();
+            m_frames.pop_back();
+            return Finish(frame.StatesBegin, frame.StatesEnd);
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        // Called when the value that matched the nodes in [begin, end) is complete.  Assuming that keys are
+        // unique, nothing else can match these nodes or any below them, so their targets are finished.  Once
+        // every target is finished the containers that are still open are closed and parsing stops.
+        HookResult Finish(size_t begin, size_t end) {
+            if (!m_can_stop) { return HookResult::Continue; }
+
+            for (size_t i = begin; i < end; ++i) {
+                FinishNode(m_states[i]);
+            }
+            if (m_remaining != 0) { return HookResult::Continue; }
+
+            for (auto frame = m_frames.rbegin(); frame != m_frames.rend(); ++frame) {
+                if (!(frame->IsArray ? m_reader.OnArrayEnd() : m_reader.OnObjectEnd())) { return HookResult::Fail; }
+            }
+            m_frames.clear();
+            return HookResult::Stop;
+        }
+
+        void FinishNode(uint32_t index) {
+            auto& node = m_nodes[index];
+            if (node.Finished) { return; }
+
+            node.Finished = true;
+            if (node.Target) { --m_remaining; }
+
+            // Targets are never below a wildcard.
+            for (const auto& child : node.Children) {
+                FinishNode(child.Node);
+            }
+        }
+    };
+
+    //--------------------------------------------------------------------------------------------------------
+
+    inline std::optional<JsonValue> ObjectReader::ParsePaths(
+        std::string_view data,
+        const std::vector<std::string_view>& paths,
+        const ParseOptions& options
+    ) {
+        Projection projection(paths, options);
+        if (!SimpleReader::Parse(data, projection, options)) {
+            return std::nullopt;
+        }
+        return projection.TakeValue();
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    // Parses newline delimited JSON (NDJSON / JSON Lines), where each line holds one complete value.  The
+    // input is split into batches of whole lines which are parsed in parallel on worker threads.  Results
+    // are always delivered on the calling thread, either in input order or as each batch completes.  Lines
+    // that fail to parse are reported and skipped; blank lines are ignored.
+    class NdjsonReader {
+    public:
+        struct Options : ParseOptions {
+            // Number of worker threads, or 0 to use one per hardware thread.
+            size_t ThreadCount = 0;
+            // Whether results are delivered in input order.  Otherwise batches are delivered as they
+            // complete, though lines within a batch are still in order.
+            bool Ordered = true;
+            // Approximate number of bytes per batch.  Batches always end on a line boundary.
+            size_t BatchSize = 1 << 20;
+        };
+
+        // Calls `on_record(JsonValue&& value, std::string_view line)` for each value and
+        // `on_error(std::string_view line)` for each malformed line.  `line` is a view into `data`.
+        template <typename TOnRecord, typename TOnError>
+        static void Parse(
+            std::string_view data,
+            TOnRecord&& on_record,
+            TOnError&& on_error,
+            const Options& options = Options()
+        ) {
+            struct Line {
+                std::string_view Text;
+                std::optional<JsonValue> Value;
+            };
+
+            auto parse_batch = [&options](std::string_view batch) {
+                std::vector<Line> lines;
+                const char* batch_end = batch.data() + batch.size();
+                ObjectReader parser;
+                parser.SetOptions(options);
+
+                // Batches are parsed in parallel, so each has a pool of its own rather than sharing one.
+                std::optional<StringPool> strings;
+                if (options.Strings) {
+                    parser.m_strings = &strings.emplace(options.Strings->MaxValueSize(), options.Strings->MaxSize());
+                }
+                ForEachLine(batch, [&](std::string_view text) {
+                    // The rest of the batch follows each line, so it can be scanned as padding.
+                    parser.Reset();
+                    if (!SimpleReader::ParseComplete(text, batch_end, parser, options)) {
+                        lines.push_back({ text, std::nullopt });
+                    } else if (parser.m_has_top_value) {
+                        lines.push_back({ text, parser.TakeValue() });
+                    }
+                });
+                return lines;
+            };
+
+            auto deliver = [&](std::vector<Line>&& lines) {
+                for (auto& line : lines) {
+                    if (line.Value) {
+                        on_record(std::move(*line.Value), line.Text);
+                    } else {
+                        on_error(line.Text);
+                    }
+                }
+            };
+
+            Run<std::vector<Line>>(data, options, parse_batch, deliver);
+        }
+
+        // Parses each line with `SimpleReader` on the worker threads.  `make_hooks()` is called once per
+        // batch to create the hooks for it, which are passed to `on_batch(THooks&& hooks)` on the calling
+        // thread once the whole batch has been parsed.  The events of each line are only passed to the hooks
+        // once the whole line has parsed, so malformed lines are skipped entirely and reported to `on_error`
+        // before `on_batch` is called for their batch.  A line is also reported if a hook fails, though the
+        // hooks will have received its events up to that point.
+        template <typename TMakeHooks, typename TOnBatch, typename TOnError>
+        static void ParseWithHooks(
+            std::string_view data,
+            TMakeHooks&& make_hooks,
+            TOnBatch&& on_batch,
+            TOnError&& on_error,
+            const Options& options = Options()
+        ) {
+            using THooks = decltype(make_hooks());
+            struct Batch {
+                THooks Hooks;
+                std::vector<std::string_view> Errors;
+            };
+
+            auto parse_batch = [&](std::string_view data_batch) {
+                Batch batch{ make_hooks(), {} };
+                LineEvents events;
+                const char* batch_end = data_batch.data() + data_batch.size();
+                ForEachLine(data_batch, [&](std::string_view text) {
+                    events.Clear();
+                    if (!SimpleReader::ParseComplete(text, batch_end, events, options) || !events.Replay(batch.Hooks)) {
+                        batch.Errors.push_back(text);
+                    }
+                });
+                return batch;
+            };
+
+            auto deliver = [&](Batch&& batch) {
+                for (auto& text : batch.Errors) {
+                    on_error(text);
+                }
+                on_batch(std::move(batch.Hooks));
+            };
+
+            Run<Batch>(data, options, parse_batch, deliver);
+        }
+
+    private:
+        // Records the `SimpleReader` events of a line, so that they can be passed on to the batch's hooks once
+        // the whole line is known to be valid.  Strings are copied, as the views passed to the hooks may not
+        // outlive the call.  The buffers are kept from one line to the next.
+        class LineEvents {
+        public:
+            void Clear() noexcept {
+                m_events.clear();
+                m_text.clear();
+            }
+
+            bool OnNull() { return Add(Event::Null); }
+            bool OnBool(bool value) { return Add(Event::Bool, value ? 1 : 0); }
+            bool OnInt(int64_t value) { return Add(Event::Int, static_cast<uint64_t>(value)); }
+            bool OnUInt(uint64_t value) { return Add(Event::UInt, value); }
+            bool OnReal(double value) {
+                uint64_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                return Add(Event::Real, bits);
+            }
+            bool OnString(std::string_view value) { return AddText(Event::String, value); }
+
+            bool OnArrayStart() { return Add(Event::ArrayStart); }
+            bool OnArrayEnd() { return Add(Event::ArrayEnd); }
+
+            bool OnObjectStart() { return Add(Event::ObjectStart); }
+            bool OnObjectKey(std::string_view value) { return AddText(Event::ObjectKey, value); }
+            bool OnObjectEnd() { return Add(Event::ObjectEnd); }
+
+            // Passes the recorded events to `hooks`, acting on the results they return in the same way as
+            // `SimpleReader`.  Returns false if a hook fails.
+            template <typename THooks>
+            bool Replay(THooks& hooks) const {
+                for (size_t i = 0; i < m_events.size(); ++i) {
+                    const auto& event = m_events[i];
+                    HookResult result = HookResult::Continue;
+                    switch (event.Type) {
+                    case Event::Null: result = SimpleReader::ToHookResult(hooks.OnNull()); break;
+                    case Event::Bool: result = SimpleReader::ToHookResult(hooks.OnBool(event.Bits != 0)); break;
+                    case Event::Int: result = SimpleReader::ToHookResult(hooks.OnInt(static_cast<int64_t>(event.Bits))); break;
+                    case Event::UInt: result = SimpleReader::ToHookResult(hooks.OnUInt(event.Bits)); break;
+                    case Event::Real: {
+                        double value;
+                        std::memcpy(&value, &event.Bits, sizeof(value));
+                        result = SimpleReader::ToHookResult(hooks.OnReal(value));
+                        break;
+                    }
+                    case Event::String: result = SimpleReader::ToHookResult(hooks.OnString(Text(event))); break;
+                    case Event::ArrayStart: result = SimpleReader::ToHookResult(hooks.OnArrayStart()); break;
+                    case Event::ArrayEnd: result = SimpleReader::ToHookResult(hooks.OnArrayEnd()); break;
+                    case Event::ObjectStart: result = SimpleReader::ToHookResult(hooks.OnObjectStart()); break;
+                    case Event::ObjectKey: result = SimpleReader::ToHookResult(hooks.OnObjectKey(Text(event))); break;
+                    case Event::ObjectEnd: result = SimpleReader::ToHookResult(hooks.OnObjectEnd()); break;
+                    }
+
+                    switch (result) {
+                    case HookResult::Stop: return true;
+                    case HookResult::Fail: return false;
+                    case HookResult::Skip:
+                        // Skipping an array or object passes over its events, and skipping a key passes over
+                        // its value.  Elsewhere this is the same as `Continue`.
+                        if (event.Type == Event::ArrayStart || event.Type == Event::ObjectStart) {
+                            i = ValueEnd(i);
+                        } else if (event.Type == Event::ObjectKey) {
+                            i = ValueEnd(i + 1);
+                        }
+                        break;
+                    default:
+                        break;
+                    }
+                }
+                return true;
+            }
+
+        private:
+            enum class Event : uint8_t {
+                Null, Bool, Int, UInt, Real, String, ArrayStart, ArrayEnd, ObjectStart, ObjectKey, ObjectEnd
+            };
+
+            struct Entry {
+                Event Type;
+                uint64_t Bits;          // The value of a number or boolean, or the offset of a string's text.
+                size_t Size;            // The size of a string.
+            };
+
+            std::vector<Entry> m_events;
+            std::string m_text;
+
+            bool Add(Event type, uint64_t bits = 0) {
+                m_events.push_back({ type, bits, 0 });
+                return true;
+            }
+
+            bool AddText(Event type, std::string_view value) {
+                m_events.push_back({ type, m_text.size(), value.size() });
+                m_text += value;
+                return true;
+            }
+
+            std::string_view Text(const Entry& event) const {
+                return std::string_view(m_text.data() + event.Bits, event.Size);
+            }
+
+            // Returns the index of the last event of the value that starts with event `i`.
+            size_t ValueEnd(size_t i) const {
+                size_t depth = 0;
+                for (; i < m_events.size(); ++i) {
+                    auto type = m_events[i].Type;
+                    if (type == Event::ArrayStart || type == Event::ObjectStart) {
+                        ++depth;
+                    } else if (type == Event::ArrayEnd || type == Event::ObjectEnd) {
+                        --depth;
+                    }
+                    if (depth == 0) { break; }
+                }
+                return i;
+            }
+        };
+
+        //----------------------------------------------------------------------------------------------------
+
+        // Splits `data` into batches of roughly `batch_size` bytes that end just after a newline.
+        static std::vector<std::string_view> SplitBatches(std::string_view data, size_t batch_size) {
+            const auto& kernels = detail::ActiveScanKernels();
+            batch_size = std::max<size_t>(batch_size, 1);
+
+            std::vector<std::string_view> batches;
+            const char* next = data.data();
+            const char* end = data.data() + data.size();
+            while (next < end) {
+                const char* split = end;
+                if (static_cast<size_t>(end - next) > batch_size) {
+                    split = kernels.FindChar(next + batch_size, end, '\n');
+                    if (split < end) { ++split; }
+                }
+                batches.emplace_back(next, static_cast<size_t>(split - next));
+                next = split;
+            }
+            return batches;
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        // Calls `func(line)` for each line in `data`, without the line ending.
+        template <typename TFunc>
+        static void ForEachLine(std::string_view data, TFunc&& func) {
+            const auto& kernels = detail::ActiveScanKernels();
+            const char* next = data.data();
+            const char* end = data.data() + data.size();
+            while (next < end) {
+                const char* line_end = kernels.FindChar(next, end, '\n');
+                const char* text_end = line_end;
+                if (text_end > next && *(text_end - 1) == '\r') { --text_end; }
+
+                func(std::string_view(next, static_cast<size_t>(text_end - next)));
+                next = (line_end < end) ? line_end + 1 : end;
+            }
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        // Calls `parse_batch(batch)` for each batch on the worker threads and `deliver(result)` for each
+        // result on the calling thread.  At most two batches per thread are parsed ahead of delivery, which
+        // bounds the memory held by undelivered results.
+        template <typename TResult, typename TParseBatch, typename TDeliver>
+        static void Run(std::string_view data, const Options& options, TParseBatch& parse_batch, TDeliver& deliver) {
+            auto batches = SplitBatches(data, options.BatchSize);
+
+            size_t thread_count = options.ThreadCount;
+            if (thread_count == 0) {
+                thread_count = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+            }
+            thread_count = std::min(thread_count, batches.size());
+            if (thread_count <= 1) {
+                for (auto batch : batches) {
+                    deliver(parse_batch(batch));
+                }
+                return;
+            }
+
+            const size_t window = thread_count * 2;
+
+            std::mutex mutex;
+            std::condition_variable condition;
+            std::vector<std::optional<TResult>> results(batches.size());
+            std::vector<size_t> completed;
+            size_t next_batch = 0;
+            size_t delivered = 0;
+            bool stop = false;
+            std::exception_ptr error;
+
+            auto worker = [&]() {
+                for (;;) {
+                    size_t index;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        condition.wait(lock, [&]() {
+                            return stop || next_batch == batches.size() || next_batch < delivered + window;
+                        });
+                        if (stop || next_batch == batches.size()) { return; }
+                        index = next_batch++;
+                    }
+
+                    try {
+                        auto result = parse_batch(batches[index]);
+                        std::lock_guard<std::mutex> lock(mutex);
+                        results[index].emplace(std::move(result));
+                        if (!options.Ordered) { completed.push_back(index); }
+                    } catch (...) {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        if (!error) { error = std::current_exception(); }
+                        stop = true;
+                    }
+                    condition.notify_all();
+                }
+            };
+
+            std::vector<std::thread> threads;
+            threads.reserve(thread_count);
+
+            // Stops and joins the workers however delivery ends.
+            struct Joiner {
+                std::vector<std::thread>& Threads;
+                std::mutex& Mutex;
+                std::condition_variable& Condition;
+                bool& Stop;
+
+                ~Joiner() {
+                    {
+                        std::lock_guard<std::mutex> lock(Mutex);
+                        Stop = true;
+                    }
+                    Condition.notify_all();
+                    for (auto& thread : Threads) { thread.join(); }
+                }
+            } joiner{ threads, mutex, condition, stop };
+
+            for (size_t i = 0; i < thread_count; ++i) {
+                threads.emplace_back(worker);
+            }
+
+            for (size_t i = 0; i < batches.size(); ++i) {
+                std::optional<TResult> result;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    size_t index = i;
+                    if (options.Ordered) {
+                        condition.wait(lock, [&]() { return error || results[index].has_value(); });
+                    } else {
+                        condition.wait(lock, [&]() { return error || !completed.empty(); });
+                        if (!error) {
+                            index = completed.back();
+                            completed.pop_back();
+                        }
+                    }
+                    if (error) { std::rethrow_exception(error); }
+                    result.swap(results[index]);
+                }
+
+                deliver(std::move(*result));
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    ++delivered;
+                }
+                condition.notify_all();
+            }
+        }
+    };
+
+    //--------------------------------------------------------------------------------------------------------
+
+    // Parses a sequence of values that follow one another in the same buffer, such as messages written back to
+    // back.  Values may be separated by whitespace, by RFC 7464 record separators (0x1E), by comments if they
+    // are ignored, or by nothing where that's unambiguous, as in `{}[]"x"`.  The parser's stack and scratch
+    // buffers are reused from one value to the next.
+    //
+    //     SequenceReader reader(data);
+    //     while (auto value = reader.Next()) {
+    //         // The value ended at reader.Offset()
+    //     }
+    //     if (reader.Failed()) { /* Invalid value starting at reader.Offset() */ }
+    class SequenceReader {
+    public:
+        explicit SequenceReader(std::string_view data, const ParseOptions& options = ParseOptions())
+          : m_next(data.data()),
+            m_begin(data.data()),
+            m_end(data.data() + data.size()),
+            m_options(options)
+        { }
+
+        // Parses the next value.  Returns `std::nullopt` at the end of the input or if the value is invalid,
+        // which `Failed()` distinguishes.
+        std::optional<JsonValue> Next() {
+            m_values.Reset();
+            m_values.SetOptions(m_options);
+            if (!Next(m_values)) { return std::nullopt; }
+            return m_values.TakeValue();
+        }
+
+        // As above, but invokes the hooks for the next value instead.  Returns false at the end of the input,
+        // if the value is invalid or if a hook failed.  A hook returning `HookResult::Stop` ends the sequence
+        // once it returns.
+        bool Next(ISimpleReaderHooks*const hooks) {
+            return Next(*hooks);
+        }
+
+        template <typename THooks>
+        bool Next(THooks& hooks) {
+            if (m_failed || m_stopped) { return false; }
+
+            SimpleReader::HookState<THooks> state{
+                {
+                    m_options.IgnoreComments,
+                    m_next,
+                    m_end,
+                    detail::ActiveScanKernels(),
+                    m_options.ValidateUtf8,
+                    m_options.MaxDepth
+                },
+                hooks
+            };
+
+            for (;;) {
+                if (!SimpleReader::SkipCommentsAndWhitespace(state)) {
+                    m_failed = true;
+                    return false;
+                }
+                if (state.Eof() || *state.NextChar != RecordSeparator) { break; }
+                ++state.NextChar;
+            }
+            m_next = state.NextChar;
+            if (state.Eof()) { return false; }
+
+            state.Scratch.swap(m_scratch);
+            m_scopes.Clear();
+            bool parsed = SimpleReader::ParseValue(state, m_scopes);
+            state.Scratch.swap(m_scratch);
+
+            if (state.Stopped) {
+                m_stopped = true;
+                return true;
+            }
+            if (!parsed) {
+                m_failed = true;
+                return false;
+            }
+            m_next = state.NextChar;
+            return true;
+        }
+
+        // The offset in the input of the byte after the last value parsed, or of the start of the value that
+        // failed to parse.
+        size_t Offset() const noexcept { return static_cast<size_t>(m_next - m_begin); }
+
+        // Whether parsing ended because a value was invalid.
+        bool Failed() const noexcept { return m_failed; }
+
+    private:
+        static constexpr char RecordSeparator = '\x1E';
+
+        const char* m_next;
+        const char*const m_begin;
+        const char*const m_end;
+        const ParseOptions m_options;
+        bool m_failed = false;
+        bool m_stopped = false;
+
+        ObjectReader m_values;
+        detail::ScopeStack m_scopes;
+        std::string m_scratch;
+    };
+
+    //--------------------------------------------------------------------------------------------------------
+    //--------------------------------------------------------------------------------------------------------
+    //--------------------------------------------------------------------------------------------------------
+
+    // An immutable, parsed JSON document stored as a flat "tape" of 64-bit entries plus a single buffer
+    // holding the string contents.  Values are accessed through lightweight `JsonElement` cursors.
+    //
+    // Each tape entry holds a tag in the top 8 bits and a payload in the remaining 56 bits:
+    //   - Null, true and false have no payload.
+    //   - Int, UInt and Real are followed by a second entry holding the raw 64-bit value.
+    //   - Strings hold the offset of a 32-bit length prefix and the bytes in the string buffer.
+    //   - Array and object starts hold the index after their matching end in the low 32 bits and the
+    //     number of elements, saturated to 24 bits, in the high bits.  Ends hold the index of the start.
+    // Object members are stored as a string entry for the key followed by the value.
+    class JsonDocument {
+    public:
+        static inline std::optional<JsonDocument> Parse(std::string_view data, const ParseOptions& options = ParseOptions());
+        static inline std::optional<JsonDocument> ParseIndexed(std::string_view data, const ParseOptions& options = ParseOptions());
+
+        //----------------------------------------------------------------------------------------------------
+
+        inline JsonElement Root() const;
+
+        // The number of 64-bit tape entries, mainly useful for diagnostics.
+        size_t TapeSize() const { return m_tape.size(); }
+
+    private:
+        enum Tag : uint8_t {
+            TagNull = 'n',
+            TagTrue = 't',
+            TagFalse = 'f',
+            TagInt = 'i',
+            TagUInt = 'u',
+            TagReal = 'd',
+            TagString = 's',
+            TagArrayStart = '[',
+            TagArrayEnd = ']',
+            TagObjectStart = '{',
+            TagObjectEnd = '}'
+        };
+
+        static constexpr uint64_t PayloadMask = (uint64_t(1) << 56) - 1;
+        static constexpr uint64_t MaxCount = (uint64_t(1) << 24) - 1;
+
+        std::vector<uint64_t> m_tape;
+        std::string m_strings;
 
-            auto start = state.NextChar;
-            bool is_double = false;
-            while (!state.Eof()) {
-                auto c = *state.NextChar;
-                if (c >= '0' && c <= '9') {
-                    ++state.NextChar;
-                } else if (c == '-' || c == '+') {
-                    ++state.NextChar;
-                } else if (c == '.' || c == 'e' || c == 'E') {
-                    is_double = true;
-                    ++state.NextChar;
-                } else {
-                    break;
+        JsonDocument() = default;
+
+        //----------------------------------------------------------------------------------------------------
+
+        static Tag GetTag(uint64_t entry) { return static_cast<Tag>(entry >> 56); }
+        static uint64_t GetPayload(uint64_t entry) { return entry & PayloadMask; }
+        static uint64_t MakeEntry(Tag tag, uint64_t payload) { return (static_cast<uint64_t>(tag) << 56) | payload; }
+
+        // Returns the index of the value following the one at `index`.
+        size_t Skip(size_t index) const {
+            uint64_t entry = m_tape[index];
+            switch (GetTag(entry)) {
+            case TagInt:
+            case TagUInt:
+            case TagReal:
+                return index + 2;
+
+            case TagArrayStart:
+            case TagObjectStart:
+                return static_cast<size_t>(entry & 0xFFFFFFFF);
+
+            default:
+                return index + 1;
+            }
+        }
+
+        std::string_view GetString(size_t index) const {
+            size_t offset = static_cast<size_t>(GetPayload(m_tape[index]));
+            uint32_t length;
+            std::memcpy(&length, m_strings.data() + offset, sizeof(length));
+            return std::string_view(m_strings.data() + offset + sizeof(length), length);
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        class Builder;
+
+        friend class JsonElement;
+    };
+
+    //--------------------------------------------------------------------------------------------------------
+
+    class JsonDocument::Builder final :
+        public ISimpleReaderHooks
+    {
+    public:
+        explicit Builder(size_t data_size) {
+            // Rough estimates to avoid most reallocations.
+            m_document.m_tape.reserve(data_size / 4 + 1);
+            m_document.m_strings.reserve(data_size / 2 + 1);
+        }
+
+        std::optional<JsonDocument> Finish() {
+            if (!m_open.empty() || m_document.m_tape.empty()) { return std::nullopt; }
+            return std::make_optional(std::move(m_document));
+        }
+
+    private:
+        struct OpenContainer {
+            size_t StartIndex;
+            uint64_t Count;
+        };
+
+        JsonDocument m_document;
+        std::vector<OpenContainer> m_open;
+
+        //------------------------------------------------------------------------------------------------
+
+        bool BeginValue() {
+            if (m_open.empty()) {
+                // Only a single root value is allowed.
+                return m_document.m_tape.empty();
+            }
+            ++m_open.back().Count;
+            return true;
+        }
+
+        bool AppendScalar(Tag tag, uint64_t payload) {
+            if (!BeginValue()) { return false; }
+            m_document.m_tape.push_back(MakeEntry(tag, payload));
+            return true;
+        }
+
+        bool AppendNumber(Tag tag, uint64_t bits) {
+            if (!BeginValue()) { return false; }
+            m_document.m_tape.push_back(MakeEntry(tag, 0));
+            m_document.m_tape.push_back(bits);
+            return true;
+        }
+
+        void AppendString(std::string_view value) {
+            auto& strings = m_document.m_strings;
+            auto length = static_cast<uint32_t>(value.size());
+            m_document.m_tape.push_back(MakeEntry(TagString, strings.size()));
+            strings.append(reinterpret_cast<const char*>(&length), sizeof(length));
+            strings.append(value.data(), value.size());
+        }
+
+        bool StartContainer(Tag tag) {
+            if (!BeginValue()) { return false; }
+            m_open.push_back(OpenContainer{ m_document.m_tape.size(), 0 });
+            m_document.m_tape.push_back(MakeEntry(tag, 0));
+            return true;
+        }
+
+        bool EndContainer(Tag start_tag, Tag end_tag) {
+            if (m_open.empty()) { return false; }
+            auto open = m_open.back();
+            m_open.pop_back();
+
+            auto& tape = m_document.m_tape;
+            if (GetTag(tape[open.StartIndex]) != start_tag) { return false; }
+
+            tape.push_back(MakeEntry(end_tag, open.StartIndex));
+            uint64_t count = std::min(open.Count, MaxCount);
+            tape[open.StartIndex] = MakeEntry(start_tag, (count << 32) | tape.size());
+            return true;
+        }
+
+        //------------------------------------------------------------------------------------------------
+
+        bool OnNull() override { return AppendScalar(TagNull, 0); }
+        bool OnBool(bool value) override { return AppendScalar(value ? TagTrue : TagFalse, 0); }
+        bool OnInt(int64_t value) override { return AppendNumber(TagInt, static_cast<uint64_t>(value)); }
+        bool OnUInt(uint64_t value) override { return AppendNumber(TagUInt, value); }
+        bool OnReal(double value) override {
+            uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return AppendNumber(TagReal, bits);
+        }
+        bool OnString(std::string_view value) override {
+            if (!BeginValue()) { return false; }
+            AppendString(value);
+            return true;
+        }
+
+        bool OnArrayStart() override { return StartContainer(TagArrayStart); }
+        bool OnArrayEnd() override { return EndContainer(TagArrayStart, TagArrayEnd); }
+
+        bool OnObjectStart() override { return StartContainer(TagObjectStart); }
+        bool OnObjectKey(std::string_view value) override {
+            if (m_open.empty()) { return false; }
+            AppendString(value);
+            return true;
+        }
+        bool OnObjectEnd() override { return EndContainer(TagObjectStart, TagObjectEnd); }
+
+        friend class SimpleReader;
+    };
+
+    //--------------------------------------------------------------------------------------------------------
+
+    inline std::optional<JsonDocument> JsonDocument::Parse(std::string_view data, const ParseOptions& options) {
+        Builder builder(data.size());
+        if (!SimpleReader::Parse(data, builder, options)) { return std::nullopt; }
+        return builder.Finish();
+    }
+
+    inline std::optional<JsonDocument> JsonDocument::ParseIndexed(std::string_view data, const ParseOptions& options) {
+        Builder builder(data.size());
+        if (!SimpleReader::ParseIndexed(data, builder, options)) { return std::nullopt; }
+        return builder.Finish();
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    // A cursor to a single value within a `JsonDocument`.  It is only valid while the document exists.
+    class JsonElement {
+    public:
+        class Iterator;
+        class MemberIterator;
+        struct Member;
+        template <typename TIterator> class Range;
+
+        //----------------------------------------------------------------------------------------------------
+
+        JsonValueType Type() const {
+            switch (GetTag()) {
+            case JsonDocument::TagNull: return JsonValueType::Null;
+            case JsonDocument::TagTrue:
+            case JsonDocument::TagFalse: return JsonValueType::Boolean;
+            case JsonDocument::TagInt: return JsonValueType::Int;
+            case JsonDocument::TagUInt: return JsonValueType::UInt;
+            case JsonDocument::TagReal: return JsonValueType::Real;
+            case JsonDocument::TagString: return JsonValueType::String;
+            case JsonDocument::TagArrayStart: return JsonValueType::Array;
+            case JsonDocument::TagObjectStart: return JsonValueType::Object;
+            default:
+                throw std::runtime_error("Unknown value type");
+            }
+        }
+
+        bool IsNull() const { return GetTag() == JsonDocument::TagNull; }
+        bool IsString() const { return GetTag() == JsonDocument::TagString; }
+        bool IsInt() const { return GetTag() == JsonDocument::TagInt; }
+        bool IsUInt() const { return GetTag() == JsonDocument::TagUInt; }
+        bool IsReal() const { return GetTag() == JsonDocument::TagReal; }
+        bool IsBool() const { return GetTag() == JsonDocument::TagTrue || GetTag() == JsonDocument::TagFalse; }
+        bool IsArray() const { return GetTag() == JsonDocument::TagArrayStart; }
+        bool IsObject() const { return GetTag() == JsonDocument::TagObjectStart; }
+
+        bool IsInteger() const { return IsInt() || IsUInt(); }
+
+        //----------------------------------------------------------------------------------------------------
+
+        // Strings are returned as a view of the document's string buffer.  No conversions are performed.
+        std::string_view AsString() const {
+            if (!IsString()) {
+                throw std::logic_error("Value is not a string");
+            }
+            return m_document->GetString(m_index);
+        }
+
+        std::intmax_t AsInt() const {
+            switch (GetTag()) {
+            case JsonDocument::TagInt: return static_cast<std::intmax_t>(Bits());
+            case JsonDocument::TagUInt: return static_cast<std::intmax_t>(Bits());
+            case JsonDocument::TagReal: return static_cast<std::intmax_t>(Real());
+            case JsonDocument::TagTrue: return 1;
+            case JsonDocument::TagFalse: return 0;
+            default:
+                throw std::logic_error("Cannot convert arrays, objects, strings or null to int");
+            }
+        }
+
+        std::uintmax_t AsUInt() const {
+            switch (GetTag()) {
+            case JsonDocument::TagInt: return static_cast<std::uintmax_t>(Bits());
+            case JsonDocument::TagUInt: return static_cast<std::uintmax_t>(Bits());
+            case JsonDocument::TagReal: return static_cast<std::uintmax_t>(Real());
+            case JsonDocument::TagTrue: return 1;
+            case JsonDocument::TagFalse: return 0;
+            default:
+                throw std::logic_error("Cannot convert arrays, objects, strings or null to int");
+            }
+        }
+
+        double AsDouble() const {
+            switch (GetTag()) {
+            case JsonDocument::TagInt: return static_cast<double>(static_cast<int64_t>(Bits()));
+            case JsonDocument::TagUInt: return static_cast<double>(Bits());
+            case JsonDocument::TagReal: return Real();
+            case JsonDocument::TagTrue: return 1.0;
+            case JsonDocument::TagFalse: return 0.0;
+            default:
+                throw std::logic_error("Cannot convert arrays, objects, strings or null to real");
+            }
+        }
+
+        float AsFloat() const { return static_cast<float>(AsDouble()); }
+
+        bool AsBool() const {
+            switch (GetTag()) {
+            case JsonDocument::TagInt:
+            case JsonDocument::TagUInt: return Bits() != 0;
+            case JsonDocument::TagReal: return Real() != 0.0;
+            case JsonDocument::TagTrue: return true;
+            case JsonDocument::TagFalse: return false;
+            default:
+                throw std::logic_error("Cannot convert arrays, objects, strings or null to bool");
+            }
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        // The number of elements in an array or members in an object.
+        size_t Size() const {
+            AssertContainer();
+            uint64_t count = (Entry() >> 32) & JsonDocument::MaxCount;
+            if (count < JsonDocument::MaxCount) {
+                return static_cast<size_t>(count);
+            }
+
+            // Very large containers have to be counted.
+            size_t size = 0;
+            size_t step = IsObject() ? 2 : 1;
+            for (size_t index = m_index + 1; index != EndIndex(); index = m_document->Skip(index + step - 1)) {
+                ++size;
+            }
+            return size;
+        }
+
+        bool Empty() const {
+            AssertContainer();
+            return m_index + 1 == EndIndex();
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        // Returns the array element at `index`.  This walks the preceding elements.
+        JsonElement operator[](size_t index) const {
+            AssertArray();
+            size_t position = m_index + 1;
+            for (; index != 0 && position != EndIndex(); --index) {
+                position = m_document->Skip(position);
+            }
+            if (position == EndIndex()) {
+                throw std::out_of_range("Array index out of range");
+            }
+            return JsonElement(m_document, position);
+        }
+
+        // Returns the value of the object member named `key`, if it exists.
+        std::optional<JsonElement> Find(std::string_view key) const {
+            AssertObject();
+            for (size_t position = m_index + 1; position != EndIndex(); position = m_document->Skip(position + 1)) {
+                if (m_document->GetString(position) == key) {
+                    return JsonElement(m_document, position + 1);
                 }
             }
-
-            auto end = const_cast<char*>(state.NextChar);
-            if (is_double) {
-                double value = std::strtod(start, &end);
-                if (start == end) { return false; }
-                if (is_negative) { value = -value; }
-                return state.Hooks->OnReal(value);
-                
-            } else {
-                uint64_t value = std::strtoull(start, &end, 10);
-                if (start == end) { return false; }
-                if (is_negative) {
-                    auto limit = static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) + 1;
-                    if (value > limit) {
-                        // Underflow.
-                        return false;
-                    }
-                    return state.Hooks->OnInt(-static_cast<int64_t>(value));
-                } else {
-                    return state.Hooks->OnUInt(value);
-                }
+            return std::nullopt;
+        }
+
+        bool Exists(std::string_view key) const {
+            return Find(key).has_value();
+        }
+
+        bool Exists(std::string_view key, JsonValueType type) const {
+            auto value = Find(key);
+            return value && value->Type() == type;
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        inline Range<Iterator> Elements() const;
+        inline Range<MemberIterator> Members() const;
+
+    private:
+        const JsonDocument* m_document;
+        size_t m_index;
+
+        JsonElement(const JsonDocument* document, size_t index)
+          : m_document(document),
+            m_index(index)
+        {}
+
+        uint64_t Entry() const { return m_document->m_tape[m_index]; }
+        JsonDocument::Tag GetTag() const { return JsonDocument::GetTag(Entry()); }
+        uint64_t Bits() const { return m_document->m_tape[m_index + 1]; }
+        size_t EndIndex() const { return static_cast<size_t>(Entry() & 0xFFFFFFFF) - 1; }
+
+        double Real() const {
+            uint64_t bits = Bits();
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        void AssertArray() const {
+            if (!IsArray()) {
+                throw std::logic_error("Value is not an array");
+            }
+        }
+        void AssertObject() const {
+            if (!IsObject()) {
+                throw std::logic_error("Value is not an object");
+            }
+        }
+        void AssertContainer() const {
+            if (!IsArray() && !IsObject()) {
+                throw std::logic_error("Value is not an array or object");
+            }
+        }
+
+        friend class JsonDocument;
+    };
+
+    //--------------------------------------------------------------------------------------------------------
+
+    struct JsonElement::Member {
+        std::string_view Key;
+        JsonElement Value;
+    };
+
+    //--------------------------------------------------------------------------------------------------------
+
+    template <typename TIterator>
+    class JsonElement::Range {
+    public:
+        Range(TIterator first, TIterator last)
+          : m_first(first),
+            m_last(last)
+        {}
+
+        TIterator begin() const { return m_first; }
+        TIterator end() const { return m_last; }
+
+    private:
+        TIterator m_first;
+        TIterator m_last;
+    };
+
+    //--------------------------------------------------------------------------------------------------------
+
+    class JsonElement::Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = JsonElement;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const JsonElement*;
+        using reference = JsonElement;
+
+        JsonElement operator * () const { return JsonElement(m_document, m_index); }
+
+        Iterator& operator ++ () {
+            m_index = m_document->Skip(m_index);
+            return *this;
+        }
+        Iterator operator ++ (int) {
+            Iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        bool operator == (const Iterator& other) const { return m_index == other.m_index; }
+        bool operator != (const Iterator& other) const { return m_index != other.m_index; }
+
+    private:
+        const JsonDocument* m_document;
+        size_t m_index;
+
+        Iterator(const JsonDocument* document, size_t index)
+          : m_document(document),
+            m_index(index)
+        {}
+
+        friend class JsonElement;
+    };
+
+    //--------------------------------------------------------------------------------------------------------
+
+    class JsonElement::MemberIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Member;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Member*;
+        using reference = Member;
+
+        Member operator * () const {
+            return Member{ m_document->GetString(m_index), JsonElement(m_document, m_index + 1) };
+        }
+
+        MemberIterator& operator ++ () {
+            m_index = m_document->Skip(m_index + 1);
+            return *this;
+        }
+        MemberIterator operator ++ (int) {
+            MemberIterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        bool operator == (const MemberIterator& other) const { return m_index == other.m_index; }
+        bool operator != (const MemberIterator& other) const { return m_index != other.m_index; }
+
+    private:
+        const JsonDocument* m_document;
+        size_t m_index;
+
+        MemberIterator(const JsonDocument* document, size_t index)
+          : m_document(document),
+            m_index(index)
+        {}
+
+        friend class JsonElement;
+    };
+
+    //--------------------------------------------------------------------------------------------------------
+
+    inline JsonElement::Range<JsonElement::Iterator> JsonElement::Elements() const {
+        AssertArray();
+        return Range<Iterator>(Iterator(m_document, m_index + 1), Iterator(m_document, EndIndex()));
+    }
+
+    inline JsonElement::Range<JsonElement::MemberIterator> JsonElement::Members() const {
+        AssertObject();
+        return Range<MemberIterator>(MemberIterator(m_document, m_index + 1), MemberIterator(m_document, EndIndex()));
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    inline JsonElement JsonDocument::Root() const {
+        return JsonElement(this, 0);
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+    //--------------------------------------------------------------------------------------------------------
+    //--------------------------------------------------------------------------------------------------------
+
+    // A cursor over a value in a caller owned buffer that is only parsed as far as it is accessed.  Looking
+    // up an element or member skips the values before it with a bracket matching scan that allocates
+    // nothing, and values are only converted to `JsonValue` by `Materialize()`.  Strings are returned as
+    // views of the buffer with no conversions performed, and object keys are matched against the same raw
+    // text.
+    //
+    // Only the parts of the buffer that are actually read are validated, so malformed JSON may go unnoticed
+    // in skipped values.  Where it is found, `std::runtime_error` is thrown.  The buffer must outlive every
+    // cursor over it.
+    class JsonLazyValue {
+    public:
+        class Iterator;
+        class MemberIterator;
+        struct Member;
+        template <typename TIterator> class Range;
+
+        // Returns a cursor over the top level value in `data`, or `std::nullopt` if there isn't one.
+        static std::optional<JsonLazyValue> Parse(std::string_view data) {
+            JsonLazyValue value(data.data(), data.data() + data.size(), &detail::ActiveScanKernels());
+            value.m_value = value.SkipWhitespace(value.m_value);
+            if (value.m_value == value.m_end) { return std::nullopt; }
+            return value;
+        }
+
+        //----------------------------------------------------------------------------------------------------
+
+        JsonValueType Type() const {
+            switch (*m_value) {
+            case 'n': RequireLiteral("null"); return JsonValueType::Null;
+            case 't': RequireLiteral("true"); return JsonValueType::Boolean;
+            case 'f': RequireLiteral("false"); return JsonValueType::Boolean;
+            case '"': return JsonValueType::String;
+            case '[': return JsonValueType::Array;
+            case '{': return JsonValueType::Object;
+            default: return ReadNumber().Type;
+            }
+        }
+
+        bool IsNull() const { return Type() == JsonValueType::Null; }
+        bool IsString() const { return *m_value == '"'; }
+        bool IsInt() const { return Type() == JsonValueType::Int; }
+        bool IsUInt() const { return Type() == JsonValueType::UInt; }
+        bool IsReal() const { return Type() == JsonValueType::Real; }
+        bool IsBool() const { return Type() == JsonValueType::Boolean; }
+        bool IsArray() const { return *m_value == '['; }
+        bool IsObject() const { return *m_value == '{'; }
+
+        bool IsInteger() const { return IsInt() || IsUInt(); }
+
+        //----------------------------------------------------------------------------------------------------
+
+        // Strings are returned as a view of the buffer.  No conversions are performed.
+        std::string_view AsString() const {
+            if (!IsString()) {
+                throw std::logic_error("Value is not a string");
+            }
+            auto end = SkipString(m_value);
+            return std::string_view(m_value + 1, static_cast<size_t>(end - m_value - 2));
+        }
+
+        std::intmax_t AsInt() const {
+            switch (Type()) {
+            case JsonValueType::Boolean: return (*m_value == 't') ? 1 : 0;
+            case JsonValueType::Int:
+            case JsonValueType::UInt:
+            case JsonValueType::Real: {
+                auto number = ReadNumber();
+                if (number.Type == JsonValueType::Real) { return static_cast<std::intmax_t>(number.Real); }
+                return static_cast<std::intmax_t>(number.Bits);
+            }
+            default:
+                throw std::logic_error("Cannot convert arrays, objects, strings or null to int");
+            }
+        }
+
+        std::uintmax_t AsUInt() const {
+            switch (Type()) {
+            case JsonValueType::Boolean: return (*m_value == 't') ? 1 : 0;
+            case JsonValueType::Int:
+            case JsonValueType::UInt:
+            case JsonValueType::Real: {
+                auto number = ReadNumber();
+                if (number.Type == JsonValueType::Real) { return static_cast<std::uintmax_t>(number.Real); }
+                return static_cast<std::uintmax_t>(number.Bits);
+            }
+            default:
+                throw std::logic_error("Cannot convert arrays, objects, strings or null to int");
+            }
+        }
+
+        double AsDouble() const {
+            switch (Type()) {
+            case JsonValueType::Boolean: return (*m_value == 't') ? 1.0 : 0.0;
+            case JsonValueType::Int:
+            case JsonValueType::UInt:
+            case JsonValueType::Real: {
+                auto number = ReadNumber();
+                if (number.Type == JsonValueType::Int) { return static_cast<double>(static_cast<int64_t>(number.Bits)); }
+                if (number.Type == JsonValueType::UInt) { return static_cast<double>(number.Bits); }
+                return number.Real;
+            }
+            default:
+                throw std::logic_error("Cannot convert arrays, objects, strings or null to real");
+            }
+        }
+
+        float AsFloat() const { return static_cast<float>(AsDouble()); }
+
+        bool AsBool() const {
+            switch (Type()) {
+            case JsonValueType::Boolean: return *m_value == 't';
+            case JsonValueType::Int:
+            case JsonValueType::UInt:
+            case JsonValueType::Real: {
+                auto number = ReadNumber();
+                if (number.Type == JsonValueType::Real) { return number.Real != 0.0; }
+                return number.Bits != 0;
+            }
+            default:
+                throw std::logic_error("Cannot convert arrays, objects, strings or null to bool");
             }
         }
 
         //----------------------------------------------------------------------------------------------------
 
-        static bool SkipCommentsAndWhitespace(State& state) {
-            while (!state.Eof()) {
-                SkipWhitespace(state);
-
-                if (*state.NextChar != '/') {
-                    return true;
-                }
-                if (!ParseComment(state)) {
-                    return false;
-                }
+        // The number of elements in an array or members in an object.  This walks the whole container.
+        size_t Size() const {
+            AssertContainer();
+            size_t size = 0;
+            for (auto entry = FirstEntry(); entry != nullptr; entry = NextEntry(entry)) {
+                ++size;
             }
+            return size;
+        }
 
-            return true;
+        bool Empty() const {
+            AssertContainer();
+            return FirstEntry() == nullptr;
         }
 
         //----------------------------------------------------------------------------------------------------
 
-        static bool ParseComment(State& state) {
-            if (!state.IgnoreComments) {
-                return false;
+        // Returns the array element at `index`.  This skips the preceding elements.
+        JsonLazyValue operator[](size_t index) const {
+            AssertArray();
+            auto entry = FirstEntry();
+            for (; index != 0 && entry != nullptr; --index) {
+                entry = NextEntry(entry);
             }
+            if (entry == nullptr) {
+                throw std::out_of_range("Array index out of range");
+            }
+            return At(entry);
+        }
 
-            ++state.NextChar;
-            if (*state.NextChar == '/') {
-                // Single line comment
-                ++state.NextChar;
-                ScanEndOfLine(state);
-                return true;
+        // Returns the value of the first object member named `key`, if it exists.  This skips the preceding
+        // members.
+        std::optional<JsonLazyValue> Find(std::string_view key) const {
+            AssertObject();
+            for (auto entry = FirstEntry(); entry != nullptr; entry = NextEntry(entry)) {
+                std::string_view member_key;
+                auto value = ReadMember(entry, member_key);
+                if (member_key == key) { return At(value); }
+            }
+            return std::nullopt;
+        }
 
-            } else if (*state.NextChar == '*') {
-                // Multi-line comment
-                ++state.NextChar;
-                return ScanEndOfMultilineComment(state);
+        // Returns the first member named `key` at or after `from`, or the end of `Members()` if there isn't
+        // one.  Starting each search after the previous match finds members requested in document order in a
+        // single forward pass.  The value of a match is only skipped once the iterator is advanced past it.
+        inline MemberIterator FindNext(std::string_view key, MemberIterator from) const;
 
-            } else {
-                // Invalid.
-                return false;
-            }
+        bool Exists(std::string_view key) const {
+            return Find(key).has_value();
         }
 
-        //----------------------------------------------------------------------------------------------------
+        bool Exists(std::string_view key, JsonValueType type) const {
+            auto value = Find(key);
+            return value && value->Type() == type;
+        }
 
-        static void ScanEndOfLine(State& state) {
-#ifdef CPPJSON_USE_SSE
-            const __m128i NewlineChar128 = _mm_set1_epi8('\n');
+        //----------------------------------------------------------------------------------------------------
 
-            // SSE2 main loop.
-            size_t loop_count = state.BytesRemaining() / sizeof(__m128i);
-            while (loop_count != 0) {
-                __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state.NextChar));
+        inline Range<Iterator> Elements() const;
+        inline Range<MemberIterator> Members() const;
 
-                __m128i mask_newline = _mm_cmpeq_epi8(chars, NewlineChar128);
+        //----------------------------------------------------------------------------------------------------
 
-                uint16_t bitmask = static_cast<uint16_t>(_mm_movemask_epi8(mask_newline));
-                if (bitmask != 0) {
-#ifdef _GNUG_
-                    int32_t offset = __builtin_ffs(static_cast<int32_t>(bitmask)) - 1;
-#endif
-#ifdef _MSC_VER
-                    unsigned long offset;
-                    _BitScanForward(&offset, static_cast<uint32_t>(bitmask));
-#endif
-                    state.NextChar += offset + 1;
-                    return;
-                }
+        // The text of the value.
+        std::string_view Raw() const {
+            return std::string_view(m_value, static_cast<size_t>(SkipValue(m_value) - m_value));
+        }
 
-                --loop_count;
-                state.NextChar += sizeof(__m128i);
-            }
+        // Parses the value into a `JsonValue`.  Returns `std::nullopt` if it is invalid.
+        std::optional<JsonValue> Materialize() const {
+            return ObjectReader::Parse(Raw());
+        }
 
-            // Plain loop for the <16 remaining chars.
-#endif
+    private:
+        const char* m_value;
+        const char* m_end;
+        const detail::ScanKernels* m_kernels;
+
+        JsonLazyValue(const char* value, const char* end, const detail::ScanKernels* kernels)
+          : m_value(value),
+            m_end(end),
+            m_kernels(kernels)
+        {}
 
-            for (; !state.Eof(); ++state.NextChar) {
-                if (*state.NextChar == '\n') {
-                    ++state.NextChar;
-                    return;
-                }
-            }
+        JsonLazyValue At(const char* value) const {
+            return JsonLazyValue(value, m_end, m_kernels);
         }
 
         //----------------------------------------------------------------------------------------------------
 
-        static bool ScanEndOfMultilineComment(State& state) {
-#ifdef CPPJSON_USE_SSE
-            const __m128i AsteriskChar128 = _mm_set1_epi8('*');
-            const __m128i SlashChar128 = _mm_set1_epi8(static_cast<uint8_t>('//'));
-
-            // SSE2 main loop.
-            size_t loop_count = state.BytesRemaining() / sizeof(__m128i);
-            if (loop_count != 0) {
-                uint16_t bitmask_asterisk = 0;
-                while (loop_count != 0) {
-                    __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state.NextChar));
-
-                    __m128i mask_asterisk = _mm_cmpeq_epi8(chars, AsteriskChar128);
-                    __m128i mask_slash = _mm_cmpeq_epi8(chars, SlashChar128);
-                    uint16_t bitmask_slash = static_cast<uint16_t>(_mm_movemask_epi8(mask_slash));
-                    bitmask_asterisk |= static_cast<uint16_t>(_mm_movemask_epi8(mask_asterisk)) << 1;
-
-                    uint16_t bitmask_end_comment = bitmask_slash & bitmask_asterisk;
-                    if (bitmask_end_comment != 0) {
-#ifdef _GNUG_
-                        int32_t offset = __builtin_ffs(static_cast<int32_t>(bitmask_end_comment)) - 1;
-#endif
-#ifdef _MSC_VER
-                        unsigned long offset;
-                        _BitScanForward(&offset, static_cast<uint32_t>(bitmask_end_comment));
-#endif
-                        state.NextChar += offset + 1;
-                        return true;
-                    }
-
-                    --loop_count;
-                    state.NextChar += sizeof(__m128i);
-                    bitmask_asterisk = static_cast<uint16_t>(_mm_movemask_epi8(mask_asterisk)) >> (sizeof(__m128i) - 1);
-                }
-            }
+        struct Number {
+            JsonValueType Type;
+            uint64_t Bits;
+            double Real;
+        };
 
-            // Plain loop for the <16 remaining chars.
-#endif
+        struct NumberHooks {
+            Number& Result;
 
-            for (; !state.Eof(); ++state.NextChar) {
-                if (*state.NextChar == '*') {
-                    ++state.NextChar;
-                    break;
-                }
+            bool OnInt(int64_t value) {
+                Result = { JsonValueType::Int, static_cast<uint64_t>(value), 0.0 };
+                return true;
             }
-            for (; !state.Eof(); ++state.NextChar) {
-                if (*state.NextChar == '/') {
-                    ++state.NextChar;
-                    return true;
-                }
+            bool OnUInt(uint64_t value) {
+                Result = { JsonValueType::UInt, value, 0.0 };
+                return true;
+            }
+            bool OnReal(double value) {
+                Result = { JsonValueType::Real, 0, value };
+                return true;
             }
+        };
 
-            return false;
+        Number ReadNumber() const {
+            Number number{ JsonValueType::Null, 0, 0.0 };
+            NumberHooks hooks{ number };
+            SimpleReader::HookState<NumberHooks> state{
+                { false, m_value, m_end, *m_kernels },
+                hooks
+            };
+            if (!SimpleReader::ParseNumber(state)) {
+                throw std::runtime_error("Malformed JSON number");
+            }
+            return number;
         }
-    };
-
-    //--------------------------------------------------------------------------------------------------------
 
-    class ObjectReader :
-        private ISimpleReaderHooks
-    {
-    public:
-        static std::optional<JsonValue> Parse(std::string_view data, bool ignore_comments = false) {
-            ObjectReader parser;
-            if (!SimpleReader::Parse(data, &parser, ignore_comments)) {
-                return std::nullopt;
+        void RequireLiteral(std::string_view literal) const {
+            if (static_cast<size_t>(m_end - m_value) < literal.size() ||
+                std::memcmp(m_value, literal.data(), literal.size()) != 0
+            ) {
+                throw std::runtime_error("Malformed JSON literal");
             }
-            
-            if (parser.m_stack_top != -1) { return false; }
-            if (!parser.m_has_top_value) { return std::nullopt; }
-            return std::make_optional(std::move(parser.m_stack[0].Value));
         }
 
-    private:
-        ObjectReader() {
-            m_stack.resize(16);
+        //----------------------------------------------------------------------------------------------------
+
+        // Returns the first element or member of the container, or nullptr if it is empty.
+        const char* FirstEntry() const {
+            auto position = SkipWhitespace(m_value + 1);
+            if (position == m_end) { ThrowMalformed(); }
+            if (*position == ']' || *position == '}') { return nullptr; }
+            return position;
         }
 
-        struct Node {
-            JsonValue Value;
-            std::string ObjectKey;
-        };
+        // Returns the element or member after `entry`, or nullptr if it is the last.
+        const char* NextEntry(const char* entry) const {
+            if (IsObject()) {
+                std::string_view key;
+                entry = ReadMember(entry, key);
+            }
 
-        bool m_has_top_value = false;
-        int m_stack_top = -1;
-        std::vector<Node> m_stack;
+            auto position = SkipWhitespace(SkipValue(entry));
+            if (position == m_end) { ThrowMalformed(); }
+            if (*position == ',') {
+                position = SkipWhitespace(position + 1);
+                if (position == m_end) { ThrowMalformed(); }
+                return position;
+            }
+            if (*position == ']' || *position == '}') { return nullptr; }
+            ThrowMalformed();
+        }
+
+        // Reads the key of the member at `entry` and returns the position of its value.
+        const char* ReadMember(const char* entry, std::string_view& key) const {
+            if (*entry != '"') { ThrowMalformed(); }
+            auto key_end = SkipString(entry);
+            key = std::string_view(entry + 1, static_cast<size_t>(key_end - entry - 2));
+
+            auto position = SkipWhitespace(key_end);
+            if (position == m_end || *position != ':') { ThrowMalformed(); }
+            position = SkipWhitespace(position + 1);
+            if (position == m_end) { ThrowMalformed(); }
+            return position;
+        }
 
         //----------------------------------------------------------------------------------------------------
 
-        Node& AllocateNode() {
-            if (m_stack_top == static_cast<int>(m_stack.size())) {
-                m_stack.resize(m_stack.size() + 16);
+        const char* SkipWhitespace(const char* position) const {
+            if (position < m_end && detail::IsWhitespace(*position)) {
+                position = m_kernels->SkipWhitespace(position, m_end);
             }
-            ++m_stack_top;
-            return m_stack[m_stack_top];
+            return position;
         }
 
-        bool SetValue(JsonValue&& value) {
-            if (m_stack_top == -1) {
-                if (m_has_top_value) {
-                    return false;
-                }
-
-                m_stack[0].Value = std::forward<JsonValue>(value);
-                m_has_top_value = true;
-                return true;
+        // Returns the position after the value starting at `position`.
+        const char* SkipValue(const char* position) const {
+            if (position == m_end) { ThrowMalformed(); }
+            switch (*position) {
+            case '"': return SkipString(position);
+            case '[':
+            case '{': return SkipContainer(position);
+            default: return SkipScalar(position);
             }
-
-            return SetValue(m_stack[m_stack_top], std::forward<JsonValue>(value));
         }
 
-        bool SetValue(Node& parent, JsonValue&& value) {
-            auto& parent_value = parent.Value;
-            if (parent_value.Type() == JsonValueType::Array) {
-                auto& json_array = parent_value.AsArray();
-                json_array.emplace_back(std::forward<JsonValue>(value));
-                return true;
+        // Returns the position after the closing quote of the string starting at `position`.
+        const char* SkipString(const char* position) const {
+            ++position;
+            for (;;) {
+                position = m_kernels->FindQuoteOrEscape(position, m_end);
+                if (position == m_end) { ThrowMalformed(); }
+                if (*position == '"') { return position + 1; }
+                if (m_end - position < 2) { ThrowMalformed(); }
+                position += 2;
             }
+        }
 
-            if (parent_value.Type() == JsonValueType::Object) {
-                auto& json_object = parent_value.AsObject();
-                auto& object_key = parent.ObjectKey;
-                json_object.emplace(std::move(object_key), std::forward<JsonValue>(value));
-                return true;
+        const char* SkipScalar(const char* position) const {
+            auto start = position;
+            while (position < m_end) {
+                char c = *position;
+                if (c == ',' || c == ']' || c == '}' || c == ':' || detail::IsWhitespace(c)) { break; }
+                ++position;
             }
+            if (position == start) { ThrowMalformed(); }
+            return position;
+        }
 
-            return false;
+        const char* SkipContainer(const char* position) const {
+            auto end = detail::FindContainerEnd(position, m_end, *m_kernels);
+            if (end == nullptr) { ThrowMalformed(); }
+            return end;
         }
 
         //----------------------------------------------------------------------------------------------------
 
-        bool OnNull() override {
-            return SetValue(JsonValue());
+        [[noreturn]] static void ThrowMalformed() {
+            throw std::runtime_error("Malformed JSON");
         }
-        bool OnBool(bool value) override {
-            return SetValue(JsonValue(value));
+
+        void AssertArray() const {
+            if (!IsArray()) {
+                throw std::logic_error("Value is not an array");
+            }
         }
-        bool OnInt(intmax_t value) override {
-            return SetValue(JsonValue(value));
+        void AssertObject() const {
+            if (!IsObject()) {
+                throw std::logic_error("Value is not an object");
+            }
         }
-        bool OnUInt(uintmax_t value) override {
-            return SetValue(JsonValue(value));
+        void AssertContainer() const {
+            if (!IsArray() && !IsObject()) {
+                throw std::logic_error("Value is not an array or object");
+            }
         }
-        bool OnReal(double value) override {
-            return SetValue(JsonValue(value));
+    };
+
+    //--------------------------------------------------------------------------------------------------------
+
+    struct JsonLazyValue::Member {
+        std::string_view Key;
+        JsonLazyValue Value;
+    };
+
+    //--------------------------------------------------------------------------------------------------------
+
+    template <typename TIterator>
+    class JsonLazyValue::Range {
+    public:
+        Range(TIterator first, TIterator last)
+          : m_first(first),
+            m_last(last)
+        {}
+
+        TIterator begin() const { return m_first; }
+        TIterator end() const { return m_last; }
+
+    private:
+        TIterator m_first;
+        TIterator m_last;
+    };
+
+    //--------------------------------------------------------------------------------------------------------
+
+    class JsonLazyValue::Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = JsonLazyValue;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const JsonLazyValue*;
+        using reference = JsonLazyValue;
+
+        JsonLazyValue operator * () const { return m_container.At(m_entry); }
+
+        Iterator& operator ++ () {
+            m_entry = m_container.NextEntry(m_entry);
+            return *this;
         }
-        bool OnString(std::string_view value) override {
-            return SetValue(JsonValue(value));
+        Iterator operator ++ (int) {
+            Iterator tmp = *this;
+            ++*this;
+            return tmp;
         }
 
-        //----------------------------------------------------------------------------------------------------
+        bool operator == (const Iterator& other) const { return m_entry == other.m_entry; }
+        bool operator != (const Iterator& other) const { return m_entry != other.m_entry; }
 
-        bool OnArrayStart() override {
-            if (m_stack_top == -1) {
-                if (m_has_top_value) {
-                    return false;
-                }
-                m_has_top_value = true;
-            }
+    private:
+        JsonLazyValue m_container;
+        const char* m_entry;
 
-            auto& node = AllocateNode();
-            node.Value = JsonArray();
-            node.Value.AsArray().reserve(16);
-            return true;
-        }
-        bool OnArrayEnd() override {
-            if (m_stack_top < 0) { return false; }
-            if (m_stack_top == 0) {
-                --m_stack_top;
-                return true;
-            }
+        Iterator(const JsonLazyValue& container, const char* entry)
+          : m_container(container),
+            m_entry(entry)
+        {}
 
-            auto& array_node = m_stack[m_stack_top];
-            auto& parent_node = m_stack[m_stack_top - 1];
-            if (!SetValue(parent_node, std::move(array_node.Value))) { return false; }
-            --m_stack_top;
-            return true;
-        }
+        friend class JsonLazyValue;
+    };
 
-        //----------------------------------------------------------------------------------------------------
+    //--------------------------------------------------------------------------------------------------------
 
-        bool OnObjectStart() override {
-            if (m_stack_top == -1) {
-                if (m_has_top_value) {
-                    return false;
-                }
-                m_has_top_value = true;
-            }
+    class JsonLazyValue::MemberIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Member;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Member*;
+        using reference = Member;
+
+        Member operator * () const {
+            std::string_view key;
+            auto value = m_container.ReadMember(m_entry, key);
+            return Member{ key, m_container.At(value) };
+        }
 
-            auto& node = AllocateNode();
-            node.Value = JsonObject();
-            return true;
+        MemberIterator& operator ++ () {
+            m_entry = m_container.NextEntry(m_entry);
+            return *this;
         }
-        bool OnObjectKey(std::string_view value) override {
-            auto& object_node = m_stack[m_stack_top];
-            object_node.ObjectKey = value;
-            return true;
+        MemberIterator operator ++ (int) {
+            MemberIterator tmp = *this;
+            ++*this;
+            return tmp;
         }
-        bool OnObjectEnd() override {
-            if (m_stack_top < 0) { return false; }
-            if (m_stack_top == 0) {
-                --m_stack_top;
-                return true;
-            }
 
-            auto& object_node = m_stack[m_stack_top];
-            auto& parent_node = m_stack[m_stack_top - 1];
-            if (!SetValue(parent_node, std::move(object_node.Value))) { return false; }
-            --m_stack_top;
-            return true;
-        }
+        bool operator == (const MemberIterator& other) const { return m_entry == other.m_entry; }
+        bool operator != (const MemberIterator& other) const { return m_entry != other.m_entry; }
+
+    private:
+        JsonLazyValue m_container;
+        const char* m_entry;
+
+        MemberIterator(const JsonLazyValue& container, const char* entry)
+          : m_container(container),
+            m_entry(entry)
+        {}
+
+        friend class JsonLazyValue;
     };
 
+    //--------------------------------------------------------------------------------------------------------
+
+    inline JsonLazyValue::Range<JsonLazyValue::Iterator> JsonLazyValue::Elements() const {
+        AssertArray();
+        return Range<Iterator>(Iterator(*this, FirstEntry()), Iterator(*this, nullptr));
+    }
+
+    inline JsonLazyValue::Range<JsonLazyValue::MemberIterator> JsonLazyValue::Members() const {
+        AssertObject();
+        return Range<MemberIterator>(MemberIterator(*this, FirstEntry()), MemberIterator(*this, nullptr));
+    }
+
+    inline JsonLazyValue::MemberIterator JsonLazyValue::FindNext(std::string_view key, MemberIterator from) const {
+        AssertObject();
+        for (auto entry = from.m_entry; entry != nullptr; entry = NextEntry(entry)) {
+            std::string_view member_key;
+            ReadMember(entry, member_key);
+            if (member_key == key) { return MemberIterator(*this, entry); }
+        }
+        return MemberIterator(*this, nullptr);
+    }
+
     //--------------------------------------------------------------------------------------------------------
     //--------------------------------------------------------------------------------------------------------
     //--------------------------------------------------------------------------------------------------------
@@ -1217,29 +7324,29 @@ namespace json {
             size_t indentation = 0
         ) {
             switch (root.Type()) {
-            case JsonValueType::String:  WriteString(buf, root.m_data.String); break;
-            case JsonValueType::Int:     WriteInt(buf, root.m_data.Int); break;
-            case JsonValueType::UInt:    WriteUInt(buf, root.m_data.UInt); break;
-            case JsonValueType::Real:    WriteDouble(buf, root.m_data.Real); break;
+            case JsonValueType::String:  WriteString(buf, root.StringView()); break;
+            case JsonValueType::Int:     WriteInt(buf, root.Load<std::intmax_t>()); break;
+            case JsonValueType::UInt:    WriteUInt(buf, root.Load<std::uintmax_t>()); break;
+            case JsonValueType::Real:    WriteDouble(buf, root.Load<double>()); break;
 
             case JsonValueType::Array:
                 if (styled) {
-                    WriteArrayStyled(buf, root.m_data.Array, indentation);
+                    WriteArrayStyled(buf, root.ArrayData(), indentation);
                 } else {
-                    WriteArrayCompact(buf, root.m_data.Array);
+                    WriteArrayCompact(buf, root.ArrayData());
                 }
                 break;
 
             case JsonValueType::Object:
                 if (styled) {
-                    WriteObjectStyled(buf, root.m_data.Object, indentation);
+                    WriteObjectStyled(buf, root.ObjectData(), indentation);
                 } else {
-                    WriteObjectCompact(buf, root.m_data.Object);
+                    WriteObjectCompact(buf, root.ObjectData());
                 }
                 break;
 
             case JsonValueType::Boolean:
-                if (root.m_data.Bool) {
+                if (root.Load<bool>()) {
                     buf.append("true", 4);
                 } else {
                     buf.append("false", 5);
@@ -1253,13 +7360,18 @@ namespace json {
         }
 
     private:
-        static void WriteString(std::string& buf, const std::string& value) {
+        static void WriteString(std::string& buf, std::string_view value) {
             buf += '"';
 
-            auto pos = value.find_first_of("\"/\\\b\f\n\r\t", 0, 8);
-            if (pos == std::string::npos) {
+            // Control characters must always be escaped, so strings holding decoded `\u0000` to `\u001F`
+            // escapes are written back as valid JSON.
+            auto needs_escape = [](char c) {
+                return c == '"' || c == '/' || c == '\\' || static_cast<unsigned char>(c) < 0x20;
+            };
+            if (std::none_of(value.begin(), value.end(), needs_escape)) {
                 buf += value;
             } else {
+                static constexpr char HexDigits[] = "0123456789ABCDEF";
                 for (char c : value) {
                     switch (c) {
                     case '"':  buf.append("\\\"", 2); break;
@@ -1270,7 +7382,15 @@ namespace json {
                     case '\r': buf.append("\\r", 2); break;
                     case '\t': buf.append("\\t", 2); break;
                     case '\\': buf.append("\\\\", 2); break;
-                    default:   buf += c; break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20) {
+                            buf.append("\\u00", 4);
+                            buf += HexDigits[(c >> 4) & 0xF];
+                            buf += HexDigits[c & 0xF];
+                        } else {
+                            buf += c;
+                        }
+                        break;
                     }
                 }
             }
@@ -1429,7 +7549,7 @@ namespace json {
 
             size_t last_index = value.size() - 1;
             size_t i = 0;
-            for (auto kvp : value) {
+            for (auto& kvp : value) {
                 buf.append(indentation + 4, ' ');
                 WriteString(buf, kvp.first);
                 buf.append(" : ", 3);
@@ -11,10 +11,34 @@ namespace {
 
 namespace json_test {
 
-    TEST_CASE(JsonArrayTest, IsVector) {
-        // Check this code compiles correctly.
+    TEST_CASE(JsonArrayTest, InlineStorage) {
+        auto is_inline = [](const JsonArray& arr) {
+            auto begin = reinterpret_cast<const char*>(&arr);
+            auto data = reinterpret_cast<const char*>(arr.data());
+            return data >= begin && data < begin + sizeof(arr);
+        };
+
         JsonArray arr;
-        [[maybe_unused]] std::vector<JsonValue>& vec = arr;
+        CHECK_EQUAL(arr.capacity(), JsonArray::InlineCapacity);
+        for (size_t i = 0; i < JsonArray::InlineCapacity; ++i) {
+            arr.push_back(static_cast<int>(i));
+        }
+        CHECK_TRUE(is_inline(arr));
+
+        arr.push_back("Grows beyond the inline storage");
+        CHECK_FALSE(is_inline(arr));
+        CHECK_EQUAL(arr.size(), JsonArray::InlineCapacity + 1);
+        CHECK_EQUAL(arr[0], 0);
+        CHECK_EQUAL(arr.back(), "Grows beyond the inline storage");
+
+        arr.resize(2);
+        arr.shrink_to_fit();
+        CHECK_TRUE(is_inline(arr));
+        CHECK_EQUAL(arr, JsonArray({ 0, 1 }));
+
+        arr.insert(arr.begin(), "First");
+        arr.erase(arr.begin() + 1);
+        CHECK_EQUAL(arr, JsonArray({ "First", 1 }));
     }
 
     //--------------------------------------------------------------------------------------------------------
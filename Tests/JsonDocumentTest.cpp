@@ -0,0 +1,117 @@
+#include "Json.hpp"
+
+#include "ToString.h"
+#include "CppUnitTestFramework.hpp"
+
+using namespace json;
+
+namespace {
+    struct JsonDocumentTest {};
+}
+
+namespace json_test {
+
+    TEST_CASE(JsonDocumentTest, Parse_Scalars) {
+        CHECK(JsonDocument::Parse("null")->Root().IsNull());
+        CHECK_EQUAL(JsonDocument::Parse("true")->Root().AsBool(), true);
+        CHECK_EQUAL(JsonDocument::Parse("false")->Root().AsBool(), false);
+        CHECK_EQUAL(JsonDocument::Parse("-9223372036854775808")->Root().AsInt(), std::numeric_limits<int64_t>::min());
+        CHECK_EQUAL(JsonDocument::Parse("18446744073709551615")->Root().AsUInt(), std::numeric_limits<uint64_t>::max());
+        CHECK_EQUAL(JsonDocument::Parse("-1.5")->Root().AsDouble(), -1.5);
+        CHECK_EQUAL(JsonDocument::Parse("\"String value\"")->Root().AsString(), "String value");
+
+        // Elements refer to the document, so it must outlive them.
+        auto document = JsonDocument::Parse("1234");
+        auto root = document->Root();
+        CHECK_EQUAL(root.Type(), JsonValueType::UInt);
+        CHECK(root.IsInteger());
+        CHECK_THROW(std::logic_error, root.AsString());
+        CHECK_THROW(std::logic_error, root.Size());
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(JsonDocumentTest, Parse_Invalid) {
+        CHECK_FALSE(JsonDocument::Parse("").has_value());
+        CHECK_FALSE(JsonDocument::Parse("[1, 2").has_value());
+        CHECK_FALSE(JsonDocument::Parse("{\"Key\" 1}").has_value());
+        CHECK_FALSE(JsonDocument::ParseIndexed("[1, 2").has_value());
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(JsonDocumentTest, Array) {
+        auto document = JsonDocument::Parse("[1234, \"Value\", null, [true, []], {\"Inner\": 1.5}, -1]");
+        REQUIRE(document.has_value());
+
+        auto root = document->Root();
+        REQUIRE(root.IsArray());
+        CHECK_EQUAL(root.Size(), 6u);
+        CHECK_FALSE(root.Empty());
+        CHECK_EQUAL(root[0].AsUInt(), 1234u);
+        CHECK_EQUAL(root[1].AsString(), "Value");
+        CHECK(root[2].IsNull());
+        CHECK_EQUAL(root[3].Size(), 2u);
+        CHECK_EQUAL(root[3][0].AsBool(), true);
+        CHECK(root[3][1].Empty());
+        CHECK_EQUAL(root[4].Find("Inner")->AsDouble(), 1.5);
+        CHECK_EQUAL(root[5].AsInt(), -1);
+        CHECK_THROW(std::out_of_range, root[6]);
+
+        size_t count = 0;
+        for (auto element : root.Elements()) {
+            CHECK_EQUAL(element.Type(), root[count].Type());
+            ++count;
+        }
+        CHECK_EQUAL(count, 6u);
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(JsonDocumentTest, Object) {
+        auto document = JsonDocument::Parse("{\"First\": 1234, \"Second\": {\"Inner\": [1, 2, 3]}, \"Third\": \"Value\"}");
+        REQUIRE(document.has_value());
+
+        auto root = document->Root();
+        REQUIRE(root.IsObject());
+        CHECK_EQUAL(root.Size(), 3u);
+        CHECK_EQUAL(root.Find("First")->AsUInt(), 1234u);
+        CHECK_EQUAL(root.Find("Second")->Find("Inner")->Size(), 3u);
+        CHECK_EQUAL(root.Find("Third")->AsString(), "Value");
+        CHECK_FALSE(root.Find("Fourth").has_value());
+        CHECK_TRUE(root.Exists("First", JsonValueType::UInt));
+        CHECK_FALSE(root.Exists("First", JsonValueType::String));
+
+        std::vector<std::string_view> keys;
+        for (auto member : root.Members()) {
+            keys.push_back(member.Key);
+        }
+        CHECK_EQUAL(keys.size(), 3u);
+        CHECK_EQUAL(keys[0], "First");
+        CHECK_EQUAL(keys[1], "Second");
+        CHECK_EQUAL(keys[2], "Third");
+
+        CHECK(JsonDocument::Parse("{}")->Root().Empty());
+        CHECK_THROW(std::logic_error, root.Elements());
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(JsonDocumentTest, ParseIndexed) {
+        std::string json = "[";
+        for (int i = 0; i < 100; ++i) {
+            if (i != 0) { json += ","; }
+            json += "{\"Id\":" + std::to_string(i) + ",\"Tags\":[\"a\",\"b\"]}";
+        }
+        json += "]";
+
+        auto document = JsonDocument::ParseIndexed(json);
+        REQUIRE(document.has_value());
+
+        auto root = document->Root();
+        CHECK_EQUAL(root.Size(), 100u);
+        CHECK_EQUAL(root[42].Find("Id")->AsUInt(), 42u);
+        CHECK_EQUAL(root[99].Find("Tags")->Size(), 2u);
+    }
+
+}
@@ -0,0 +1,205 @@
+#include "Json.hpp"
+
+#include "ToString.h"
+#include "CppUnitTestFramework.hpp"
+
+using namespace json;
+
+namespace {
+    struct JsonLazyValueTest {};
+}
+
+namespace json_test {
+
+    TEST_CASE(JsonLazyValueTest, Parse_Scalars) {
+        CHECK(JsonLazyValue::Parse("null")->IsNull());
+        CHECK_EQUAL(JsonLazyValue::Parse(" true ")->AsBool(), true);
+        CHECK_EQUAL(JsonLazyValue::Parse("false")->AsBool(), false);
+        CHECK_EQUAL(JsonLazyValue::Parse("-9223372036854775808")->AsInt(), std::numeric_limits<int64_t>::min());
+        CHECK_EQUAL(JsonLazyValue::Parse("18446744073709551615")->AsUInt(), std::numeric_limits<uint64_t>::max());
+        CHECK_EQUAL(JsonLazyValue::Parse("-1.5")->AsDouble(), -1.5);
+        CHECK_EQUAL(JsonLazyValue::Parse("\"String \\\" value\"")->AsString(), "String \\\" value");
+
+        auto root = JsonLazyValue::Parse("1234");
+        CHECK_EQUAL(root->Type(), JsonValueType::UInt);
+        CHECK(root->IsInteger());
+        CHECK_EQUAL(root->AsDouble(), 1234.0);
+        CHECK_THROW(std::logic_error, root->AsString());
+        CHECK_THROW(std::logic_error, root->Size());
+
+        CHECK_FALSE(JsonLazyValue::Parse("").has_value());
+        CHECK_FALSE(JsonLazyValue::Parse("  \n").has_value());
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(JsonLazyValueTest, Array) {
+        auto root = JsonLazyValue::Parse("[1234, \"Value\", null, [true, []], {\"Inner\": 1.5}, -1]");
+        REQUIRE(root.has_value());
+        REQUIRE(root->IsArray());
+
+        CHECK_EQUAL(root->Size(), 6u);
+        CHECK_FALSE(root->Empty());
+        CHECK_EQUAL((*root)[0].AsUInt(), 1234u);
+        CHECK_EQUAL((*root)[1].AsString(), "Value");
+        CHECK((*root)[2].IsNull());
+        CHECK_EQUAL((*root)[3].Size(), 2u);
+        CHECK_EQUAL((*root)[3][0].AsBool(), true);
+        CHECK((*root)[3][1].Empty());
+        CHECK_EQUAL((*root)[4].Find("Inner")->AsDouble(), 1.5);
+        CHECK_EQUAL((*root)[5].AsInt(), -1);
+        CHECK_THROW(std::out_of_range, (*root)[6]);
+
+        size_t count = 0;
+        for (auto element : root->Elements()) {
+            CHECK_EQUAL(element.Raw(), (*root)[count].Raw());
+            ++count;
+        }
+        CHECK_EQUAL(count, 6u);
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(JsonLazyValueTest, Object) {
+        auto root = JsonLazyValue::Parse("{\"First\": 1234, \"Second\": {\"Inner\": [1, 2, 3]}, \"Third\": \"Value\"}");
+        REQUIRE(root.has_value());
+        REQUIRE(root->IsObject());
+
+        CHECK_EQUAL(root->Size(), 3u);
+        CHECK_EQUAL(root->Find("First")->AsUInt(), 1234u);
+        CHECK_EQUAL(root->Find("Second")->Find("Inner")->Size(), 3u);
+        CHECK_EQUAL(root->Find("Third")->AsString(), "Value");
+        CHECK_FALSE(root->Find("Fourth").has_value());
+        CHECK_TRUE(root->Exists("First", JsonValueType::UInt));
+        CHECK_FALSE(root->Exists("First", JsonValueType::String));
+
+        std::vector<std::string_view> keys;
+        for (auto member : root->Members()) {
+            keys.push_back(member.Key);
+        }
+        CHECK_EQUAL(keys.size(), 3u);
+        CHECK_EQUAL(keys[0], "First");
+        CHECK_EQUAL(keys[1], "Second");
+        CHECK_EQUAL(keys[2], "Third");
+
+        CHECK(JsonLazyValue::Parse("{ }")->Empty());
+        CHECK_THROW(std::logic_error, root->Elements());
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(JsonLazyValueTest, Find_AnyOrder) {
+        auto root = JsonLazyValue::Parse("{\"A\": 1, \"B\": 2, \"C\": 3, \"D\": 4}");
+        REQUIRE(root.has_value());
+
+        CHECK_EQUAL(root->Find("B")->AsUInt(), 2u);
+        CHECK_EQUAL(root->Find("D")->AsUInt(), 4u);
+        CHECK_EQUAL(root->Find("A")->AsUInt(), 1u);
+        CHECK_EQUAL(root->Find("C")->AsUInt(), 3u);
+        CHECK_EQUAL(root->Find("C")->AsUInt(), 3u);
+        CHECK_FALSE(root->Find("E").has_value());
+        CHECK_EQUAL(root->Find("A")->AsUInt(), 1u);
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(JsonLazyValueTest, Find_DuplicateKeys) {
+        auto root = JsonLazyValue::Parse("{\"a\": 1, \"a\": 2}");
+        REQUIRE(root.has_value());
+
+        // As with `ObjectReader`, the first member with the key is found every time.
+        CHECK_EQUAL(root->Find("a")->AsUInt(), 1u);
+        CHECK_EQUAL(root->Find("a")->AsUInt(), 1u);
+        CHECK_EQUAL(root->Find("a")->AsUInt(), 1u);
+        CHECK_EQUAL(ObjectReader::Parse("{\"a\": 1, \"a\": 2}")->AsObject().at("a"), 1u);
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(JsonLazyValueTest, FindNext) {
+        auto root = JsonLazyValue::Parse("{\"A\": 1, \"B\": [1, 2, 3], \"A\": 2, \"C\": 3}");
+        REQUIRE(root.has_value());
+        auto members = root->Members();
+
+        auto a = root->FindNext("A", members.begin());
+        REQUIRE(a != members.end());
+        CHECK_EQUAL((*a).Value.AsUInt(), 1u);
+
+        auto b = root->FindNext("B", std::next(a));
+        REQUIRE(b != members.end());
+        CHECK_EQUAL((*b).Value[1].AsUInt(), 2u);
+
+        auto second_a = root->FindNext("A", std::next(b));
+        REQUIRE(second_a != members.end());
+        CHECK_EQUAL((*second_a).Value.AsUInt(), 2u);
+
+        // The search only moves forward.
+        CHECK_TRUE(root->FindNext("B", std::next(second_a)) == members.end());
+        CHECK_EQUAL((*root->FindNext("C", std::next(second_a))).Value.AsUInt(), 3u);
+        CHECK_THROW(std::logic_error, JsonLazyValue::Parse("[1]")->FindNext("A", members.begin()));
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(JsonLazyValueTest, Skip) {
+        // Brackets and quotes inside strings, and strings that span classification blocks.
+        std::string long_string(150, 'x');
+        std::string json =
+            "{\"Skipped\": [\"]}\", {\"[\": \"\\\"]\"}, \"" + long_string + "\", [[[]]], {\"" + long_string + "\": {}}],"
+            " \"Wanted\": [\"a\", \"b\"]}";
+
+        auto root = JsonLazyValue::Parse(json);
+        REQUIRE(root.has_value());
+        CHECK_EQUAL(root->Find("Wanted")->Size(), 2u);
+        CHECK_EQUAL(root->Find("Skipped")->Size(), 5u);
+        CHECK_EQUAL((*root->Find("Skipped"))[1].Find("[")->AsString(), "\\\"]");
+        CHECK_EQUAL((*root->Find("Skipped"))[2].AsString(), long_string);
+
+        // Escaped quotes and runs of backslashes at every position relative to a block boundary.
+        for (size_t padding = 0; padding < 64; ++padding) {
+            std::string escapes = "{\"Skipped\": [\"" + std::string(padding, ' ') + "\\\"]\\\\\", \"\\\\\\\"}\"], \"Wanted\": 1}";
+            auto value = JsonLazyValue::Parse(escapes);
+            CHECK_EQUAL(value->Find("Wanted")->AsUInt(), 1u);
+            CHECK_EQUAL(value->Find("Skipped")->Size(), 2u);
+        }
+
+        // Large containers span many blocks.
+        std::string large = "[";
+        for (int i = 0; i < 1000; ++i) {
+            if (i != 0) { large += ","; }
+            large += "{\"Id\":" + std::to_string(i) + ",\"Tags\":[\"a\",\"b\"]}";
+        }
+        large += "]";
+        auto array = JsonLazyValue::Parse(large);
+        CHECK_EQUAL(array->Size(), 1000u);
+        CHECK_EQUAL((*array)[999].Find("Id")->AsUInt(), 999u);
+        CHECK_EQUAL(array->Raw().size(), large.size());
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(JsonLazyValueTest, Materialize) {
+        auto root = JsonLazyValue::Parse("{\"Ignored\": [1, 2], \"Value\": {\"A\": [1, \"Two\"]}}");
+        REQUIRE(root.has_value());
+
+        auto value = root->Find("Value")->Materialize();
+        REQUIRE(value.has_value());
+        CHECK_EQUAL(value->AsObject().at("A").AsArray(), JsonArray({ 1u, "Two" }));
+        CHECK_EQUAL(root->Find("Value")->Raw(), "{\"A\": [1, \"Two\"]}");
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(JsonLazyValueTest, Malformed) {
+        CHECK_THROW(std::runtime_error, JsonLazyValue::Parse("[1, 2")->Size());
+        CHECK_THROW(std::runtime_error, JsonLazyValue::Parse("{\"A\" 1}")->Find("A"));
+        CHECK_THROW(std::runtime_error, JsonLazyValue::Parse("{\"A\": [1, 2}")->Find("B"));
+        CHECK_THROW(std::runtime_error, JsonLazyValue::Parse("\"Unterminated")->AsString());
+        CHECK_THROW(std::runtime_error, JsonLazyValue::Parse("nul")->IsNull());
+        CHECK_THROW(std::runtime_error, JsonLazyValue::Parse("-x")->AsInt());
+
+        // Values that are never reached aren't validated.
+        CHECK_EQUAL(JsonLazyValue::Parse("{\"A\": 1, \"B\": [}")->Find("A")->AsUInt(), 1u);
+    }
+
+}
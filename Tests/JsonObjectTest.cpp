@@ -11,10 +11,43 @@ namespace {
 
 namespace json_test {
 
-    TEST_CASE(JsonObjectTest, IsMap) {
-        // Check this code compiles correctly.
+    TEST_CASE(JsonObjectTest, SortedMembers) {
+        JsonObject obj {
+            { "Charlie", 3 },
+            { "Alpha", 1 },
+            { "Bravo", 2 },
+            { "Alpha", "Ignored" }
+        };
+        CHECK_EQUAL(obj.size(), 3u);
+        CHECK_EQUAL(obj.begin()->first.View(), "Alpha");
+        CHECK_EQUAL(obj.begin()->second, 1);
+        CHECK_EQUAL((obj.end() - 1)->first.View(), "Charlie");
+
+        CHECK_FALSE(obj.emplace("Bravo", "Ignored").second);
+        CHECK_TRUE(obj.emplace("Delta", 4).second);
+        CHECK_EQUAL(obj.at("Bravo"), 2);
+        CHECK_EQUAL(obj.count("Delta"), 1u);
+        CHECK_TRUE(obj.find("Echo") == obj.end());
+        CHECK_THROW(std::out_of_range, obj.at("Echo"));
+
+        CHECK_EQUAL(obj.erase("Alpha"), 1u);
+        CHECK_EQUAL(obj.erase("Alpha"), 0u);
+        CHECK_EQUAL(obj.begin()->first.View(), "Bravo");
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(JsonObjectTest, ManyMembers) {
+        // Past a few members, keys are found by bisection rather than linearly.
         JsonObject obj;
-        [[maybe_unused]] std::map<std::string, JsonValue, std::less<>>& map = obj;
+        for (int i = 99; i >= 0; --i) {
+            obj[std::to_string(i)] = i;
+        }
+        CHECK_EQUAL(obj.size(), 100u);
+        for (int i = 0; i < 100; ++i) {
+            CHECK_EQUAL(obj.at(std::to_string(i)), i);
+        }
+        CHECK_TRUE(std::is_sorted(obj.begin(), obj.end(), [](auto& lhs, auto& rhs) { return lhs.first < rhs.first; }));
     }
 
     //--------------------------------------------------------------------------------------------------------
@@ -88,6 +121,43 @@ namespace json_test {
 
     //--------------------------------------------------------------------------------------------------------
 
+    TEST_CASE(JsonObjectTest, InsertionOrder) {
+        JsonObject obj(KeyOrder::Insertion, {
+            { "Charlie", 3 },
+            { "Alpha", 1 },
+            { "Charlie", "Ignored" }
+        });
+        CHECK_TRUE(obj.Order() == KeyOrder::Insertion);
+        CHECK_EQUAL(obj.size(), 2u);
+        CHECK_EQUAL(obj.begin()->first.View(), "Charlie");
+        CHECK_EQUAL(obj.at("Charlie"), 3);
+        CHECK_EQUAL(obj, JsonObject({ { "Alpha", 1 }, { "Charlie", 3 } }));
+
+        // Past a few members, keys are found through a hash index.
+        for (int i = 99; i >= 0; --i) {
+            obj[std::to_string(i)] = i;
+        }
+        CHECK_EQUAL(obj.size(), 102u);
+        CHECK_EQUAL((obj.end() - 1)->first.View(), "0");
+        for (int i = 0; i < 100; ++i) {
+            CHECK_EQUAL(obj.at(std::to_string(i)), i);
+        }
+        CHECK_FALSE(obj.emplace("50", "Ignored").second);
+
+        CHECK_EQUAL(obj.erase("Alpha"), 1u);
+        CHECK_EQUAL(obj.erase("99"), 1u);
+        CHECK_EQUAL(obj.size(), 100u);
+        CHECK_EQUAL((obj.begin() + 1)->first.View(), "98");
+        CHECK_EQUAL(obj.count("Alpha"), 0u);
+        CHECK_EQUAL(obj.at("0"), 0);
+
+        JsonObject copy(obj);
+        CHECK_EQUAL(copy.at("Charlie"), 3);
+        CHECK_EQUAL(copy, obj);
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
     TEST_CASE(JsonObjectTest, Exists) {
         JsonObject obj {
             { "First", 1234 },
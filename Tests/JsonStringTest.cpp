@@ -0,0 +1,108 @@
+#include "Json.hpp"
+
+#include "ToString.h"
+#include "CppUnitTestFramework.hpp"
+
+using namespace json;
+
+namespace {
+    struct JsonStringTest {};
+}
+
+namespace json_test {
+
+    TEST_CASE(JsonStringTest, Constructor) {
+        JsonString empty;
+        CHECK_EQUAL(empty.Size(), 0u);
+        CHECK_TRUE(empty == "");
+
+        JsonString inline_string("Short");
+        CHECK_EQUAL(inline_string.View(), "Short");
+
+        JsonString long_string(std::string("A string too long to be stored inline"));
+        CHECK_EQUAL(long_string.View(), "A string too long to be stored inline");
+        CHECK_EQUAL(long_string.Size(), 37u);
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(JsonStringTest, Copy_SharesBlock) {
+        JsonString original("A string too long to be stored inline");
+        JsonString copy(original);
+        CHECK_TRUE(copy.SharesWith(original));
+        CHECK_TRUE(copy.Data() == original.Data());
+
+        JsonString moved(std::move(copy));
+        CHECK_TRUE(moved.SharesWith(original));
+        CHECK_EQUAL(copy.Size(), 0u);
+
+        JsonString inline_string("Short");
+        CHECK_FALSE(JsonString(inline_string).SharesWith(inline_string));
+
+        copy = original;
+        original = inline_string;
+        CHECK_EQUAL(copy.View(), "A string too long to be stored inline");
+        CHECK_EQUAL(original.View(), "Short");
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(JsonStringTest, Comparison) {
+        JsonString a("a");
+        JsonString b("b");
+        CHECK_TRUE(a < b);
+        CHECK_TRUE(a == JsonString("a"));
+        CHECK_TRUE(a != b);
+        CHECK_TRUE(a == "a");
+        CHECK_TRUE("b" == b);
+        CHECK_TRUE(a < std::string_view("b"));
+        CHECK_TRUE(std::string("a") < b);
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(JsonStringTest, StringPool_Intern) {
+        StringPool pool;
+        auto first = pool.Intern("A string too long to be stored inline");
+        auto second = pool.Intern(std::string("A string too long to be stored inline"));
+        CHECK_TRUE(first.SharesWith(second));
+        CHECK_EQUAL(pool.Size(), 1u);
+
+        // Inline strings aren't pooled.
+        pool.Intern("Short");
+        CHECK_EQUAL(pool.Size(), 1u);
+
+        pool.Clear();
+        CHECK_EQUAL(pool.Size(), 0u);
+        CHECK_EQUAL(first.View(), "A string too long to be stored inline");
+        CHECK_FALSE(pool.Intern("A string too long to be stored inline").SharesWith(first));
+
+        StringPool short_pool(20);
+        CHECK_FALSE(short_pool.InternValue(first).SharesWith(short_pool.InternValue(first)));
+        CHECK_TRUE(short_pool.Intern(first).SharesWith(short_pool.Intern(first)));
+        CHECK_TRUE(&StringPool::ThreadLocal() == &StringPool::ThreadLocal());
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(JsonStringTest, StringPool_MaxSize) {
+        StringPool pool(StringPool::DefaultMaxValueSize, 3);
+        CHECK_EQUAL(pool.MaxSize(), 3u);
+
+        auto first = pool.Intern("The first string, too long to be stored inline");
+        for (int i = 0; i < 2; ++i) {
+            pool.Intern("Another string, too long to be stored inline " + std::to_string(i));
+        }
+        CHECK_EQUAL(pool.Size(), 3u);
+        CHECK_TRUE(pool.Intern(first).SharesWith(first));
+
+        // A full pool is cleared before another string is added.
+        pool.Intern("One string too many for the pool to hold");
+        CHECK_EQUAL(pool.Size(), 1u);
+        CHECK_FALSE(pool.Intern(first).SharesWith(first));
+        CHECK_EQUAL(pool.Size(), 2u);
+
+        CHECK_EQUAL(StringPool().MaxSize(), StringPool::DefaultMaxSize);
+    }
+
+}
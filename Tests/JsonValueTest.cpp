@@ -3,6 +3,8 @@
 #include "ToString.h"
 #include "CppUnitTestFramework.hpp"
 #include <cmath>
+#include <thread>
+#include <utility>
 
 using namespace json;
 
@@ -559,4 +561,117 @@ namespace json_test {
         CHECK_THROW(std::logic_error, JsonValue(JsonValueType::Array).AsObject());
     }
 
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(JsonValueTest, CompactStorage) {
+        CHECK_EQUAL(sizeof(JsonValue), 16u);
+
+        // Strings up to the inline capacity and just beyond it.
+        std::string inline_string(JsonString::InlineCapacity, 'x');
+        std::string long_string(JsonString::InlineCapacity + 1, 'y');
+        JsonValue inline_value(inline_string);
+        JsonValue long_value(long_string);
+        CHECK_EQUAL(inline_value.AsString(), inline_string);
+        CHECK_EQUAL(long_value.AsString(), long_string);
+
+        JsonValue copy(long_value);
+        JsonValue moved(std::move(long_value));
+        CHECK_EQUAL(copy.AsString(), long_string);
+        CHECK_EQUAL(moved.AsString(), long_string);
+        CHECK_TRUE(long_value.IsNull());
+
+        copy = inline_value;
+        moved = copy;
+        CHECK_EQUAL(moved.AsString(), inline_string);
+
+        JsonValue array(JsonArray{ 1, long_string, JsonObject{ { long_string, -2 } } });
+        JsonValue array_copy(array);
+        array_copy.AsArray().push_back(3.5);
+        CHECK_EQUAL(array.AsArray().size(), 3u);
+        CHECK_EQUAL(array_copy.AsArray().size(), 4u);
+        CHECK_EQUAL(array_copy.AsArray()[2].AsObject().at(long_string), -2);
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(JsonValueTest, CopyOnWrite) {
+        JsonValue original(JsonArray{ 1, JsonObject{ { "Key", "Value" } } });
+        const JsonValue& const_original = original;
+
+        // Copies share the array until one of them is changed.
+        JsonValue copy(original);
+        const JsonValue& const_copy = copy;
+        CHECK_TRUE(const_copy.AsArray().data() == const_original.AsArray().data());
+
+        copy.AsArray().push_back(2);
+        CHECK_FALSE(const_copy.AsArray().data() == const_original.AsArray().data());
+        CHECK_EQUAL(const_original.AsArray().size(), 2u);
+        CHECK_EQUAL(const_copy.AsArray().size(), 3u);
+
+        // The elements of the private copy still share their contents with the original.
+        auto& original_object = const_original.AsArray()[1].AsObject();
+        CHECK_TRUE(&const_copy.AsArray()[1].AsObject() == &original_object);
+        copy.AsArray()[1].AsObject()["Key"] = "Changed";
+        CHECK_EQUAL(original_object.at("Key"), "Value");
+        CHECK_EQUAL(const_copy.AsArray()[1].AsObject().at("Key"), "Changed");
+
+        // A value that isn't shared is changed in place.
+        auto data = const_copy.AsArray().data();
+        copy.AsArray().push_back(3);
+        copy.AsArray().pop_back();
+        CHECK_TRUE(const_copy.AsArray().data() == data);
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(JsonValueTest, CopyOnWrite_ReferenceThenCopy) {
+        JsonValue root(JsonObject{ { "Nested", JsonObject{ { "Key", "Value" } } } });
+
+        // A copy taken while a mutable reference exists doesn't see changes made through it.
+        JsonObject& object = root.AsObject();
+        JsonValue snapshot = root;
+        object["x"] = 5u;
+        CHECK_EQUAL(root.AsObject().count("x"), 1u);
+        CHECK_EQUAL(std::as_const(snapshot).AsObject().count("x"), 0u);
+
+        // The same holds for a reference into a nested value.
+        JsonObject& nested = object["Nested"].AsObject();
+        JsonValue nested_snapshot = root;
+        nested["Key"] = "Changed";
+        CHECK_EQUAL(std::as_const(nested_snapshot).AsObject().at("Nested").AsObject().at("Key"), "Value");
+        CHECK_EQUAL(std::as_const(root).AsObject().at("Nested").AsObject().at("Key"), "Changed");
+
+        // Values only read through const references are still shared.
+        const JsonValue shared(JsonArray{ 1, 2 });
+        JsonValue shared_copy = shared;
+        CHECK_TRUE(std::as_const(shared_copy).AsArray().data() == shared.AsArray().data());
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(JsonValueTest, CopyOnWrite_Threads) {
+        JsonValue shared(JsonObject{ { "Items", JsonArray{ 1, 2, 3 } } });
+
+        std::vector<std::thread> threads;
+        std::vector<size_t> sizes(4);
+        for (size_t i = 0; i < sizes.size(); ++i) {
+            threads.emplace_back([&shared, &sizes, i]() {
+                for (size_t j = 0; j < 1000; ++j) {
+                    JsonValue copy(shared);
+                    auto& items = copy.AsObject()["Items"].AsArray();
+                    items.push_back(static_cast<uint64_t>(j));
+                    sizes[i] = items.size();
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        for (auto size : sizes) {
+            CHECK_EQUAL(size, 4u);
+        }
+        CHECK_EQUAL(shared, JsonValue(JsonObject{ { "Items", JsonArray{ 1, 2, 3 } } }));
+    }
+
 }
\ No newline at end of file
@@ -0,0 +1,228 @@
+#include "Json.hpp"
+
+#include "ToString.h"
+#include "CppUnitTestFramework.hpp"
+
+using namespace json;
+
+namespace {
+    struct NdjsonReaderTest {
+        // One record per line, numbered from zero, with a malformed line every 7th line and a blank line
+        // every 11th.
+        static std::string MakeInput(size_t line_count) {
+            std::string data;
+            for (size_t i = 0; i < line_count; ++i) {
+                if (i % 11 == 10) {
+                    data += "  \r\n";
+                } else if (i % 7 == 6) {
+                    data += "{\"Id\": " + std::to_string(i) + ", oops}\n";
+                } else {
+                    data += "{\"Id\": " + std::to_string(i) + ", \"Tags\": [\"a\", \"b\"]}\r\n";
+                }
+            }
+            return data;
+        }
+
+        struct CountingHooks : ISimpleReaderHooks {
+            size_t Objects = 0;
+
+            bool OnNull() override { return true; }
+            bool OnBool(bool) override { return true; }
+            bool OnInt(int64_t) override { return true; }
+            bool OnUInt(uint64_t) override { return true; }
+            bool OnReal(double) override { return true; }
+            bool OnString(std::string_view) override { return true; }
+
+            bool OnArrayStart() override { return true; }
+            bool OnArrayEnd() override { return true; }
+
+            bool OnObjectStart() override { ++Objects; return true; }
+            bool OnObjectKey(std::string_view) override { return true; }
+            bool OnObjectEnd() override { return true; }
+        };
+    };
+}
+
+namespace json_test {
+
+    TEST_CASE(NdjsonReaderTest, Parse_Ordered) {
+        auto data = MakeInput(5000);
+
+        NdjsonReader::Options options;
+        options.ThreadCount = 4;
+        options.BatchSize = 1024;
+
+        std::vector<uint64_t> ids;
+        std::vector<std::string_view> errors;
+        NdjsonReader::Parse(
+            data,
+            [&](JsonValue&& value, std::string_view) { ids.push_back(value.AsObject().at("Id").AsUInt()); },
+            [&](std::string_view line) { errors.push_back(line); },
+            options
+        );
+
+        std::vector<uint64_t> expected_ids;
+        size_t expected_errors = 0;
+        for (uint64_t i = 0; i < 5000; ++i) {
+            if (i % 11 == 10) { continue; }
+            if (i % 7 == 6) {
+                ++expected_errors;
+            } else {
+                expected_ids.push_back(i);
+            }
+        }
+
+        CHECK_TRUE(ids == expected_ids);
+        CHECK_EQUAL(errors.size(), expected_errors);
+        CHECK_EQUAL(errors[0], "{\"Id\": 6, oops}");
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(NdjsonReaderTest, Parse_Unordered) {
+        auto data = MakeInput(5000);
+
+        NdjsonReader::Options options;
+        options.ThreadCount = 4;
+        options.BatchSize = 1024;
+        options.Ordered = false;
+
+        std::vector<uint64_t> ids;
+        size_t error_count = 0;
+        NdjsonReader::Parse(
+            data,
+            [&](JsonValue&& value, std::string_view) { ids.push_back(value.AsObject().at("Id").AsUInt()); },
+            [&](std::string_view) { ++error_count; },
+            options
+        );
+
+        std::sort(ids.begin(), ids.end());
+        CHECK_EQUAL(ids.size(), 3896u);
+        CHECK_EQUAL(ids.front(), 0u);
+        CHECK_EQUAL(ids.back(), 4999u);
+        CHECK_TRUE(std::adjacent_find(ids.begin(), ids.end()) == ids.end());
+        CHECK_EQUAL(error_count, 650u);
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(NdjsonReaderTest, Parse_Lines) {
+        SECTION("Final line without newline") {
+            std::vector<JsonValue> values;
+            NdjsonReader::Parse("1\n[2]", [&](JsonValue&& value, std::string_view) { values.push_back(std::move(value)); }, [](std::string_view) {});
+            REQUIRE(values.size() == 2u);
+            CHECK_EQUAL(values[0], 1u);
+            CHECK_EQUAL(values[1].AsArray(), JsonArray({ 2u }));
+        }
+        SECTION("Record text") {
+            std::vector<std::string_view> lines;
+            NdjsonReader::Parse("1\r\n\n2\n", [&](JsonValue&&, std::string_view line) { lines.push_back(line); }, [](std::string_view) {});
+            CHECK_TRUE(lines == std::vector<std::string_view>({ "1", "2" }));
+        }
+        SECTION("Trailing values are malformed") {
+            std::vector<std::string_view> errors;
+            NdjsonReader::Parse("1 2\n3\n", [](JsonValue&&, std::string_view) {}, [&](std::string_view line) { errors.push_back(line); });
+            CHECK_TRUE(errors == std::vector<std::string_view>({ "1 2" }));
+        }
+        SECTION("Comments") {
+            NdjsonReader::Options options;
+            options.IgnoreComments = true;
+
+            size_t count = 0;
+            NdjsonReader::Parse("1 // One\n/* Two */ 2\n", [&](JsonValue&&, std::string_view) { ++count; }, [](std::string_view) {}, options);
+            CHECK_EQUAL(count, 2u);
+        }
+        SECTION("Empty") {
+            size_t count = 0;
+            NdjsonReader::Parse("", [&](JsonValue&&, std::string_view) { ++count; }, [&](std::string_view) { ++count; });
+            CHECK_EQUAL(count, 0u);
+        }
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(NdjsonReaderTest, ParseWithHooks) {
+        auto data = MakeInput(5000);
+
+        NdjsonReader::Options options;
+        options.ThreadCount = 4;
+        options.BatchSize = 1024;
+
+        size_t objects = 0;
+        size_t error_count = 0;
+        NdjsonReader::ParseWithHooks(
+            data,
+            []() { return CountingHooks(); },
+            [&](CountingHooks&& hooks) { objects += hooks.Objects; },
+            [&](std::string_view) { ++error_count; },
+            options
+        );
+
+        // Malformed lines are not passed on to the hooks.
+        CHECK_EQUAL(objects, 3896u);
+        CHECK_EQUAL(error_count, 650u);
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(NdjsonReaderTest, ParseWithHooks_HookResults) {
+        struct TagHooks {
+            std::vector<std::string> Strings;
+
+            bool OnNull() { return true; }
+            bool OnBool(bool) { return true; }
+            bool OnInt(int64_t) { return true; }
+            bool OnUInt(uint64_t) { return true; }
+            bool OnReal(double) { return true; }
+            HookResult OnString(std::string_view value) {
+                Strings.emplace_back(value);
+                return value == "fail" ? HookResult::Fail : HookResult::Continue;
+            }
+
+            HookResult OnArrayStart() { return HookResult::Continue; }
+            bool OnArrayEnd() { return true; }
+
+            bool OnObjectStart() { return true; }
+            HookResult OnObjectKey(std::string_view value) {
+                if (value == "Skip") { return HookResult::Skip; }
+                if (value == "Stop") { return HookResult::Stop; }
+                return HookResult::Continue;
+            }
+            bool OnObjectEnd() { return true; }
+        };
+
+        std::string_view data =
+            "{\"Skip\": [\"a\", {\"b\": \"c\"}], \"Keep\": \"d\"}\n"
+            "{\"Stop\": \"e\"}\n"
+            "[\"f\", \"fail\", \"g\"]\n"
+            "[\"h\", oops]\n"
+            "\"i\"\n";
+
+        std::vector<std::string> strings;
+        std::vector<std::string_view> errors;
+        NdjsonReader::ParseWithHooks(
+            data,
+            []() { return TagHooks(); },
+            [&](TagHooks&& hooks) { strings.insert(strings.end(), hooks.Strings.begin(), hooks.Strings.end()); },
+            [&](std::string_view line) { errors.push_back(line); }
+        );
+
+        CHECK_TRUE(strings == std::vector<std::string>({ "d", "f", "fail", "i" }));
+        CHECK_TRUE(errors == std::vector<std::string_view>({ "[\"f\", \"fail\", \"g\"]", "[\"h\", oops]" }));
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(NdjsonReaderTest, Parse_CallbackException) {
+        auto data = MakeInput(5000);
+
+        NdjsonReader::Options options;
+        options.ThreadCount = 4;
+        options.BatchSize = 1024;
+
+        auto on_record = [](JsonValue&&, std::string_view) { throw std::runtime_error("Stop"); };
+        auto on_error = [](std::string_view) {};
+        CHECK_THROW(std::runtime_error, NdjsonReader::Parse(data, on_record, on_error, options));
+    }
+
+}
@@ -0,0 +1,106 @@
+#include "Json.hpp"
+
+#include "ToString.h"
+#include "CppUnitTestFramework.hpp"
+
+using namespace json;
+
+namespace {
+    struct ObjectReaderIndexedTest {};
+}
+
+namespace json_test {
+
+    TEST_CASE(ObjectReaderIndexedTest, Parse_Scalars) {
+        CHECK_EQUAL(ObjectReader::ParseIndexed("null"), nullptr);
+        CHECK_EQUAL(ObjectReader::ParseIndexed("true"), true);
+        CHECK_EQUAL(ObjectReader::ParseIndexed(" false "), false);
+        CHECK_EQUAL(ObjectReader::ParseIndexed("-9223372036854775808"), std::numeric_limits<int64_t>::min());
+        CHECK_EQUAL(ObjectReader::ParseIndexed("18446744073709551615"), std::numeric_limits<uint64_t>::max());
+        CHECK_EQUAL(ObjectReader::ParseIndexed("-1.5"), -1.5);
+        CHECK_EQUAL(ObjectReader::ParseIndexed("\"\""), "");
+        CHECK_EQUAL(ObjectReader::ParseIndexed(u8"\"ハローワールド\""), u8"ハローワールド");
+        CHECK_EQUAL(ObjectReader::ParseIndexed(""), std::nullopt);
+        CHECK_EQUAL(ObjectReader::ParseIndexed("   "), std::nullopt);
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(ObjectReaderIndexedTest, Parse_Containers) {
+        CHECK_EQUAL(ObjectReader::ParseIndexed("[]")->AsArray(), JsonArray{});
+        CHECK_EQUAL(ObjectReader::ParseIndexed("{}")->AsObject(), JsonObject{});
+        CHECK_EQUAL(
+            ObjectReader::ParseIndexed("[\n    1234,\n    \"Value\",\n    null,\n    true\n]")->AsArray(),
+            JsonArray({ 1234u, "Value", nullptr, true })
+        );
+        CHECK_EQUAL(
+            ObjectReader::ParseIndexed("{\"First\":1234,\"Second\":[\"Value\",{}],\"Third\":{\"Inner\":[]}}")->AsObject(),
+            JsonObject({
+                { "First", 1234u },
+                { "Second", JsonArray{ "Value", JsonObject{} } },
+                { "Third", JsonObject{ { "Inner", JsonArray{} } } }
+            })
+        );
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(ObjectReaderIndexedTest, Parse_Strings) {
+        SECTION("Escapes") {
+            CHECK_EQUAL(ObjectReader::ParseIndexed("\"a\\\"b\""), "a\"b");
+            CHECK_EQUAL(ObjectReader::ParseIndexed("[\"a\\\\\",\"b\"]")->AsArray(), JsonArray({ "a\\", "b" }));
+            CHECK_EQUAL(ObjectReader::ParseIndexed("[\"a\\\\\\\"\",\"b\"]")->AsArray(), JsonArray({ "a\\\"", "b" }));
+            CHECK_EQUAL(ObjectReader::ParseIndexed("{\"[{:,}]\":\"]\"}")->AsObject(), JsonObject({ { "[{:,}]", "]" } }));
+        }
+
+        SECTION("Block boundaries") {
+            // Move an escaped quote and a run of backslashes across the 64-byte block boundaries.
+            for (size_t padding = 0; padding < 130; ++padding) {
+                std::string prefix(padding, 'x');
+                std::string json = "[\"" + prefix + "\\\\\\\"\\\\\", \"" + prefix + "\\\\\"]";
+                auto value = ObjectReader::ParseIndexed(json);
+                REQUIRE(value.has_value());
+                CHECK_EQUAL(value->AsArray(), JsonArray({ prefix + "\\\"\\", prefix + "\\" }));
+            }
+        }
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(ObjectReaderIndexedTest, Parse_Invalid) {
+        for (auto json : {
+            "[", "]", "{", "}", "[1,]", "[1 2]", "[1,,2]", "[truex]", "[1\"a\"]", "{\"a\"}", "{\"a\":}",
+            "{\"a\" 1}", "{1:2}", "[}", "{]", "\"Unterminated", "[\"Unterminated\\\"]", ",", ":", "[\\]"
+        }) {
+            CHECK_EQUAL(ObjectReader::ParseIndexed(json), std::nullopt);
+            CHECK_EQUAL(ObjectReader::Parse(json), std::nullopt);
+        }
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(ObjectReaderIndexedTest, Parse_MatchesParse) {
+        std::string json = "{\"Records\":[";
+        for (int i = 0; i < 200; ++i) {
+            if (i != 0) { json += ",\n"; }
+            json += "{\"Id\": " + std::to_string(i) + ", \"Name\": \"Record \\\"" + std::to_string(i) + "\\\"\", ";
+            json += "\"Scores\": [1.5, -2, true, false, null], \"Nested\": {\"Empty\": [], \"Key\": \"" + std::string(i % 70, 'z') + "\"}}";
+        }
+        json += "]}";
+
+        auto expected = ObjectReader::Parse(json);
+        auto actual = ObjectReader::ParseIndexed(json);
+        REQUIRE(expected.has_value());
+        REQUIRE(actual.has_value());
+        CHECK(*expected == *actual);
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(ObjectReaderIndexedTest, Parse_Comments) {
+        // Comments fall back to the single pass parser.
+        CHECK_EQUAL(ObjectReader::ParseIndexed("[10/* After item */\n]", true)->AsArray(), JsonArray({ 10u }));
+        CHECK_EQUAL(ObjectReader::ParseIndexed("[10/* After item */\n]"), std::nullopt);
+    }
+
+}
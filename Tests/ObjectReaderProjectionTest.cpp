@@ -0,0 +1,101 @@
+#include "Json.hpp"
+
+#include "ToString.h"
+#include "CppUnitTestFramework.hpp"
+
+using namespace json;
+
+namespace {
+    struct ObjectReaderProjectionTest {
+        static constexpr std::string_view Document =
+            "{\"user\": {\"id\": 7, \"name\": \"Name\", \"tags\": [\"a\", \"b\"]},"
+            " \"events\": [{\"ts\": 1, \"kind\": \"x\"}, {\"ts\": 2, \"data\": [1, 2]}, {\"kind\": \"y\"}],"
+            " \"count\": 3}";
+    };
+}
+
+namespace json_test {
+
+    TEST_CASE(ObjectReaderProjectionTest, Parse_Paths) {
+        auto value = ObjectReader::ParsePaths(Document, { "/user/id", "/events/*/ts" });
+        REQUIRE(value.has_value());
+        CHECK_EQUAL(
+            value->AsObject(),
+            JsonObject({
+                { "user", JsonObject{ { "id", 7u } } },
+                { "events", JsonArray{ JsonObject{ { "ts", 1u } }, JsonObject{ { "ts", 2u } }, JsonObject{} } }
+            })
+        );
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(ObjectReaderProjectionTest, Parse_Subtrees) {
+        SECTION("Whole values") {
+            auto value = ObjectReader::ParsePaths(Document, { "/user/tags", "/events/1" });
+            REQUIRE(value.has_value());
+            CHECK_EQUAL(
+                value->AsObject(),
+                JsonObject({
+                    { "user", JsonObject{ { "tags", JsonArray{ "a", "b" } } } },
+                    { "events", JsonArray{ JsonObject{ { "ts", 2u }, { "data", JsonArray{ 1u, 2u } } } } }
+                })
+            );
+        }
+        SECTION("Overlapping paths") {
+            auto value = ObjectReader::ParsePaths(Document, { "/user", "/user/id", "/events/*/kind", "/events/0" });
+            REQUIRE(value.has_value());
+            CHECK_EQUAL(value->AsObject().at("user"), ObjectReader::Parse(Document)->AsObject().at("user"));
+            CHECK_EQUAL(
+                value->AsObject().at("events").AsArray(),
+                JsonArray({ JsonObject{ { "ts", 1u }, { "kind", "x" } }, JsonObject{}, JsonObject{ { "kind", "y" } } })
+            );
+        }
+        SECTION("Root") {
+            CHECK_EQUAL(ObjectReader::ParsePaths(Document, { "" }), ObjectReader::Parse(Document));
+            CHECK_EQUAL(ObjectReader::ParsePaths("[1, [2]]", { "/*" })->AsArray(), JsonArray({ 1u, JsonArray{ 2u } }));
+            CHECK_EQUAL(ObjectReader::ParsePaths("5", { "/a" }), nullptr);
+        }
+        SECTION("Escaped tokens") {
+            auto value = ObjectReader::ParsePaths("{\"a/b\": {\"c~d\": 1, \"e\": 2}}", { "/a~1b/c~0d" });
+            CHECK_EQUAL(value->AsObject(), JsonObject({ { "a/b", JsonObject{ { "c~d", 1u } } } }));
+        }
+        SECTION("Missing") {
+            auto value = ObjectReader::ParsePaths(Document, { "/user/missing", "/count/x", "/events/5" });
+            CHECK_EQUAL(value->AsObject(), JsonObject({ { "user", JsonObject{} }, { "events", JsonArray{} } }));
+        }
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(ObjectReaderProjectionTest, Parse_StopsEarly) {
+        // Nothing after the selected values is read, so it needn't be valid.
+        CHECK_EQUAL(
+            ObjectReader::ParsePaths("{\"a\": {\"b\": 1, \"c\": 2}, \"d\": [", { "/a/b" })->AsObject(),
+            JsonObject({ { "a", JsonObject{ { "b", 1u } } } })
+        );
+        CHECK_EQUAL(
+            ObjectReader::ParsePaths("{\"a\": [{\"t\": 1}, {\"t\": 2}], \"b\": ", { "/a/*/t" })->AsObject(),
+            JsonObject({ { "a", JsonArray{ JsonObject{ { "t", 1u } }, JsonObject{ { "t", 2u } } } } })
+        );
+        CHECK_EQUAL(
+            ObjectReader::ParsePaths("[0, [1, 2], 3, ", { "/1/0" })->AsArray(),
+            JsonArray({ JsonArray{ 1u } })
+        );
+
+        // A leading wildcard could match anywhere, so the whole document is parsed.
+        CHECK_EQUAL(ObjectReader::ParsePaths("{\"a\": {\"t\": 1}, \"b\": ", { "/*/t" }), std::nullopt);
+        CHECK_EQUAL(ObjectReader::ParsePaths("{\"a\": 1, \"b\": ", { "/a", "/*/t" }), std::nullopt);
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(ObjectReaderProjectionTest, Parse_Invalid) {
+        CHECK_EQUAL(ObjectReader::ParsePaths("{\"a\": 1, \"b\": [1, 2}", { "/b/*" }), std::nullopt);
+        CHECK_EQUAL(ObjectReader::ParsePaths("{\"a\": 1", { "/b" }), std::nullopt);
+
+        CHECK_THROW(std::invalid_argument, ObjectReader::ParsePaths(Document, { "user" }));
+        CHECK_THROW(std::invalid_argument, ObjectReader::ParsePaths(Document, { "/user~2" }));
+    }
+
+}
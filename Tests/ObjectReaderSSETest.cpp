@@ -70,6 +70,12 @@ namespace json_test {
         CHECK_EQUAL(ObjectReader::Parse("\"\""), "");
         CHECK_EQUAL(ObjectReader::Parse("\"String value\""), "String value");
         CHECK_EQUAL(ObjectReader::Parse(u8"\"ハローワールド\""), u8"ハローワールド");
+        CHECK_EQUAL(ObjectReader::Parse("\"Escaped \\\" quote\""), "Escaped \" quote");
+        CHECK_EQUAL(ObjectReader::Parse("\"Escaped backslash \\\\\""), "Escaped backslash \\");
+        CHECK_EQUAL(ObjectReader::Parse("[\"Long string that spans several SIMD blocks before reaching its end\"]")->AsArray(),
+            JsonArray({ "Long string that spans several SIMD blocks before reaching its end" }));
+        CHECK_EQUAL(ObjectReader::Parse("\"Unterminated"), std::nullopt);
+        CHECK_EQUAL(ObjectReader::Parse("\"Unterminated\\"), std::nullopt);
     }
 
     //--------------------------------------------------------------------------------------------------------
@@ -238,6 +244,12 @@ namespace json_test {
             );
         }
 
+        SECTION("Asterisks") {
+            CHECK_EQUAL(ObjectReader::Parse("/* 2 * 3 / 4 */ null", true), nullptr);
+            CHECK_EQUAL(ObjectReader::Parse("/** Doc comment **/ null", true), nullptr);
+            CHECK_EQUAL(ObjectReader::Parse("/* Unterminated * / null", true), std::nullopt);
+        }
+
         SECTION("Null") {
             CHECK_EQUAL(ObjectReader::Parse("/* Before null */\nnull", true), nullptr);
             CHECK_EQUAL(ObjectReader::Parse("null/* After null */", true), nullptr);
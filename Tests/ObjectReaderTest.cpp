@@ -6,7 +6,42 @@
 using namespace json;
 
 namespace {
-    struct ObjectReaderTest {};
+    struct ObjectReaderTest {
+        // Whether every array in `value` has exactly the capacity for its elements.
+        static bool ExactlySized(const JsonValue& value) {
+            if (value.IsArray()) {
+                auto& json_array = value.AsArray();
+                if (json_array.capacity() != std::max(json_array.size(), JsonArray::InlineCapacity)) { return false; }
+                for (auto& element : json_array) {
+                    if (!ExactlySized(element)) { return false; }
+                }
+            } else if (value.IsObject()) {
+                for (auto& member : value.AsObject()) {
+                    if (!ExactlySized(member.second)) { return false; }
+                }
+            }
+            return true;
+        }
+
+        // Counts the bytes allocated from it that haven't yet been freed.
+        class CountingResource : public std::pmr::memory_resource {
+        public:
+            size_t Allocated = 0;
+
+        private:
+            void* do_allocate(size_t bytes, size_t alignment) override {
+                Allocated += bytes;
+                return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+            }
+            void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+                Allocated -= bytes;
+                std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+            }
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+                return this == &other;
+            }
+        };
+    };
 }
 
 namespace json_test {
@@ -28,6 +63,10 @@ namespace json_test {
         CHECK_EQUAL(ObjectReader::Parse("0"), 0u);
         CHECK_EQUAL(ObjectReader::Parse("-9223372036854775808"), std::numeric_limits<int64_t>::min());
         CHECK_EQUAL(ObjectReader::Parse("9223372036854775807"), static_cast<uint64_t>(std::numeric_limits<int64_t>::max()));
+        CHECK_EQUAL(ObjectReader::Parse("-12345678"), -12345678);
+        CHECK_EQUAL(ObjectReader::Parse("-1234567890123456"), -1234567890123456);
+        CHECK_EQUAL(ObjectReader::Parse("-9223372036854775809"), std::nullopt);
+        CHECK_EQUAL(ObjectReader::Parse("-99999999999999999999999"), std::nullopt);
     }
 
     //--------------------------------------------------------------------------------------------------------
@@ -35,6 +74,17 @@ namespace json_test {
     TEST_CASE(ObjectReaderTest, Parse_UInt) {
         CHECK_EQUAL(ObjectReader::Parse("0"), std::numeric_limits<uint64_t>::min());
         CHECK_EQUAL(ObjectReader::Parse("18446744073709551615"), std::numeric_limits<uint64_t>::max());
+        CHECK_EQUAL(ObjectReader::Parse("1234567"), 1234567u);
+        CHECK_EQUAL(ObjectReader::Parse("12345678"), 12345678u);
+        CHECK_EQUAL(ObjectReader::Parse("123456789"), 123456789u);
+        CHECK_EQUAL(ObjectReader::Parse("1700000000123"), 1700000000123u);
+        CHECK_EQUAL(ObjectReader::Parse("9876543210987654321"), 9876543210987654321u);
+        CHECK_EQUAL(ObjectReader::Parse("00000000000000000000000042"), 42u);
+        CHECK_EQUAL(ObjectReader::Parse("[12345678,87654321]")->AsArray(), JsonArray({ 12345678u, 87654321u }));
+
+        // Overflow saturates.
+        CHECK_EQUAL(ObjectReader::Parse("18446744073709551616"), std::numeric_limits<uint64_t>::max());
+        CHECK_EQUAL(ObjectReader::Parse("99999999999999999999999"), std::numeric_limits<uint64_t>::max());
     }
 
     //--------------------------------------------------------------------------------------------------------
@@ -65,10 +115,141 @@ namespace json_test {
 
     //--------------------------------------------------------------------------------------------------------
 
+    TEST_CASE(ObjectReaderTest, Parse_RealRounding) {
+        SECTION("Fast path") {
+            CHECK_EQUAL(ObjectReader::Parse("0.1")->AsDouble(), 0.1);
+            CHECK_EQUAL(ObjectReader::Parse("-12.5")->AsDouble(), -12.5);
+            CHECK_EQUAL(ObjectReader::Parse("1e22")->AsDouble(), 1e22);
+            CHECK_EQUAL(ObjectReader::Parse("1E-22")->AsDouble(), 1e-22);
+            CHECK_EQUAL(ObjectReader::Parse("5e+0")->AsDouble(), 5.0);
+        }
+        SECTION("Large exponents") {
+            CHECK_EQUAL(ObjectReader::Parse("1e23")->AsDouble(), 1e23);
+            CHECK_EQUAL(ObjectReader::Parse("1.7976931348623157e308")->AsDouble(), std::numeric_limits<double>::max());
+            CHECK_EQUAL(ObjectReader::Parse("2.2250738585072014e-308")->AsDouble(), std::numeric_limits<double>::min());
+            CHECK_EQUAL(ObjectReader::Parse("7.2057594037927933e+16")->AsDouble(), 7.2057594037927933e+16);
+        }
+        SECTION("Subnormals") {
+            CHECK_EQUAL(ObjectReader::Parse("4.9406564584124654e-324")->AsDouble(), std::numeric_limits<double>::denorm_min());
+            CHECK_EQUAL(ObjectReader::Parse("2.2250738585072011e-308")->AsDouble(), 2.2250738585072011e-308);
+            CHECK_EQUAL(ObjectReader::Parse("1e-400")->AsDouble(), 0.0);
+        }
+        SECTION("Ties round to even") {
+            CHECK_EQUAL(ObjectReader::Parse("9007199254740993.0")->AsDouble(), 9007199254740992.0);
+            CHECK_EQUAL(ObjectReader::Parse("9007199254740995.0")->AsDouble(), 9007199254740996.0);
+        }
+        SECTION("Many digits") {
+            CHECK_EQUAL(ObjectReader::Parse("3.14159265358979323846264338327950288")->AsDouble(), 3.14159265358979323846264338327950288);
+            CHECK_EQUAL(ObjectReader::Parse("0.000000000000000000000000000000000000000001234567890123456789012")->AsDouble(), 1.234567890123456789012e-42);
+            CHECK_EQUAL(ObjectReader::Parse("9007199254740993.00000000000000000000000001")->AsDouble(), 9007199254740994.0);
+            CHECK_EQUAL(ObjectReader::Parse("123456789012345678901234567890e-10")->AsDouble(), 12345678901234567890.1234567890);
+        }
+        SECTION("Overflow") {
+            CHECK_EQUAL(ObjectReader::Parse("1e400")->AsDouble(), std::numeric_limits<double>::infinity());
+            CHECK_EQUAL(ObjectReader::Parse("-1e400")->AsDouble(), -std::numeric_limits<double>::infinity());
+            CHECK_EQUAL(ObjectReader::Parse("0e400")->AsDouble(), 0.0);
+        }
+        SECTION("Negative zero") {
+            CHECK_TRUE(std::signbit(ObjectReader::Parse("-0.0")->AsDouble()));
+            CHECK_TRUE(std::signbit(ObjectReader::Parse("-0e10")->AsDouble()));
+        }
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(ObjectReaderTest, Parse_RealInvalid) {
+        CHECK_EQUAL(ObjectReader::Parse("-"), std::nullopt);
+        CHECK_EQUAL(ObjectReader::Parse("+1.5"), std::nullopt);
+        CHECK_EQUAL(ObjectReader::Parse(".5"), std::nullopt);
+        CHECK_EQUAL(ObjectReader::Parse("-.5"), std::nullopt);
+        CHECK_EQUAL(ObjectReader::Parse("1."), std::nullopt);
+        CHECK_EQUAL(ObjectReader::Parse("1e"), std::nullopt);
+        CHECK_EQUAL(ObjectReader::Parse("1e+"), std::nullopt);
+        CHECK_EQUAL(ObjectReader::Parse("[1.e5]"), std::nullopt);
+        CHECK_EQUAL(ObjectReader::Parse("[1.5.2]"), std::nullopt);
+        CHECK_EQUAL(ObjectReader::Parse("[1e5e2]"), std::nullopt);
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
     TEST_CASE(ObjectReaderTest, Parse_String) {
         CHECK_EQUAL(ObjectReader::Parse("\"\""), "");
         CHECK_EQUAL(ObjectReader::Parse("\"String value\""), "String value");
         CHECK_EQUAL(ObjectReader::Parse(u8"\"ハローワールド\""), u8"ハローワールド");
+        CHECK_EQUAL(ObjectReader::Parse("\"Escaped \\\" quote\""), "Escaped \" quote");
+        CHECK_EQUAL(ObjectReader::Parse("\"Escaped backslash \\\\\""), "Escaped backslash \\");
+        CHECK_EQUAL(ObjectReader::Parse("[\"Long string that spans several SIMD blocks before reaching its end\"]")->AsArray(),
+            JsonArray({ "Long string that spans several SIMD blocks before reaching its end" }));
+        CHECK_EQUAL(ObjectReader::Parse("\"Unterminated"), std::nullopt);
+        CHECK_EQUAL(ObjectReader::Parse("\"Unterminated\\"), std::nullopt);
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(ObjectReaderTest, Parse_StringEscapes) {
+        CHECK_EQUAL(ObjectReader::Parse("\"\\b\\f\\n\\r\\t\\/\""), "\b\f\n\r\t/");
+        CHECK_EQUAL(ObjectReader::Parse("\"\\u0041\\u00e9\\u20AC\""), u8"A\u00e9\u20ac");
+        CHECK_EQUAL(ObjectReader::Parse("\"\\uD83D\\uDE00\""), u8"\U0001F600");
+        CHECK_EQUAL(ObjectReader::Parse("\"\\u0000\""), std::string(1, '\0'));
+        CHECK_EQUAL(ObjectReader::Parse("{\"Escaped \\\"key\\\"\": 1}")->AsObject(), JsonObject({ { "Escaped \"key\"", 1u } }));
+
+        SECTION("Long strings") {
+            // Escapes before, within and after each SIMD width.
+            for (size_t padding = 0; padding < 130; ++padding) {
+                std::string prefix(padding, 'x');
+                auto value = ObjectReader::Parse("[\"" + prefix + "\\n" + prefix + "\\u00e9\"]");
+                REQUIRE(value.has_value());
+                CHECK_EQUAL(value->AsArray(), JsonArray({ prefix + "\n" + prefix + u8"\u00e9" }));
+            }
+        }
+        SECTION("Invalid") {
+            CHECK_EQUAL(ObjectReader::Parse("\"\\x\""), std::nullopt);
+            CHECK_EQUAL(ObjectReader::Parse("\"\\u12\""), std::nullopt);
+            CHECK_EQUAL(ObjectReader::Parse("\"\\u12G4\""), std::nullopt);
+            CHECK_EQUAL(ObjectReader::Parse("\"\\uD800\""), std::nullopt);
+            CHECK_EQUAL(ObjectReader::Parse("\"\\uD800\\u0041\""), std::nullopt);
+            CHECK_EQUAL(ObjectReader::Parse("\"\\uDC00\""), std::nullopt);
+            CHECK_EQUAL(ObjectReader::Parse("{\"\\q\": 1}"), std::nullopt);
+            CHECK_EQUAL(ObjectReader::ParseIndexed("[\"\\uD800\"]"), std::nullopt);
+        }
+        SECTION("Round trip") {
+            JsonArray value({ "Quote \" backslash \\ newline \n" });
+            CHECK_EQUAL(ObjectReader::Parse(ObjectWriter::Write(value, false))->AsArray(), value);
+
+            // Control characters without a short escape are written as `\u00XX`.
+            auto controls = ObjectReader::Parse("[\"\\u0000a\\u0001b\\u001f\"]");
+            REQUIRE(controls.has_value());
+            CHECK_EQUAL(controls->AsArray()[0].AsString(), std::string("\0a\x01" "b\x1F", 5));
+            CHECK_EQUAL(ObjectWriter::Write(*controls, false), "[\"\\u0000a\\u0001b\\u001F\"]");
+            CHECK_EQUAL(ObjectReader::Parse(ObjectWriter::Write(*controls, false)), controls);
+        }
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(ObjectReaderTest, Parse_ValidateUtf8) {
+        ParseOptions options;
+        options.ValidateUtf8 = true;
+
+        const std::string valid = u8"[\"ハローワールド\", {\"Café\": \"\\\"€\\\" \U0001F600\"}]";
+        CHECK_EQUAL(ObjectReader::Parse(valid, options), ObjectReader::Parse(valid));
+        CHECK_EQUAL(ObjectReader::ParseIndexed(valid, options), ObjectReader::Parse(valid));
+
+        // Invalid sequences are only rejected when asked, in values and keys, near the start and end of long
+        // strings, and when cut short by an escape or the closing quote.
+        for (auto invalid : { "\xFF", "\xC0\xAF", "\xED\xA0\x80", "\xE2\x82", "\xE2\x82\\n" }) {
+            for (size_t padding : { 0, 1, 31, 32, 63, 64, 100 }) {
+                std::string text = std::string(padding, 'x') + invalid;
+                for (auto document : { "[\"" + text + "\"]", "{\"" + text + "\": 1}", "[\"" + text + std::string(padding, 'x') + "\"]" }) {
+                    CHECK_TRUE(ObjectReader::Parse(document).has_value());
+                    CHECK_EQUAL(ObjectReader::Parse(document, options), std::nullopt);
+                    CHECK_EQUAL(ObjectReader::ParseIndexed(document, options), std::nullopt);
+                }
+            }
+        }
+
+        // Escape sequences always decode to valid UTF-8.
+        CHECK_EQUAL(ObjectReader::Parse("\"\\u00e9\"", options), u8"\u00e9");
     }
 
     //--------------------------------------------------------------------------------------------------------
@@ -151,6 +332,74 @@ namespace json_test {
                 })
             );
         }
+        SECTION("Unsorted") {
+            auto value = ObjectReader::Parse("{\"Third\":null,\"First\":1234,\"Second\":\"Value\",\"First\":5678}");
+            REQUIRE(value.has_value());
+            CHECK_EQUAL(
+                value->AsObject(),
+                JsonObject({
+                    { "First", 1234u },
+                    { "Second", "Value" },
+                    { "Third", nullptr }
+                })
+            );
+            CHECK_EQUAL(value->AsObject().begin()->first.View(), "First");
+        }
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(ObjectReaderTest, Parse_PreserveKeyOrder) {
+        std::string document = "{\"Third\":null,\"First\":[{\"B\":1,\"A\":2}],\"Second\":\"Value\",\"First\":5678}";
+        ParseOptions options;
+        options.PreserveKeyOrder = true;
+
+        auto value = ObjectReader::Parse(document, options);
+        REQUIRE(value.has_value());
+        CHECK_TRUE(value->AsObject().Order() == KeyOrder::Insertion);
+        CHECK_EQUAL(ObjectWriter::Write(*value, false), "{\"Third\":null,\"First\":[{\"B\":1,\"A\":2}],\"Second\":\"Value\"}");
+        CHECK_EQUAL(value, ObjectReader::Parse(document));
+
+        // Large objects are indexed as they are parsed.
+        std::string large = "{";
+        for (int i = 999; i >= 0; --i) {
+            large += "\"" + std::to_string(i) + "\":" + std::to_string(i) + ",";
+        }
+        large += "\"500\":0}";
+        auto large_value = ObjectReader::Parse(large, options);
+        REQUIRE(large_value.has_value());
+        auto& large_object = large_value->AsObject();
+        CHECK_EQUAL(large_object.size(), 1000u);
+        CHECK_EQUAL(large_object.begin()->first.View(), "999");
+        CHECK_EQUAL(large_object.at("500"), 500u);
+
+        // A reused reader switches recycled objects to the requested order.
+        ObjectReader reader;
+        JsonValue reused;
+        REQUIRE(reader.Parse(document, reused));
+        CHECK_TRUE(reused.AsObject().Order() == KeyOrder::Sorted);
+        REQUIRE(reader.Parse(document, reused, options));
+        CHECK_EQUAL(ObjectWriter::Write(reused, false), ObjectWriter::Write(*value, false));
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(ObjectReaderTest, Parse_Nested) {
+        std::string document = "1";
+        for (size_t depth = 0; depth < 100; ++depth) {
+            document = "{\"k\":[" + document + "]}";
+        }
+
+        auto value = ObjectReader::Parse(document);
+        REQUIRE(value.has_value());
+        CHECK_EQUAL(ObjectWriter::Write(*value, false), document);
+        CHECK_EQUAL(ObjectReader::ParseIndexed(document), value);
+
+        ParseOptions options;
+        options.MaxDepth = 199;
+        CHECK_EQUAL(ObjectReader::Parse(document, options), std::nullopt);
+        options.MaxDepth = 200;
+        CHECK_EQUAL(ObjectReader::Parse(document, options), value);
     }
 
     //--------------------------------------------------------------------------------------------------------
@@ -257,6 +506,12 @@ namespace json_test {
             );
         }
 
+        SECTION("Asterisks") {
+            CHECK_EQUAL(ObjectReader::Parse("/* 2 * 3 / 4 */ null", true), nullptr);
+            CHECK_EQUAL(ObjectReader::Parse("/** Doc comment **/ null", true), nullptr);
+            CHECK_EQUAL(ObjectReader::Parse("/* Unterminated * / null", true), std::nullopt);
+        }
+
         SECTION("Null") {
             CHECK_EQUAL(ObjectReader::Parse("/* Before null */\nnull", true), nullptr);
             CHECK_EQUAL(ObjectReader::Parse("null/* After null */", true), nullptr);
@@ -337,4 +592,145 @@ namespace json_test {
         }
     }
 
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(ObjectReaderTest, Parse_Reuse) {
+        constexpr std::string_view first = "{\"Name\": \"A string too long to be stored inline\", \"List\": [1, 2, 3]}";
+        constexpr std::string_view second = "{\"Name\": \"Another string that is also quite long\", \"List\": [4, 5]}";
+
+        ObjectReader reader;
+        JsonValue value;
+        REQUIRE(reader.Parse(first, value));
+        CHECK_TRUE(value == *ObjectReader::Parse(first));
+
+        auto name = &value.AsObject().at("Name");
+        auto list = value.AsObject().at("List").AsArray().data();
+
+        // The same shape reuses the members and array storage of the previous value.
+        REQUIRE(reader.Parse(second, value));
+        CHECK_TRUE(value == *ObjectReader::Parse(second));
+        CHECK_TRUE(&value.AsObject().at("Name") == name || &value.AsObject().at("List") == name);
+        CHECK_TRUE(value.AsObject().at("List").AsArray().data() == list);
+
+        REQUIRE(reader.Parse("[\"x\", {\"A\": 1, \"A\": 2}, [[]]]", value));
+        CHECK_TRUE(value == *ObjectReader::Parse("[\"x\", {\"A\": 1}, [[]]]"));
+
+        REQUIRE(reader.Parse("12", value));
+        CHECK_EQUAL(value.AsUInt(), 12u);
+
+        CHECK_FALSE(reader.Parse("[1, 2", value));
+        CHECK_TRUE(value.IsNull());
+        REQUIRE(reader.Parse(first, value));
+        CHECK_TRUE(value == *ObjectReader::Parse(first));
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(ObjectReaderTest, Parse_PresizeArrays) {
+        std::string document = "{\"A\": [1, [], [\"x,]\", [2, 3]], {\"B\": [true, null]}], \"C\": [";
+        for (size_t i = 0; i < 100; ++i) { document += std::to_string(i) + ", "; }
+        document += "100]}";
+
+        ParseOptions options;
+        options.PresizeArrays = true;
+        auto expected = ObjectReader::Parse(document);
+        REQUIRE(expected.has_value());
+        CHECK_FALSE(ExactlySized(*expected));
+
+        auto value = ObjectReader::Parse(document, options);
+        CHECK_TRUE(value == expected);
+        CHECK_TRUE(ExactlySized(*value));
+
+        auto indexed_value = ObjectReader::ParseIndexed(document, options);
+        CHECK_TRUE(indexed_value == expected);
+        CHECK_TRUE(ExactlySized(*indexed_value));
+
+        auto padded_value = ObjectReader::ParsePadded(PaddedString(document), options);
+        CHECK_TRUE(padded_value == expected);
+        CHECK_TRUE(ExactlySized(*padded_value));
+
+        ObjectReader reader;
+        JsonValue reused;
+        REQUIRE(reader.Parse("[[1, 2, 3, 4, 5], [6]]", reused, options));
+        REQUIRE(reader.Parse(document, reused, options));
+        CHECK_TRUE(reused == expected);
+
+        CHECK_EQUAL(ObjectReader::Parse("[1, 2,]", options), std::nullopt);
+        CHECK_EQUAL(ObjectReader::Parse("[1, [2]", options), std::nullopt);
+        CHECK_EQUAL(ObjectReader::ParseIndexed("[1, \"2]", options), std::nullopt);
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(ObjectReaderTest, Parse_StringPool) {
+        constexpr std::string_view document =
+            "[{\"A key longer than inline\": \"A repeated value that is pooled\", \"Short\": 1},"
+            " {\"A key longer than inline\": \"A repeated value that is pooled\", \"Short\": 2}]";
+
+        StringPool strings;
+        ParseOptions options;
+        options.Strings = &strings;
+        auto value = ObjectReader::Parse(document, options);
+        REQUIRE(value.has_value());
+        CHECK_TRUE(value == ObjectReader::Parse(document));
+        CHECK_EQUAL(strings.Size(), 2u);
+
+        auto& first = value->AsArray()[0].AsObject();
+        auto& second = value->AsArray()[1].AsObject();
+        CHECK_TRUE(first.begin()->first.SharesWith(second.begin()->first));
+        CHECK_TRUE(first.begin()->first.SharesWith(strings.Intern("A key longer than inline")));
+
+        // Values longer than the limit are copied rather than pooled.
+        StringPool short_strings(8);
+        options.Strings = &short_strings;
+        REQUIRE(ObjectReader::Parse(document, options).has_value());
+        CHECK_EQUAL(short_strings.Size(), 1u);
+
+        // The strings outlive the pool, and a reused reader interns into the pool it's given.
+        options.Strings = &strings;
+        strings.Clear();
+        ObjectReader reader;
+        JsonValue reused;
+        REQUIRE(reader.Parse(document, reused, options));
+        REQUIRE(reader.Parse(document, reused, options));
+        CHECK_TRUE(reused == value);
+        CHECK_EQUAL(strings.Size(), 2u);
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(ObjectReaderTest, Parse_MemoryResource) {
+        constexpr std::string_view document =
+            "{\"A key longer than inline\": [\"A string too long to be stored inline\", {\"B\": [1, 2]}]}";
+
+        ObjectReaderTest::CountingResource resource;
+        std::optional<JsonValue> copy;
+        {
+            auto value = ObjectReader::Parse(document, &resource);
+            REQUIRE(value.has_value());
+            CHECK_TRUE(value == ObjectReader::Parse(document));
+            CHECK_TRUE(resource.Allocated != 0);
+            CHECK_TRUE(value->AsObject().get_allocator().resource() == &resource);
+
+            // Copies are independent of the resource.
+            size_t allocated = resource.Allocated;
+            copy = value;
+            CHECK_EQUAL(resource.Allocated, allocated);
+            CHECK_TRUE(copy->AsObject().get_allocator().resource() == std::pmr::get_default_resource());
+        }
+        CHECK_EQUAL(resource.Allocated, 0u);
+        CHECK_TRUE(copy == ObjectReader::Parse(document));
+
+        std::pmr::monotonic_buffer_resource arena;
+        auto value = ObjectReader::Parse(document, &arena);
+        REQUIRE(value.has_value());
+        CHECK_TRUE(value == copy);
+
+        // A reused reader frees, rather than reuses, storage from another resource.
+        ObjectReader reader;
+        REQUIRE(reader.Parse(document, *value));
+        CHECK_TRUE(value == copy);
+        CHECK_TRUE(value->AsObject().get_allocator().resource() == std::pmr::get_default_resource());
+    }
+
 }
\ No newline at end of file
@@ -178,4 +178,21 @@ namespace json_test {
         }
     }
 
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(ObjectWriterTest, Write_ObjectInsertionOrder) {
+        JsonObject ordered(KeyOrder::Insertion, {
+            { "Third", nullptr },
+            { "First", 1234 },
+            { "Second", "Value" }
+        });
+
+        SECTION("Styled") {
+            CHECK_EQUAL(ObjectWriter::Write(ordered, true), "{\n    \"Third\" : null,\n    \"First\" : 1234,\n    \"Second\" : \"Value\"\n}");
+        }
+        SECTION("Compact") {
+            CHECK_EQUAL(ObjectWriter::Write(ordered, false), "{\"Third\":null,\"First\":1234,\"Second\":\"Value\"}");
+        }
+    }
+
 }
\ No newline at end of file
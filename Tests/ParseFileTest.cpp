@@ -0,0 +1,105 @@
+#include "Json.hpp"
+
+#include "ToString.h"
+#include "CppUnitTestFramework.hpp"
+
+#include <filesystem>
+#include <fstream>
+
+using namespace json;
+
+namespace {
+    struct ParseFileTest {
+        // A file in the temp directory that is deleted when the test ends.
+        struct TempFile {
+            std::string Path;
+
+            explicit TempFile(std::string_view contents) {
+                Path = (std::filesystem::temp_directory_path() / "CppJsonParseFileTest.json").string();
+                std::ofstream stream(Path, std::ios::binary | std::ios::trunc);
+                stream.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+            }
+
+            ~TempFile() {
+                std::error_code error;
+                std::filesystem::remove(Path, error);
+            }
+        };
+
+        struct CountingHooks : ISimpleReaderHooks {
+            size_t Values = 0;
+
+            bool OnNull() override { ++Values; return true; }
+            bool OnBool(bool) override { ++Values; return true; }
+            bool OnInt(int64_t) override { ++Values; return true; }
+            bool OnUInt(uint64_t) override { ++Values; return true; }
+            bool OnReal(double) override { ++Values; return true; }
+            bool OnString(std::string_view) override { ++Values; return true; }
+
+            bool OnArrayStart() override { return true; }
+            bool OnArrayEnd() override { return true; }
+
+            bool OnObjectStart() override { return true; }
+            bool OnObjectKey(std::string_view) override { return true; }
+            bool OnObjectEnd() override { return true; }
+        };
+    };
+}
+
+namespace json_test {
+
+    TEST_CASE(ParseFileTest, ObjectReader_ParseFile) {
+        TempFile file("{\"A\": [1, 2.5, \"Three\"], \"B\": null}");
+
+        auto value = ObjectReader::ParseFile(file.Path);
+        REQUIRE(value.has_value());
+        CHECK_EQUAL(value->AsObject().at("A").AsArray(), JsonArray({ 1u, 2.5, "Three" }));
+        CHECK_EQUAL(value->AsObject().at("B"), nullptr);
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(ParseFileTest, SimpleReader_ParseFile) {
+        TempFile file("// Comment\n[1, true, \"x\"]");
+
+        CountingHooks hooks;
+        CHECK_TRUE(SimpleReader::ParseFile(file.Path, &hooks, true));
+        CHECK_EQUAL(hooks.Values, 3u);
+
+        CountingHooks no_comments;
+        CHECK_FALSE(SimpleReader::ParseFile(file.Path, &no_comments));
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(ParseFileTest, ParseFile_PageBoundaries) {
+        // Values that end exactly at, just before and just after common page sizes.
+        for (size_t size : { 4095, 4096, 4097, 8192, 65536 }) {
+            std::string contents(size - 4, ' ');
+            contents += "true";
+            TempFile file(contents);
+            CHECK_EQUAL(ObjectReader::ParseFile(file.Path), true);
+        }
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(ParseFileTest, ParseFile_Invalid) {
+        SECTION("Missing") {
+            auto path = (std::filesystem::temp_directory_path() / "CppJsonParseFileTestMissing.json").string();
+            CHECK_EQUAL(ObjectReader::ParseFile(path), std::nullopt);
+
+            CountingHooks hooks;
+            CHECK_FALSE(SimpleReader::ParseFile(path, &hooks));
+        }
+        SECTION("Empty") {
+            TempFile file("");
+            CHECK_EQUAL(ObjectReader::ParseFile(file.Path), std::nullopt);
+        }
+        SECTION("Malformed") {
+            TempFile file("[1, 2");
+            CHECK_EQUAL(ObjectReader::ParseFile(file.Path), std::nullopt);
+        }
+    }
+
+}
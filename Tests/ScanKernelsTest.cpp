@@ -0,0 +1,186 @@
+#include "Json.hpp"
+
+#include "ToString.h"
+#include "CppUnitTestFramework.hpp"
+
+using namespace json;
+using namespace json::detail;
+
+namespace {
+    struct ScanKernelsTest {
+        // Every level that can run on this CPU, from narrowest to widest.
+        static std::vector<SimdLevel> SupportedLevels() {
+            std::vector<SimdLevel> levels{ SimdLevel::Scalar };
+            for (auto level : { SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512 }) {
+                if (level <= ActiveSimdLevel()) {
+                    levels.push_back(level);
+                }
+            }
+            return levels;
+        }
+
+        static size_t Offset(const std::string& data, const char* found) {
+            return static_cast<size_t>(found - data.data());
+        }
+    };
+}
+
+namespace json_test {
+
+    TEST_CASE(ScanKernelsTest, ActiveLevel) {
+#ifdef CPPJSON_SIMD_X64
+        CHECK(ActiveSimdLevel() >= SimdLevel::SSE2);
+#else
+        CHECK(ActiveSimdLevel() == SimdLevel::Scalar);
+#endif
+        CHECK(&ActiveScanKernels() == &GetScanKernels(ActiveSimdLevel()));
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(ScanKernelsTest, SkipWhitespace) {
+        for (auto level : SupportedLevels()) {
+            auto& kernels = GetScanKernels(level);
+
+            for (size_t length = 0; length < 200; ++length) {
+                std::string data(length, ' ');
+                for (size_t i = 0; i < length; ++i) {
+                    data[i] = " \r\n\t"[i % 4];
+                }
+                CHECK_EQUAL(Offset(data, kernels.SkipWhitespace(data.data(), data.data() + data.size())), length);
+
+                data += 'x';
+                CHECK_EQUAL(Offset(data, kernels.SkipWhitespace(data.data(), data.data() + data.size())), length);
+            }
+        }
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(ScanKernelsTest, FindQuoteOrEscape) {
+        for (auto level : SupportedLevels()) {
+            auto& kernels = GetScanKernels(level);
+
+            for (size_t length = 0; length < 200; ++length) {
+                std::string data(length, 'a');
+                CHECK_EQUAL(Offset(data, kernels.FindQuoteOrEscape(data.data(), data.data() + data.size())), length);
+
+                data += '"';
+                CHECK_EQUAL(Offset(data, kernels.FindQuoteOrEscape(data.data(), data.data() + data.size())), length);
+
+                data.back() = '\\';
+                CHECK_EQUAL(Offset(data, kernels.FindQuoteOrEscape(data.data(), data.data() + data.size())), length);
+            }
+        }
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(ScanKernelsTest, FindQuoteOrEscapeUtf8) {
+        const std::vector<std::string> valid{
+            "\x7F", "\xC2\x80", "\xDF\xBF", "\xE0\xA0\x80", "\xED\x9F\xBF", "\xEE\x80\x80", "\xEF\xBF\xBF",
+            "\xF0\x90\x80\x80", "\xF4\x8F\xBF\xBF", u8"Café € \U0001F600"
+        };
+        const std::vector<std::string> invalid{
+            "\x80",                 // Continuation without a lead
+            "\xC0\x80",             // Overlong
+            "\xC1\xBF",
+            "\xE0\x9F\xBF",
+            "\xF0\x8F\xBF\xBF",
+            "\xED\xA0\x80",         // Surrogate
+            "\xF4\x90\x80\x80",     // Above U+10FFFF
+            "\xF5\x80\x80\x80",
+            "\xFF",
+            "\xC2",                 // Cut short
+            "\xE2\x82",
+            "\xF0\x9F\x98",
+            "\xC2\x80\x80"          // Too long
+        };
+
+        for (auto level : SupportedLevels()) {
+            auto& kernels = GetScanKernels(level);
+
+            for (size_t length = 0; length < 100; ++length) {
+                std::string prefix(length, 'a');
+                for (auto& sequence : valid) {
+                    for (auto end : { "\"", "\\", "" }) {
+                        std::string data = prefix + sequence + end + "\xFF";
+                        auto last = data.data() + data.size() - (*end ? 0 : 1);
+                        CHECK_EQUAL(Offset(data, kernels.FindQuoteOrEscapeUtf8(data.data(), last)), length + sequence.size());
+                    }
+                }
+                for (auto& sequence : invalid) {
+                    for (auto end : { "\"", "" }) {
+                        std::string data = prefix + sequence + end;
+                        CHECK_TRUE(kernels.FindQuoteOrEscapeUtf8(data.data(), data.data() + data.size()) == nullptr);
+                    }
+                }
+            }
+        }
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(ScanKernelsTest, FindChar) {
+        for (auto level : SupportedLevels()) {
+            auto& kernels = GetScanKernels(level);
+
+            for (size_t length = 0; length < 200; ++length) {
+                std::string data(length, 'a');
+                CHECK_EQUAL(Offset(data, kernels.FindChar(data.data(), data.data() + data.size(), '\n')), length);
+
+                data += "\n\n";
+                CHECK_EQUAL(Offset(data, kernels.FindChar(data.data(), data.data() + data.size(), '\n')), length);
+            }
+        }
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(ScanKernelsTest, CopyUntilEscape) {
+        for (auto level : SupportedLevels()) {
+            auto& kernels = GetScanKernels(level);
+
+            for (size_t length = 0; length < 200; ++length) {
+                std::string data;
+                for (size_t i = 0; i < length; ++i) {
+                    data += static_cast<char>('a' + i % 26);
+                }
+                std::string out(length + 1, '?');
+                CHECK_EQUAL(Offset(data, kernels.CopyUntilEscape(data.data(), data.data() + data.size(), out.data())), length);
+                CHECK_EQUAL(out.substr(0, length), data);
+
+                data += "\\\"";
+                out.assign(data.size(), '?');
+                CHECK_EQUAL(Offset(data, kernels.CopyUntilEscape(data.data(), data.data() + data.size(), out.data())), length);
+                CHECK_EQUAL(out.substr(0, length), data.substr(0, length));
+            }
+        }
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(ScanKernelsTest, ClassifyBlock) {
+        std::string block;
+        for (size_t i = 0; i < 64; ++i) {
+            block += "a\"\\ \r\n\t{}[]:,Y_\xF0"[i % 16];
+        }
+
+        BlockMasks expected;
+        GetScanKernels(SimdLevel::Scalar).ClassifyBlock(block.data(), expected);
+        CHECK_EQUAL(expected.Quote, 0x0002000200020002ull);
+        CHECK_EQUAL(expected.Backslash, 0x0004000400040004ull);
+        CHECK_EQUAL(expected.Whitespace, 0x0078007800780078ull);
+        CHECK_EQUAL(expected.Operator, 0x1F801F801F801F80ull);
+
+        for (auto level : SupportedLevels()) {
+            BlockMasks masks;
+            GetScanKernels(level).ClassifyBlock(block.data(), masks);
+            CHECK_EQUAL(masks.Quote, expected.Quote);
+            CHECK_EQUAL(masks.Backslash, expected.Backslash);
+            CHECK_EQUAL(masks.Whitespace, expected.Whitespace);
+            CHECK_EQUAL(masks.Operator, expected.Operator);
+        }
+    }
+
+}
@@ -0,0 +1,136 @@
+#include "Json.hpp"
+
+#include "ToString.h"
+#include "CppUnitTestFramework.hpp"
+
+using namespace json;
+
+namespace {
+    struct SequenceReaderTest {
+        // Reads every value, returning each one written compactly along with the offset it ended at.
+        static std::vector<std::pair<std::string, size_t>> ReadAll(SequenceReader& reader) {
+            std::vector<std::pair<std::string, size_t>> values;
+            while (auto value = reader.Next()) {
+                values.emplace_back(ObjectWriter::Write(*value, false), reader.Offset());
+            }
+            return values;
+        }
+
+        struct CountingHooks {
+            size_t Values = 0;
+            bool StopAtObject = false;
+
+            bool OnNull() { ++Values; return true; }
+            bool OnBool(bool) { ++Values; return true; }
+            bool OnInt(int64_t) { ++Values; return true; }
+            bool OnUInt(uint64_t) { ++Values; return true; }
+            bool OnReal(double) { ++Values; return true; }
+            bool OnString(std::string_view) { ++Values; return true; }
+
+            bool OnArrayStart() { return true; }
+            bool OnArrayEnd() { ++Values; return true; }
+
+            HookResult OnObjectStart() { return StopAtObject ? HookResult::Stop : HookResult::Continue; }
+            bool OnObjectKey(std::string_view) { return true; }
+            bool OnObjectEnd() { ++Values; return true; }
+        };
+    };
+}
+
+namespace json_test {
+
+    TEST_CASE(SequenceReaderTest, Next_Separators) {
+        SECTION("Whitespace") {
+            SequenceReader reader(" {\"A\": 1}\n[1, 2]  \"x\" 12 true\n");
+            auto values = ReadAll(reader);
+            REQUIRE(values.size() == 5u);
+            CHECK_EQUAL(values[0].first, "{\"A\":1}");
+            CHECK_EQUAL(values[0].second, 9u);
+            CHECK_EQUAL(values[1].first, "[1,2]");
+            CHECK_EQUAL(values[1].second, 16u);
+            CHECK_EQUAL(values[2].second, 21u);
+            CHECK_EQUAL(values[3].first, "12");
+            CHECK_EQUAL(values[4].first, "true");
+            CHECK_FALSE(reader.Failed());
+            CHECK_EQUAL(reader.Offset(), 30u);
+        }
+        SECTION("Adjacent") {
+            SequenceReader reader("{}[]\"x\"null{\"B\":[]}");
+            auto values = ReadAll(reader);
+            REQUIRE(values.size() == 5u);
+            CHECK_EQUAL(values[0].second, 2u);
+            CHECK_EQUAL(values[1].second, 4u);
+            CHECK_EQUAL(values[2].second, 7u);
+            CHECK_EQUAL(values[3].second, 11u);
+            CHECK_EQUAL(values[4].first, "{\"B\":[]}");
+            CHECK_FALSE(reader.Failed());
+        }
+        SECTION("Record separators") {
+            SequenceReader reader("\x1E{\"A\": 1}\n\x1E\x1E[2]\n");
+            auto values = ReadAll(reader);
+            REQUIRE(values.size() == 2u);
+            CHECK_EQUAL(values[0].first, "{\"A\":1}");
+            CHECK_EQUAL(values[1].first, "[2]");
+            CHECK_FALSE(reader.Failed());
+        }
+        SECTION("Comments") {
+            SequenceReader reader("1 /* Two */ 2 // Three\n3", true);
+            CHECK_EQUAL(ReadAll(reader).size(), 3u);
+            CHECK_FALSE(reader.Failed());
+        }
+        SECTION("Empty") {
+            SequenceReader reader(" \n ");
+            CHECK_FALSE(reader.Next().has_value());
+            CHECK_FALSE(reader.Failed());
+        }
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(SequenceReaderTest, Next_Invalid) {
+        SequenceReader reader("[1] {\"A\": } [2]");
+        CHECK_EQUAL(ReadAll(reader).size(), 1u);
+        CHECK_TRUE(reader.Failed());
+        CHECK_EQUAL(reader.Offset(), 4u);
+        CHECK_FALSE(reader.Next().has_value());
+
+        SequenceReader unterminated("[1] [2");
+        CHECK_EQUAL(ReadAll(unterminated).size(), 1u);
+        CHECK_TRUE(unterminated.Failed());
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(SequenceReaderTest, Next_Hooks) {
+        SequenceReader reader("[1, \"a\\nb\"] {\"B\": [null]} 3");
+        CountingHooks hooks;
+        size_t count = 0;
+        while (reader.Next(hooks)) { ++count; }
+        CHECK_EQUAL(count, 3u);
+        CHECK_EQUAL(hooks.Values, 7u);
+        CHECK_FALSE(reader.Failed());
+
+        SequenceReader stopped("[1] {\"A\": 1} [2]");
+        CountingHooks stop_hooks;
+        stop_hooks.StopAtObject = true;
+        CHECK_TRUE(stopped.Next(stop_hooks));
+        CHECK_TRUE(stopped.Next(stop_hooks));
+        CHECK_FALSE(stopped.Next(stop_hooks));
+        CHECK_FALSE(stopped.Failed());
+        CHECK_EQUAL(stop_hooks.Values, 2u);
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(SequenceReaderTest, Next_Deep) {
+        // The stack grows past its inline capacity for one value and is reused for the next.
+        ParseOptions options;
+        options.MaxDepth = 5000;
+        std::string deep = std::string(5000, '[') + std::string(5000, ']');
+        std::string data = deep + deep + "[1]";
+        SequenceReader reader(data, options);
+        CHECK_EQUAL(ReadAll(reader).size(), 3u);
+        CHECK_FALSE(reader.Failed());
+    }
+
+}
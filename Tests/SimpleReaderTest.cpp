@@ -0,0 +1,318 @@
+#include "Json.hpp"
+
+#include "ToString.h"
+#include "CppUnitTestFramework.hpp"
+
+using namespace json;
+
+namespace {
+    struct SimpleReaderTest {
+        // Records each event as text.  The members are deliberately not virtual.
+        struct RecordingHooks {
+            std::string Events;
+
+            bool OnNull() { Events += "null "; return true; }
+            bool OnBool(bool value) { Events += value ? "true " : "false "; return true; }
+            bool OnInt(int64_t value) { Events += "i" + std::to_string(value) + " "; return true; }
+            bool OnUInt(uint64_t value) { Events += "u" + std::to_string(value) + " "; return true; }
+            bool OnReal(double value) { Events += "d" + std::to_string(value) + " "; return true; }
+            bool OnString(std::string_view value) { Events += "s:" + std::string(value) + " "; return true; }
+
+            bool OnArrayStart() { Events += "[ "; return true; }
+            bool OnArrayEnd() { Events += "] "; return true; }
+
+            bool OnObjectStart() { Events += "{ "; return true; }
+            bool OnObjectKey(std::string_view value) { Events += "k:" + std::string(value) + " "; return true; }
+            bool OnObjectEnd() { Events += "} "; return true; }
+        };
+
+        // The same, through the virtual interface.
+        struct VirtualRecordingHooks : ISimpleReaderHooks {
+            RecordingHooks Inner;
+
+            bool OnNull() override { return Inner.OnNull(); }
+            bool OnBool(bool value) override { return Inner.OnBool(value); }
+            bool OnInt(int64_t value) override { return Inner.OnInt(value); }
+            bool OnUInt(uint64_t value) override { return Inner.OnUInt(value); }
+            bool OnReal(double value) override { return Inner.OnReal(value); }
+            bool OnString(std::string_view value) override { return Inner.OnString(value); }
+
+            bool OnArrayStart() override { return Inner.OnArrayStart(); }
+            bool OnArrayEnd() override { return Inner.OnArrayEnd(); }
+
+            bool OnObjectStart() override { return Inner.OnObjectStart(); }
+            bool OnObjectKey(std::string_view value) override { return Inner.OnObjectKey(value); }
+            bool OnObjectEnd() override { return Inner.OnObjectEnd(); }
+        };
+
+        // Records events like `RecordingHooks`, but can skip or stop at containers and keys.
+        struct FilterHooks : RecordingHooks {
+            std::string_view SkipKey;
+            std::string_view StopKey;
+            bool SkipArrays = false;
+            bool StopAtObject = false;
+
+            HookResult OnArrayStart() {
+                if (SkipArrays) { return HookResult::Skip; }
+                RecordingHooks::OnArrayStart();
+                return HookResult::Continue;
+            }
+            HookResult OnObjectStart() {
+                if (StopAtObject) { return HookResult::Stop; }
+                RecordingHooks::OnObjectStart();
+                return HookResult::Continue;
+            }
+            HookResult OnObjectKey(std::string_view value) {
+                RecordingHooks::OnObjectKey(value);
+                if (value == SkipKey) { return HookResult::Skip; }
+                if (value == StopKey) { return HookResult::Stop; }
+                return HookResult::Continue;
+            }
+        };
+
+        // Returns the events from both the single pass and indexed parsers if they agree.
+        static std::optional<std::string> Filter(std::string_view document, const FilterHooks& filter, bool ignore_comments = false) {
+            FilterHooks hooks = filter;
+            if (!SimpleReader::Parse(document, hooks, ignore_comments)) { return std::nullopt; }
+
+            FilterHooks indexed_hooks = filter;
+            if (!SimpleReader::ParseIndexed(document, indexed_hooks, ignore_comments)) { return std::nullopt; }
+
+            if (hooks.Events != indexed_hooks.Events) { return std::nullopt; }
+            return hooks.Events;
+        }
+
+        static constexpr std::string_view FilterDocument =
+            "{\"A\": [1, [2, \"]\"], {\"x\": \"}\\\"\"}], \"B\": {\"C\": {\"D\": [1]}}, \"E\": 3, \"F\": \"s\"}";
+
+        static constexpr std::string_view Document = "{\"A\": [1, -2, 1.5, \"x\"], \"B\": {\"C\": null, \"D\": true}}";
+        static constexpr std::string_view Events = "{ k:A [ u1 i-2 d1.500000 s:x ] k:B { k:C null k:D true } } ";
+    };
+}
+
+namespace json_test {
+
+    TEST_CASE(SimpleReaderTest, Parse_TemplateHooks) {
+        RecordingHooks hooks;
+        CHECK_TRUE(SimpleReader::Parse(Document, hooks));
+        CHECK_EQUAL(hooks.Events, Events);
+
+        RecordingHooks indexed_hooks;
+        CHECK_TRUE(SimpleReader::ParseIndexed(Document, indexed_hooks));
+        CHECK_EQUAL(indexed_hooks.Events, Events);
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(SimpleReaderTest, Parse_VirtualHooks) {
+        VirtualRecordingHooks hooks;
+        CHECK_TRUE(SimpleReader::Parse(Document, &hooks));
+        CHECK_EQUAL(hooks.Inner.Events, Events);
+
+        VirtualRecordingHooks indexed_hooks;
+        ISimpleReaderHooks& base = indexed_hooks;
+        CHECK_TRUE(SimpleReader::ParseIndexed(Document, base));
+        CHECK_EQUAL(indexed_hooks.Inner.Events, Events);
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(SimpleReaderTest, Parse_SkipKey) {
+        FilterHooks filter;
+
+        filter.SkipKey = "A";
+        CHECK_EQUAL(Filter(FilterDocument, filter), "{ k:A k:B { k:C { k:D [ u1 ] } } k:E u3 k:F s:s } ");
+
+        filter.SkipKey = "C";
+        CHECK_EQUAL(Filter(FilterDocument, filter), "{ k:A [ u1 [ u2 s:] ] { k:x s:}\" } ] k:B { k:C } k:E u3 k:F s:s } ");
+
+        filter.SkipKey = "E";
+        CHECK_EQUAL(Filter(FilterDocument, filter), "{ k:A [ u1 [ u2 s:] ] { k:x s:}\" } ] k:B { k:C { k:D [ u1 ] } } k:E k:F s:s } ");
+
+        filter.SkipKey = "F";
+        CHECK_EQUAL(Filter(FilterDocument, filter), "{ k:A [ u1 [ u2 s:] ] { k:x s:}\" } ] k:B { k:C { k:D [ u1 ] } } k:E u3 k:F } ");
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(SimpleReaderTest, Parse_SkipKeyScalar) {
+        FilterHooks filter;
+        filter.SkipKey = "A";
+        CHECK_EQUAL(Filter("{\"A\": -1.5e3, \"B\": null}", filter), "{ k:A k:B null } ");
+        CHECK_EQUAL(Filter("{\"A\": true}", filter), "{ k:A } ");
+
+        // Skipped scalars are still parsed, so both parsers reject malformed ones.
+        for (std::string_view document : { "{\"A\": tru}", "{\"A\": -}", "{\"A\": 1.}", "{\"A\": 1x}", "{\"A\": nul, \"B\": 1}" }) {
+            FilterHooks hooks = filter;
+            CHECK_FALSE(SimpleReader::Parse(document, hooks));
+
+            FilterHooks indexed_hooks = filter;
+            CHECK_FALSE(SimpleReader::ParseIndexed(document, indexed_hooks));
+        }
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(SimpleReaderTest, Parse_SkipContainer) {
+        FilterHooks filter;
+        filter.SkipArrays = true;
+        CHECK_EQUAL(Filter(FilterDocument, filter), "{ k:A k:B { k:C { k:D } } k:E u3 k:F s:s } ");
+        CHECK_EQUAL(Filter("[1, 2]", filter), "");
+
+        SECTION("Comments") {
+            FilterHooks comment_filter;
+            comment_filter.SkipKey = "A";
+            CHECK_EQUAL(Filter("{\"A\": [1, /* ] */ 2], \"B\": 1}", comment_filter, true), "{ k:A k:B u1 } ");
+        }
+        SECTION("Malformed") {
+            CHECK_EQUAL(Filter("[1, 2", filter), std::nullopt);
+            CHECK_EQUAL(Filter("[1, 2}", filter), std::nullopt);
+            CHECK_EQUAL(Filter("[\"]", filter), std::nullopt);
+            CHECK_EQUAL(Filter("{\"A\": [1] 2}", filter), std::nullopt);
+
+            FilterHooks key_filter;
+            key_filter.SkipKey = "A";
+            CHECK_EQUAL(Filter("{\"A\": }", key_filter), std::nullopt);
+            CHECK_EQUAL(Filter("{\"A\": \"x}", key_filter), std::nullopt);
+            CHECK_EQUAL(Filter("{\"A\": {\"B\": 1]}", key_filter), std::nullopt);
+        }
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(SimpleReaderTest, ParseIndexed_UnterminatedString) {
+        // The index can't be built when the input ends within a string.
+        for (std::string_view document : { "\"abc", "[\"abc", "{\"a\": \"b" }) {
+            RecordingHooks hooks;
+            CHECK_FALSE(SimpleReader::Parse(document, hooks));
+
+            RecordingHooks indexed_hooks;
+            CHECK_FALSE(SimpleReader::ParseIndexed(document, indexed_hooks));
+            CHECK_EQUAL(indexed_hooks.Events, "");
+        }
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(SimpleReaderTest, Parse_Stop) {
+        FilterHooks filter;
+
+        filter.StopKey = "B";
+        CHECK_EQUAL(Filter(FilterDocument, filter), "{ k:A [ u1 [ u2 s:] ] { k:x s:}\" } ] k:B ");
+
+        // The rest of the document isn't read, so needn't be valid.
+        CHECK_EQUAL(Filter("{\"A\": 1, \"B\": [1, 2", filter), "{ k:A u1 k:B ");
+
+        FilterHooks object_filter;
+        object_filter.StopAtObject = true;
+        CHECK_EQUAL(Filter("[1, {\"A\": 2}, 3]", object_filter), "[ u1 ");
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(SimpleReaderTest, Parse_StringViews) {
+        // Strings without escapes are passed straight from the input, and the rest are decoded.
+        struct ViewHooks : RecordingHooks {
+            std::vector<std::string_view> Strings;
+
+            bool OnString(std::string_view value) {
+                Strings.push_back(value);
+                return RecordingHooks::OnString(value);
+            }
+        };
+
+        constexpr std::string_view document = "[\"Plain\", \"Escaped\\n\"]";
+        for (bool indexed : { false, true }) {
+            ViewHooks hooks;
+            CHECK_TRUE(indexed ? SimpleReader::ParseIndexed(document, hooks) : SimpleReader::Parse(document, hooks));
+            REQUIRE(hooks.Strings.size() == 2u);
+            CHECK_TRUE(hooks.Strings[0].data() == document.data() + 2);
+            CHECK_EQUAL(hooks.Events, "[ s:Plain s:Escaped\n ] ");
+        }
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(SimpleReaderTest, Parse_MaxDepth) {
+        auto nested = [](size_t depth) {
+            std::string document;
+            for (size_t i = 0; i < depth; ++i) { document += (i % 2 == 0) ? "[" : "{\"k\": "; }
+            document += "1";
+            for (size_t i = depth; i > 0; --i) { document += ((i - 1) % 2 == 0) ? "]" : "}"; }
+            return document;
+        };
+
+        SECTION("Default") {
+            RecordingHooks hooks;
+            CHECK_TRUE(SimpleReader::Parse(nested(ParseOptions::DefaultMaxDepth), hooks));
+            CHECK_FALSE(SimpleReader::Parse(nested(ParseOptions::DefaultMaxDepth + 1), hooks));
+            CHECK_TRUE(SimpleReader::ParseIndexed(nested(ParseOptions::DefaultMaxDepth), hooks));
+            CHECK_FALSE(SimpleReader::ParseIndexed(nested(ParseOptions::DefaultMaxDepth + 1), hooks));
+        }
+        SECTION("Limit") {
+            ParseOptions options;
+            options.MaxDepth = 2;
+            RecordingHooks hooks;
+            CHECK_TRUE(SimpleReader::Parse("[[], {\"a\": 1}]", hooks, options));
+            CHECK_FALSE(SimpleReader::Parse("[[[]]]", hooks, options));
+            CHECK_FALSE(SimpleReader::Parse("[{\"a\": {}}]", hooks, options));
+            CHECK_FALSE(SimpleReader::ParseIndexed("[[[]]]", hooks, options));
+        }
+        SECTION("Deep") {
+            // Far deeper than a recursive parser could go without overflowing the stack.
+            ParseOptions options;
+            options.MaxDepth = 1000000;
+            auto document = nested(options.MaxDepth);
+
+            RecordingHooks hooks;
+            CHECK_TRUE(SimpleReader::Parse(document, hooks, options));
+            RecordingHooks indexed_hooks;
+            CHECK_TRUE(SimpleReader::ParseIndexed(document, indexed_hooks, options));
+            CHECK_TRUE(hooks.Events == indexed_hooks.Events);
+        }
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(SimpleReaderTest, Parse_Padded) {
+        // Only the data is parsed, whatever the padding contains.
+        auto parse = [](std::string_view data, std::string_view padding, bool ignore_comments = false) -> std::optional<std::string> {
+            std::string buffer = std::string(data) + std::string(padding);
+            buffer.resize(data.size() + PaddedString::Padding, '"');
+
+            RecordingHooks hooks;
+            if (!SimpleReader::ParsePadded(std::string_view(buffer.data(), data.size()), hooks, ignore_comments)) {
+                return std::nullopt;
+            }
+            return hooks.Events;
+        };
+
+        CHECK_EQUAL(parse(Document, ""), Events);
+        CHECK_EQUAL(parse("true", "x"), "true ");
+        CHECK_EQUAL(parse("null", "x"), "null ");
+        CHECK_EQUAL(parse("false", "x"), "false ");
+        CHECK_EQUAL(parse("tru", "e"), std::nullopt);
+        CHECK_EQUAL(parse("[1,   ", "  2]"), std::nullopt);
+        CHECK_EQUAL(parse("\"abc", "\""), std::nullopt);
+        CHECK_EQUAL(parse("[1 // x", "\n]", true), std::nullopt);
+        CHECK_EQUAL(parse("[1 /* x *", "/]", true), std::nullopt);
+
+        ParseOptions options;
+        options.ValidateUtf8 = true;
+        RecordingHooks hooks;
+        std::string buffer = "\"abc\xFF\"";
+        buffer.resize(4 + PaddedString::Padding, 'x');
+        CHECK_FALSE(SimpleReader::ParsePadded(std::string_view(buffer.data(), 4), hooks, options));
+
+        PaddedString padded(Document);
+        CHECK_EQUAL(padded.Size(), Document.size());
+        CHECK_TRUE(padded.View() == Document);
+        CHECK_TRUE(padded.Data()[padded.Size()] == '\0');
+
+        RecordingHooks padded_hooks;
+        CHECK_TRUE(SimpleReader::ParsePadded(padded, padded_hooks));
+        CHECK_EQUAL(padded_hooks.Events, Events);
+        CHECK_TRUE(ObjectReader::ParsePadded(padded) == ObjectReader::Parse(Document));
+    }
+
+}
@@ -0,0 +1,222 @@
+#include "Json.hpp"
+
+#include "ToString.h"
+#include "CppUnitTestFramework.hpp"
+
+using namespace json;
+
+namespace {
+    struct StreamingReaderTest {
+        // Records each event as text.
+        struct RecordingHooks : ISimpleReaderHooks {
+            std::string Events;
+
+            bool OnNull() override { Events += "null "; return true; }
+            bool OnBool(bool value) override { Events += value ? "true " : "false "; return true; }
+            bool OnInt(int64_t value) override { Events += "i" + std::to_string(value) + " "; return true; }
+            bool OnUInt(uint64_t value) override { Events += "u" + std::to_string(value) + " "; return true; }
+            bool OnReal(double value) override { Events += "d" + std::to_string(value) + " "; return true; }
+            bool OnString(std::string_view value) override { Events += "s:" + std::string(value) + " "; return true; }
+
+            bool OnArrayStart() override { Events += "[ "; return true; }
+            bool OnArrayEnd() override { Events += "] "; return true; }
+
+            bool OnObjectStart() override { Events += "{ "; return true; }
+            bool OnObjectKey(std::string_view value) override { Events += "k:" + std::string(value) + " "; return true; }
+            bool OnObjectEnd() override { Events += "} "; return true; }
+        };
+
+        static constexpr std::string_view Document =
+            "{\"Key\": [1, -23, 1.5e3, 18446744073709551615, \"x\", \"Escaped \\\" \\\\ quote \\u00e9 \\uD83D\\uDE00\"], "
+            "\"Object\": {\"A\": null, \"B\": true, \"C\": false, \"D\": []}, \"E\": {}}";
+
+        static std::string ExpectedEvents(std::string_view document, bool ignore_comments = false) {
+            RecordingHooks hooks;
+            SimpleReader::Parse(document, &hooks, ignore_comments);
+            return hooks.Events;
+        }
+
+        // Feeds `document` split at `split`, copying each chunk into a temporary so that nothing can refer
+        // back to an earlier one.
+        static std::optional<std::string> FeedSplit(std::string_view document, size_t split, const ParseOptions& options = ParseOptions()) {
+            RecordingHooks hooks;
+            StreamingReader reader(&hooks, options);
+            if (!reader.Feed(std::string(document.substr(0, split)))) { return std::nullopt; }
+            if (!reader.Feed(std::string(document.substr(split)))) { return std::nullopt; }
+            if (!reader.Finish()) { return std::nullopt; }
+            return hooks.Events;
+        }
+
+        static bool FeedBytes(std::string_view document, const ParseOptions& options = ParseOptions()) {
+            RecordingHooks hooks;
+            StreamingReader reader(&hooks, options);
+            for (char c : document) {
+                if (!reader.Feed(std::string(1, c))) { return false; }
+            }
+            return reader.Finish();
+        }
+    };
+}
+
+namespace json_test {
+
+    TEST_CASE(StreamingReaderTest, Feed_WholeDocument) {
+        RecordingHooks hooks;
+        StreamingReader reader(&hooks);
+        CHECK_TRUE(reader.Feed(Document));
+        CHECK_TRUE(reader.IsComplete());
+        CHECK_TRUE(reader.Finish());
+        CHECK_EQUAL(hooks.Events, ExpectedEvents(Document));
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(StreamingReaderTest, Feed_EverySplit) {
+        auto expected = ExpectedEvents(Document);
+        for (size_t split = 0; split <= Document.size(); ++split) {
+            CHECK_EQUAL(FeedSplit(Document, split), expected);
+        }
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(StreamingReaderTest, Feed_SingleBytes) {
+        RecordingHooks hooks;
+        StreamingReader reader(&hooks);
+        for (char c : Document) {
+            CHECK_TRUE(reader.Feed(std::string(1, c)));
+        }
+        CHECK_TRUE(reader.Finish());
+        CHECK_EQUAL(hooks.Events, ExpectedEvents(Document));
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(StreamingReaderTest, Feed_Scalars) {
+        SECTION("Number") {
+            RecordingHooks hooks;
+            StreamingReader reader(&hooks);
+            CHECK_TRUE(reader.Feed("12"));
+            CHECK_TRUE(reader.Feed("34"));
+            CHECK_FALSE(reader.IsComplete());
+            CHECK_TRUE(reader.Finish());
+            CHECK_EQUAL(hooks.Events, "u1234 ");
+        }
+        SECTION("Literal") {
+            RecordingHooks hooks;
+            StreamingReader reader(&hooks);
+            CHECK_TRUE(reader.Feed("tr"));
+            CHECK_TRUE(reader.Feed("ue"));
+            CHECK_TRUE(reader.IsComplete());
+            CHECK_TRUE(reader.Finish());
+            CHECK_EQUAL(hooks.Events, "true ");
+        }
+        SECTION("String") {
+            RecordingHooks hooks;
+            StreamingReader reader(&hooks);
+            CHECK_TRUE(reader.Feed("\"ab\\"));
+            CHECK_TRUE(reader.Feed("\"cd\""));
+            CHECK_TRUE(reader.Finish());
+            CHECK_EQUAL(hooks.Events, "s:ab\"cd ");
+        }
+        SECTION("Trailing content") {
+            RecordingHooks hooks;
+            StreamingReader reader(&hooks);
+            CHECK_TRUE(reader.Feed("[1] "));
+            CHECK_TRUE(reader.Feed("2"));
+            CHECK_TRUE(reader.Finish());
+            CHECK_EQUAL(hooks.Events, "[ u1 ] ");
+        }
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(StreamingReaderTest, Feed_Comments) {
+        constexpr std::string_view document = "// Line\n[1, /* Block ** */ 2 /**/, // Line\n 3]";
+        auto expected = ExpectedEvents(document, true);
+        for (size_t split = 0; split <= document.size(); ++split) {
+            CHECK_EQUAL(FeedSplit(document, split, true), expected);
+        }
+
+        RecordingHooks hooks;
+        StreamingReader reader(&hooks);
+        CHECK_FALSE(reader.Feed(document));
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(StreamingReaderTest, Feed_ValidateUtf8) {
+        ParseOptions options;
+        options.ValidateUtf8 = true;
+
+        SECTION("Valid") {
+            constexpr std::string_view document = "{\"K\xC3\xA9y\": [\"\xE2\x82\xAC \\\" \xF0\x9F\x98\x80\"]}";
+            auto expected = ExpectedEvents(document);
+            for (size_t split = 0; split <= document.size(); ++split) {
+                CHECK_EQUAL(FeedSplit(document, split, options), expected);
+            }
+        }
+        SECTION("Invalid") {
+            // A truncated sequence, a stray continuation byte, an overlong encoding and a surrogate, each
+            // in a string and in a key.
+            for (std::string_view text : { "\xE2\x82", "a\x80", "\xC0\xAF", "\xED\xA0\x80" }) {
+                auto value = "[\"" + std::string(text) + "\"]";
+                auto key = "{\"" + std::string(text) + "\": 1}";
+                for (auto& document : { value, key }) {
+                    for (size_t split = 0; split <= document.size(); ++split) {
+                        CHECK_FALSE(FeedSplit(document, split, options).has_value());
+                        CHECK_TRUE(FeedSplit(document, split).has_value());
+                    }
+                }
+            }
+        }
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(StreamingReaderTest, Feed_MaxDepth) {
+        ParseOptions options;
+        options.MaxDepth = 3;
+
+        CHECK_TRUE(FeedBytes("[{\"A\": [1]}, [[]]]", options));
+        CHECK_FALSE(FeedBytes("[{\"A\": [[1]]}]", options));
+        CHECK_FALSE(FeedBytes("[[[{}]]]", options));
+
+        SECTION("Default") {
+            std::string document = std::string(ParseOptions::DefaultMaxDepth, '[') + std::string(ParseOptions::DefaultMaxDepth, ']');
+            CHECK_TRUE(FeedSplit(document, document.size() / 2).has_value());
+
+            document = "[" + document + "]";
+            CHECK_FALSE(FeedSplit(document, document.size() / 2).has_value());
+        }
+        SECTION("Raised") {
+            options.MaxDepth = 5000;
+            std::string document = std::string(5000, '[') + std::string(5000, ']');
+            CHECK_TRUE(FeedSplit(document, 2500, options).has_value());
+        }
+    }
+
+    //--------------------------------------------------------------------------------------------------------
+
+    TEST_CASE(StreamingReaderTest, Feed_Invalid) {
+        CHECK_FALSE(FeedBytes(""));
+        CHECK_FALSE(FeedBytes("["));
+        CHECK_FALSE(FeedBytes("[1,]"));
+        CHECK_FALSE(FeedBytes("[1 2]"));
+        CHECK_FALSE(FeedBytes("[1}"));
+        CHECK_FALSE(FeedBytes("{\"A\" 1}"));
+        CHECK_FALSE(FeedBytes("{1: 1}"));
+        CHECK_FALSE(FeedBytes("\"Unterminated"));
+        CHECK_FALSE(FeedBytes("[tru]"));
+        CHECK_FALSE(FeedBytes("[1.5.2]"));
+        CHECK_FALSE(FeedBytes("-"));
+        CHECK_FALSE(FeedBytes("[1 /* Unterminated", true));
+
+        RecordingHooks hooks;
+        StreamingReader reader(&hooks);
+        CHECK_FALSE(reader.Feed("[x"));
+        CHECK_FALSE(reader.Feed("]"));
+        CHECK_FALSE(reader.Finish());
+    }
+
+}
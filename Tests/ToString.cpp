@@ -59,7 +59,7 @@ namespace CppUnitTestFramework::Ext {
             if (i != 0) {
                 ss << ", ";
             }
-            ss << "\"" << kvp.first << "\" : ";
+            ss << "\"" << std::string_view(kvp.first) << "\" : ";
             if (kvp.second.IsString()) {
                 ss << "\"" << ToString(kvp.second) << "\"";
             } else {